@@ -0,0 +1,579 @@
+///
+/// @file CompileServer.cpp
+/// @brief 编译服务与客户端的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.4
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>编译请求中增加time-passes字段
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>校验编译请求中的前端
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>编译服务的套接字文件只允许本用户访问
+/// <tr><td>2026-10-15 <td>1.4     <td>zenglj  <td>编译请求内部不再并行翻译函数体
+/// </table>
+///
+#include "CompileServer.h"
+#include "Common.h"
+
+#ifdef _WIN32
+
+int serveCompile(const std::string & socketPath, unsigned threadCount)
+{
+    (void) socketPath;
+    (void) threadCount;
+
+    minic_log(LOG_ERROR, "编译服务需要Unix域套接字，Windows下不支持");
+    return -1;
+}
+
+int compileRemote(const std::string & socketPath,
+                  const CompileOptions & options,
+                  const std::string & cacheDir,
+                  const std::vector<CompileJob> & jobs,
+                  bool batch,
+                  unsigned jobCount)
+{
+    (void) socketPath;
+    (void) options;
+    (void) cacheDir;
+    (void) jobs;
+    (void) batch;
+    (void) jobCount;
+
+    minic_log(LOG_ERROR, "编译服务需要Unix域套接字，Windows下不支持");
+    return -1;
+}
+
+#else
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "CompileCache.h"
+#include "ThreadPool.h"
+
+///
+/// 请求与应答都是一个消息。消息为若干个字符串，先是4字节的字符串个数，每个字符串为4字节的长度后跟内容，
+/// 整数按主机字节序，客户端与服务在同一台机器上。
+/// 请求的第一个字符串为协议的版本，之后每个字符串为"键=值"的形式，input与output成对出现，每对是一个源文件。
+/// 应答为两个字符串，编译结果与诊断信息。
+///
+
+/// @brief 请求的协议版本，不同版本的客户端与服务不能互通
+static const char * protocolVersion = "minic-serve 1";
+
+/// @brief 消息的最大字节数，防止错误的请求耗尽内存
+static const uint32_t maxMessageSize = 64u << 20;
+
+/// @brief 编译服务的套接字路径，结束服务时删除
+static char serveSocketPath[sizeof(sockaddr_un::sun_path)];
+
+///
+/// @brief 写入全部数据，被信号打断时继续写
+/// @param fd 套接字
+/// @param data 数据
+/// @param len 字节数
+/// @return true: 成功 false: 失败
+///
+static bool writeAll(int fd, const void * data, size_t len)
+{
+    const char * p = (const char *) data;
+
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        p += n;
+        len -= (size_t) n;
+    }
+
+    return true;
+}
+
+///
+/// @brief 读入指定字节数的数据，被信号打断时继续读
+/// @param fd 套接字
+/// @param data 数据
+/// @param len 字节数
+/// @return true: 成功 false: 失败或者对方已关闭
+///
+static bool readAll(int fd, void * data, size_t len)
+{
+    char * p = (char *) data;
+
+    while (len > 0) {
+        ssize_t n = read(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        if (n == 0) {
+            return false;
+        }
+
+        p += n;
+        len -= (size_t) n;
+    }
+
+    return true;
+}
+
+///
+/// @brief 发送消息
+/// @param fd 套接字
+/// @param fields 消息的各个字符串
+/// @return true: 成功 false: 失败
+///
+static bool sendMessage(int fd, const std::vector<std::string> & fields)
+{
+    std::string buffer;
+
+    uint32_t count = (uint32_t) fields.size();
+    buffer.append((const char *) &count, sizeof(count));
+
+    for (auto & field: fields) {
+        uint32_t len = (uint32_t) field.size();
+        buffer.append((const char *) &len, sizeof(len));
+        buffer.append(field);
+    }
+
+    return writeAll(fd, buffer.data(), buffer.size());
+}
+
+///
+/// @brief 接收消息
+/// @param fd 套接字
+/// @param fields 消息的各个字符串
+/// @return true: 成功 false: 失败或者消息太大
+///
+static bool recvMessage(int fd, std::vector<std::string> & fields)
+{
+    uint32_t count;
+    if (!readAll(fd, &count, sizeof(count))) {
+        return false;
+    }
+
+    fields.clear();
+
+    size_t total = 0;
+
+    for (uint32_t k = 0; k < count; ++k) {
+
+        uint32_t len;
+        if (!readAll(fd, &len, sizeof(len))) {
+            return false;
+        }
+
+        total += sizeof(len) + len;
+        if (total > maxMessageSize) {
+            return false;
+        }
+
+        std::string field(len, '\0');
+        if (!readAll(fd, field.data(), len)) {
+            return false;
+        }
+
+        fields.push_back(std::move(field));
+    }
+
+    return true;
+}
+
+///
+/// @brief 设置Unix域套接字的地址
+/// @param socketPath 套接字的路径
+/// @param addr 地址
+/// @return true: 成功 false: 路径太长
+///
+static bool makeAddress(const std::string & socketPath, sockaddr_un & addr)
+{
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+
+    if (socketPath.empty() || (socketPath.size() >= sizeof(addr.sun_path))) {
+        minic_log(LOG_ERROR, "套接字路径(%s)为空或者太长", socketPath.c_str());
+        return false;
+    }
+
+    memcpy(addr.sun_path, socketPath.c_str(), socketPath.size());
+
+    return true;
+}
+
+///
+/// @brief 连接编译服务
+/// @param socketPath 套接字的路径
+/// @return int 套接字，-1表示连接不上
+///
+static int connectServer(const std::string & socketPath)
+{
+    sockaddr_un addr;
+    if (!makeAddress(socketPath, addr)) {
+        return -1;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    if (connect(fd, (sockaddr *) &addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+///
+/// @brief 编译服务的状态，在请求之间保留
+///
+struct ServeState {
+    /// @brief 保护caches
+    std::mutex mutex;
+
+    /// @brief 各目录的编译缓存，命中统计在请求之间累计
+    std::map<std::string, std::unique_ptr<CompileCache>> caches;
+
+    ///
+    /// @brief 获取目录对应的编译缓存，第一次使用时创建
+    /// @param dir 缓存目录
+    /// @return CompileCache* 编译缓存
+    ///
+    CompileCache * getCache(const std::string & dir)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto & cache = caches[dir];
+        if (!cache) {
+            cache = std::make_unique<CompileCache>(dir);
+        }
+
+        return cache.get();
+    }
+};
+
+///
+/// @brief 解析编译请求
+/// @param fields 请求的各个字符串
+/// @param state 编译服务的状态
+/// @param options 编译选项
+/// @param jobs 各源文件与输出文件
+/// @param batch 是否批量编译
+/// @param jobCount 批量编译时同时编译的文件数
+/// @return true: 成功 false: 请求有误
+///
+static bool parseRequest(const std::vector<std::string> & fields,
+                         ServeState & state,
+                         CompileOptions & options,
+                         std::vector<CompileJob> & jobs,
+                         bool & batch,
+                         unsigned & jobCount)
+{
+    if (fields.empty() || (fields[0] != protocolVersion)) {
+        minic_log(LOG_ERROR, "编译请求的协议版本不对");
+        return false;
+    }
+
+    for (size_t k = 1; k < fields.size(); ++k) {
+
+        const std::string & field = fields[k];
+
+        std::string::size_type pos = field.find('=');
+        if (pos == std::string::npos) {
+            minic_log(LOG_ERROR, "编译请求的字段(%s)有误", field.c_str());
+            return false;
+        }
+
+        std::string key = field.substr(0, pos);
+        std::string value = field.substr(pos + 1);
+
+        if (key == "input") {
+            jobs.emplace_back();
+            jobs.back().inputFile = value;
+        } else if (key == "output") {
+            if (jobs.empty()) {
+                minic_log(LOG_ERROR, "编译请求的输出文件前没有源文件");
+                return false;
+            }
+            jobs.back().outputFile = value;
+        } else if (key == "cache") {
+            options.cache = value.empty() ? nullptr : state.getCache(value);
+        } else if (key == "cpu") {
+            options.cpuTarget = value;
+        } else if (key == "frontend") {
+            int frontEnd = std::stoi(value);
+            if ((frontEnd < (int) FrontEndKind::FlexBison) || (frontEnd > (int) FrontEndKind::RecursiveDescent)) {
+                minic_log(LOG_ERROR, "编译请求的前端(%s)不认识", value.c_str());
+                return false;
+            }
+            options.frontEnd = (FrontEndKind) frontEnd;
+        } else if (key == "opt") {
+            options.optLevel = std::stoi(value);
+        } else if (key == "threads") {
+            options.threadCount = (unsigned) std::stoul(value);
+        } else if (key == "jobs") {
+            jobCount = (unsigned) std::stoul(value);
+        } else if (key == "batch") {
+            batch = value == "1";
+        } else if (key == "ast") {
+            options.showAST = value == "1";
+        } else if (key == "ir") {
+            options.showLineIR = value == "1";
+        } else if (key == "asm") {
+            options.showASM = value == "1";
+        } else if (key == "asmir") {
+            options.asmAlsoShowIR = value == "1";
+        } else if (key == "stream") {
+            options.streamCompile = value == "1";
+        } else if (key == "parse-stats") {
+            options.showParseStats = value == "1";
+        } else if (key == "time-passes") {
+            options.timePasses = value == "1";
+        } else {
+            minic_log(LOG_ERROR, "编译请求的字段(%s)不认识", key.c_str());
+            return false;
+        }
+    }
+
+    if (jobs.empty()) {
+        minic_log(LOG_ERROR, "编译请求中没有源文件");
+        return false;
+    }
+
+    return true;
+}
+
+///
+/// @brief 处理一个连接上的编译请求，编译后返回结果与诊断信息
+/// @param fd 连接的套接字
+/// @param state 编译服务的状态
+///
+static void handleRequest(int fd, ServeState & state)
+{
+    std::vector<std::string> fields;
+    if (!recvMessage(fd, fields)) {
+        return;
+    }
+
+    CompileOptions options;
+    std::vector<CompileJob> jobs;
+    bool batch = false;
+    unsigned jobCount = 0;
+
+    int result = -1;
+    std::string diagnostics;
+
+    // 本请求的诊断信息都返回给客户端
+    minic_set_diag_buffer(&diagnostics);
+
+    bool valid = false;
+    try {
+        valid = parseRequest(fields, state, options, jobs, batch, jobCount);
+    } catch (std::exception &) {
+        // 数值字段转换出错
+        minic_log(LOG_ERROR, "编译请求的字段有误");
+    }
+
+    if (valid) {
+        // 请求之间已经并发，请求内部不再并行翻译函数体，避免线程数相乘。批量编译时compileBatch同样处理
+        options.threadCount = 1;
+
+        if (batch) {
+            result = compileBatch(options, jobs, jobCount, &diagnostics);
+        } else {
+            result = compile(options, jobs[0].inputFile, jobs[0].outputFile);
+        }
+    }
+
+    minic_set_diag_buffer(nullptr);
+
+    (void) sendMessage(fd, {std::to_string(result), diagnostics});
+}
+
+///
+/// @brief SIGINT与SIGTERM的处理函数，删除套接字文件后结束服务
+/// @param sig 信号
+///
+static void stopServe(int sig)
+{
+    (void) sig;
+
+    unlink(serveSocketPath);
+    _exit(0);
+}
+
+///
+/// @brief 启动编译服务，在Unix域套接字上循环接受编译请求，直到收到SIGINT或SIGTERM。
+/// 服务进程常驻，antlr4的DFA缓存、类型等在请求之间保留，编译缓存按目录保留，后续请求不再有启动开销
+/// @param socketPath 套接字的路径
+/// @param threadCount 同时处理的请求数，为0表示按硬件支持的并发线程数
+/// @return 0 成功
+/// @return -1 失败
+///
+int serveCompile(const std::string & socketPath, unsigned threadCount)
+{
+    sockaddr_un addr;
+    if (!makeAddress(socketPath, addr)) {
+        return -1;
+    }
+
+    // 已经有服务在运行时不能抢占，连接不上时才是遗留的套接字文件，删除后重建
+    int fd = connectServer(socketPath);
+    if (fd >= 0) {
+        close(fd);
+        minic_log(LOG_ERROR, "套接字(%s)上已有编译服务", socketPath.c_str());
+        return -1;
+    }
+    unlink(socketPath.c_str());
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        minic_log(LOG_ERROR, "创建套接字失败: %s", strerror(errno));
+        return -1;
+    }
+
+    // 服务以本用户的身份读写任意文件，套接字文件只允许本用户连接。bind按umask创建套接字文件，
+    // 创建时权限即为0600，不留出先创建后chmod之间的空档
+    mode_t oldMask = umask(S_IXUSR | S_IRWXG | S_IRWXO);
+    int bindResult = bind(listenFd, (sockaddr *) &addr, sizeof(addr));
+    umask(oldMask);
+
+    if ((bindResult != 0) || (listen(listenFd, SOMAXCONN) != 0)) {
+        minic_log(LOG_ERROR, "监听套接字(%s)失败: %s", socketPath.c_str(), strerror(errno));
+        close(listenFd);
+        return -1;
+    }
+
+    memcpy(serveSocketPath, addr.sun_path, sizeof(serveSocketPath));
+    signal(SIGINT, stopServe);
+    signal(SIGTERM, stopServe);
+
+    // 客户端中途断开时写入失败即可，不能让进程退出
+    signal(SIGPIPE, SIG_IGN);
+
+    ServeState state;
+    ThreadPool pool(threadCount);
+
+    minic_log(LOG_INFO, "编译服务在(%s)上运行，%u个线程", socketPath.c_str(), pool.size());
+
+    for (;;) {
+
+        int connFd = accept(listenFd, nullptr, nullptr);
+        if (connFd < 0) {
+            if ((errno == EINTR) || (errno == ECONNABORTED)) {
+                continue;
+            }
+
+            minic_log(LOG_ERROR, "接受连接失败: %s", strerror(errno));
+            break;
+        }
+
+        pool.submit([connFd, &state] {
+            handleRequest(connFd, state);
+            close(connFd);
+        });
+    }
+
+    pool.wait();
+    close(listenFd);
+    unlink(socketPath.c_str());
+
+    return -1;
+}
+
+///
+/// @brief 客户端：把编译请求发送给编译服务，输出服务返回的诊断信息
+/// @param socketPath 编译服务的套接字路径
+/// @param options 编译选项，其中的编译缓存不发送，由cacheDir指定
+/// @param cacheDir 编译缓存的目录，为空时不使用缓存
+/// @param jobs 各源文件与输出文件，相对路径按客户端的当前目录转为绝对路径后发送
+/// @param batch 是否批量编译
+/// @param jobCount 批量编译时同时编译的文件数
+/// @return 0 成功
+/// @return -1 失败，或者连接不上编译服务
+///
+int compileRemote(const std::string & socketPath,
+                  const CompileOptions & options,
+                  const std::string & cacheDir,
+                  const std::vector<CompileJob> & jobs,
+                  bool batch,
+                  unsigned jobCount)
+{
+    // 服务的当前目录与客户端不同，路径都转为绝对路径
+    auto absolutePath = [](const std::string & path) {
+        std::error_code ec;
+        std::filesystem::path result = std::filesystem::absolute(path, ec);
+        return ec ? path : result.string();
+    };
+
+    std::vector<std::string> fields;
+    fields.push_back(protocolVersion);
+    fields.push_back("ast=" + std::to_string((int) options.showAST));
+    fields.push_back("ir=" + std::to_string((int) options.showLineIR));
+    fields.push_back("asm=" + std::to_string((int) options.showASM));
+    fields.push_back("asmir=" + std::to_string((int) options.asmAlsoShowIR));
+    fields.push_back("stream=" + std::to_string((int) options.streamCompile));
+    fields.push_back("parse-stats=" + std::to_string((int) options.showParseStats));
+    fields.push_back("time-passes=" + std::to_string((int) options.timePasses));
+    fields.push_back("frontend=" + std::to_string((int) options.frontEnd));
+    fields.push_back("threads=" + std::to_string(options.threadCount));
+    fields.push_back("opt=" + std::to_string(options.optLevel));
+    fields.push_back("cpu=" + options.cpuTarget);
+    fields.push_back("cache=" + (cacheDir.empty() ? cacheDir : absolutePath(cacheDir)));
+    fields.push_back("batch=" + std::to_string((int) batch));
+    fields.push_back("jobs=" + std::to_string(jobCount));
+
+    for (auto & job: jobs) {
+        fields.push_back("input=" + absolutePath(job.inputFile));
+        fields.push_back("output=" + absolutePath(job.outputFile));
+    }
+
+    int fd = connectServer(socketPath);
+    if (fd < 0) {
+        minic_log(LOG_ERROR, "连接编译服务(%s)失败", socketPath.c_str());
+        return -1;
+    }
+
+    std::vector<std::string> reply;
+    bool ok = sendMessage(fd, fields) && recvMessage(fd, reply) && (reply.size() == 2);
+
+    close(fd);
+
+    if (!ok) {
+        minic_log(LOG_ERROR, "编译服务(%s)没有正确应答", socketPath.c_str());
+        return -1;
+    }
+
+    fwrite(reply[1].data(), 1, reply[1].size(), stdout);
+    fflush(stdout);
+
+    return std::stoi(reply[0]);
+}
+
+#endif
@@ -0,0 +1,49 @@
+///
+/// @file CompileServer.h
+/// @brief 编译服务，常驻进程通过Unix域套接字接受编译请求，客户端只转发请求
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Compiler.h"
+
+///
+/// @brief 启动编译服务，在Unix域套接字上循环接受编译请求，直到收到SIGINT或SIGTERM。
+/// 服务进程常驻，antlr4的DFA缓存、类型等在请求之间保留，编译缓存按目录保留，后续请求不再有启动开销
+/// @param socketPath 套接字的路径
+/// @param threadCount 同时处理的请求数，为0表示按硬件支持的并发线程数
+/// @return 0 成功
+/// @return -1 失败
+///
+int serveCompile(const std::string & socketPath, unsigned threadCount);
+
+///
+/// @brief 客户端：把编译请求发送给编译服务，输出服务返回的诊断信息
+/// @param socketPath 编译服务的套接字路径
+/// @param options 编译选项，其中的编译缓存不发送，由cacheDir指定
+/// @param cacheDir 编译缓存的目录，为空时不使用缓存
+/// @param jobs 各源文件与输出文件，相对路径按客户端的当前目录转为绝对路径后发送
+/// @param batch 是否批量编译
+/// @param jobCount 批量编译时同时编译的文件数
+/// @return 0 成功
+/// @return -1 失败，或者连接不上编译服务
+///
+int compileRemote(const std::string & socketPath,
+                  const CompileOptions & options,
+                  const std::string & cacheDir,
+                  const std::vector<CompileJob> & jobs,
+                  bool batch,
+                  unsigned jobCount);
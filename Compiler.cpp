@@ -0,0 +1,711 @@
+///
+/// @file Compiler.cpp
+/// @brief 编译入口的实现，编译状态都属于一次调用，多个线程可同时编译
+/// @author zenglj (zenglj@live.com)
+/// @version 1.6
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>批量编译多个源文件
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>增加编译结束时跳过资源释放的选项
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>线性IR生成后建立各函数的控制流图并删除不可达的基本块
+/// <tr><td>2026-10-15 <td>1.4     <td>zenglj  <td>线性IR转换为SSA形式，进入后端前消除phi指令
+/// <tr><td>2026-10-15 <td>1.5     <td>zenglj  <td>由遍管理器按优化级别执行优化与降级的遍，支持统计各遍的耗时
+/// <tr><td>2026-10-15 <td>1.6     <td>zenglj  <td>流式编译的全局变量在第一个函数前输出，-S -c的输出与整体编译相同
+/// </table>
+///
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <sys/stat.h>
+
+#include "Compiler.h"
+#include "Common.h"
+#include "AST.h"
+#include "Antlr4Executor.h"
+#include "CodeGenerator.h"
+#include "CodeGeneratorArm32.h"
+#include "CompileCache.h"
+#include "FlexBisonExecutor.h"
+#include "FrontEndExecutor.h"
+#include "Graph.h"
+#include "IRGenerator.h"
+#include "RecursiveDescentExecutor.h"
+#include "Module.h"
+#include "PassManager.h"
+#include "Sha256.h"
+#include "ThreadPool.h"
+#include "WorkStealingPool.h"
+
+///
+/// @brief 根据选项创建词法语法分析器
+/// @param options 编译选项
+/// @param inputFile 源文件
+/// @return FrontEndExecutor* 词法语法分析器
+///
+static FrontEndExecutor * newFrontEndExecutor(const CompileOptions & options, const std::string & inputFile)
+{
+    FrontEndExecutor * frontEndExecutor;
+
+    if (options.frontEnd == FrontEndKind::Antlr4) {
+        // Antlr4
+        frontEndExecutor = new Antlr4Executor(inputFile);
+    } else if (options.frontEnd == FrontEndKind::RecursiveDescent) {
+        // 递归下降分析法
+        frontEndExecutor = new RecursiveDescentExecutor(inputFile);
+    } else {
+        // 默认为Flex+Bison
+        frontEndExecutor = new FlexBisonExecutor(inputFile);
+    }
+
+    return frontEndExecutor;
+}
+
+///
+/// @brief 编译器的版本标记，编译器重新构建后缓存全部失效。这里以可执行程序的大小与修改时间作为标记
+/// @return std::string 版本标记
+///
+static std::string compilerStamp()
+{
+    std::string stamp = "minic-cache-1";
+
+#ifndef _WIN32
+    struct stat st;
+    if (stat("/proc/self/exe", &st) == 0) {
+        stamp += ":" + std::to_string((long long) st.st_size) + ":" + std::to_string((long long) st.st_mtime);
+    }
+#endif
+
+    return stamp;
+}
+
+///
+/// @brief 影响函数汇编代码的编译选项，作为函数缓存键的一部分
+/// @param options 编译选项
+/// @return std::string 选项
+///
+static std::string functionOptionsKey(const CompileOptions & options)
+{
+    return compilerStamp() + ":" + options.cpuTarget + ":O" + std::to_string(options.optLevel) + ":c" +
+           std::to_string((int) options.asmAlsoShowIR);
+}
+
+///
+/// @brief 整个源文件的缓存键：编译选项、前端、输出的内容以及源文件的内容
+/// @param options 编译选项
+/// @param source 源文件的内容
+/// @return std::string 缓存键
+///
+static std::string fileCacheKey(const CompileOptions & options, const std::string & source)
+{
+    Sha256 sha;
+
+    sha.update(functionOptionsKey(options));
+    sha.update(options.showLineIR ? "ir" : "asm");
+    sha.update(options.frontEnd == FrontEndKind::Antlr4
+                   ? "antlr4"
+                   : (options.frontEnd == FrontEndKind::RecursiveDescent ? "rd" : "flexbison"));
+    sha.update(options.streamCompile ? "stream" : "whole");
+    sha.update(source);
+
+    return sha.hexDigest();
+}
+
+///
+/// @brief 函数级缓存键的计算。顶层定义按源代码中的次序依次加入，函数的键由编译选项、函数AST的指纹，
+/// 以及函数中引用的、在它之前定义的函数的签名与全局变量的声明决定。只修改一个函数的函数体时，其它函数的键不变
+///
+class FunctionKeyTable {
+
+public:
+    /// @brief 构造函数
+    /// @param _optionsKey 影响函数汇编代码的编译选项
+    explicit FunctionKeyTable(std::string _optionsKey) : optionsKey(std::move(_optionsKey))
+    {}
+
+    ///
+    /// @brief 加入一个顶层定义
+    /// @param item 顶层定义，函数定义或者变量声明语句
+    /// @return std::string 函数定义时为函数的缓存键，否则为空串
+    ///
+    std::string add(ast_node * item)
+    {
+        if (item->node_type == ast_operator_type::AST_OP_DECL_STMT) {
+            // 全局变量的声明
+            for (auto decl: item->sons()) {
+                declarations[symbolName(decl->sons()[1]->getName())] = "var:" + ast_fingerprint(decl);
+            }
+
+            return "";
+        }
+
+        if (item->node_type != ast_operator_type::AST_OP_FUNC_DEF) {
+            return "";
+        }
+
+        // 函数中出现的所有名字，按名字排序
+        std::set<std::string> names;
+
+        std::vector<ast_node *> stack{item};
+        while (!stack.empty()) {
+            ast_node * node = stack.back();
+            stack.pop_back();
+
+            if (node->getName() != EmptySymbol) {
+                names.insert(symbolName(node->getName()));
+            }
+
+            for (auto son: node->sons()) {
+                stack.push_back(son);
+            }
+        }
+
+        Sha256 sha;
+        sha.update(optionsKey);
+        sha.update(ast_fingerprint(item));
+
+        // 名字是之前定义的函数或全局变量时，其签名或声明影响函数的汇编代码。局部变量同名时多计入不影响正确性
+        for (auto & name: names) {
+            auto iter = declarations.find(name);
+            if (iter != declarations.end()) {
+                sha.update(name);
+                sha.update(iter->second);
+            }
+        }
+
+        // 函数的签名：返回值类型与形参
+        auto sons = item->sons();
+        declarations[symbolName(item->getName())] = "func:" + ast_fingerprint(sons[0]) + ast_fingerprint(sons[2]);
+
+        return sha.hexDigest();
+    }
+
+private:
+    /// @brief 影响函数汇编代码的编译选项
+    std::string optionsKey;
+
+    /// @brief 已定义的函数的签名与全局变量的声明
+    std::unordered_map<std::string, std::string> declarations;
+};
+
+///
+/// @brief 以函数为单位流式编译生成汇编。前端每归约出一个顶层定义，就立即翻译成线性IR并产生汇编，
+/// 随后释放其AST与线性IR。全局变量在第一个函数前输出，之后定义的全局变量在最后输出。内存的峰值取决于最大的函数，而不是源文件的大小。
+/// @param options 编译选项
+/// @param inputFile 源文件
+/// @param outputFile 输出的汇编文件
+/// @return 0 成功
+/// @return -1 失败
+///
+static int compileStream(const CompileOptions & options, const std::string & inputFile, const std::string & outputFile)
+{
+    // 函数返回值，默认-1
+    int result = -1;
+
+    // 顶层定义的处理结果，出错后后续的顶层定义只做语法检查
+    bool itemResult = true;
+
+    // 符号表，保存所有的变量以及函数等信息
+    Module * module = new Module(inputFile);
+
+    // AST遍历产生线性IR，不指定根节点，由前端逐个送入顶层定义
+    IRGenerator ast2IR(nullptr, module);
+
+    // 按优化级别对每个函数执行优化与降级的遍，模块级的遍在流式编译时不执行
+    PassManager passManager(module, options.timePasses);
+    passManager.buildPipeline(options.optLevel);
+
+    CodeGeneratorArm32 * generator = nullptr;
+
+    // 函数级缓存键的计算
+    FunctionKeyTable functionKeys(functionOptionsKey(options));
+
+    do {
+
+        if (options.cpuTarget == "ARM32") {
+            // 输出面向ARM32的汇编指令
+            generator = new CodeGeneratorArm32(module);
+            generator->setShowLinearIR(options.asmAlsoShowIR);
+            generator->setFunctionCache(options.cache);
+        } else {
+            // 不支持指定的CPU架构
+            minic_log(LOG_ERROR, "指定的目标CPU架构(%s)不支持", options.cpuTarget.c_str());
+            break;
+        }
+
+        if (!generator->beginStream(outputFile)) {
+            break;
+        }
+
+        // 前端每归约出一个顶层定义就调用一次，调用后其AST被释放。处理函数只对当前线程的前端有效
+        ast_unit_item_handler = [&](ast_node * item) {
+            if (!itemResult) {
+                return;
+            }
+
+            // 计算函数的缓存键，要在翻译前计算，翻译时可能修改AST
+            std::string functionKey;
+            if (options.cache) {
+                functionKey = functionKeys.add(item);
+            }
+
+            // 翻译成线性IR，函数定义翻译后加入到符号表中
+            if (!ast2IR.runUnitItem(item)) {
+                minic_log(LOG_ERROR, "中间IR生成错误");
+                itemResult = false;
+                return;
+            }
+
+            if (item->node_type != ast_operator_type::AST_OP_FUNC_DEF) {
+                // 全局变量等只加入符号表，在第一个函数前或最后输出
+                return;
+            }
+
+            Function * func = module->findFunction(item->getName());
+
+            passManager.optimize(func);
+            passManager.lower(func);
+
+            if (!functionKey.empty()) {
+                generator->setFunctionKey(func->getName(), functionKey);
+            }
+
+            // 要使得汇编能输出IR指令作为注释，必须对IR的名字进行命名，否则为空值
+            if (options.asmAlsoShowIR) {
+                func->renameIR();
+            }
+
+            // 产生函数的汇编后释放其线性IR，函数本身保留，以便后续的函数调用
+            generator->streamFunction(func);
+            func->Delete();
+            passManager.releaseFunction(func);
+        };
+
+        // 前端执行：词法分析、语法分析，顶层定义边分析边处理
+        FrontEndExecutor * frontEndExecutor = newFrontEndExecutor(options, inputFile);
+        bool subResult = frontEndExecutor->run();
+        ast_node * astRoot = frontEndExecutor->getASTRoot();
+        delete frontEndExecutor;
+
+        if (options.showParseStats && (options.frontEnd == FrontEndKind::Antlr4)) {
+            Antlr4Executor::printParseStats(stderr);
+        }
+
+        ast_unit_item_handler = nullptr;
+
+        // 清理抽象语法树，只剩下编译单元节点
+        free_ast(astRoot);
+
+        if (!subResult) {
+            minic_log(LOG_ERROR, "前端分析错误");
+            break;
+        }
+
+        if (!itemResult) {
+            break;
+        }
+
+        // 输出第一个函数之后才定义的全局变量
+        generator->endStream();
+
+        // 成功执行
+        result = 0;
+
+    } while (false);
+
+    delete generator;
+
+    if (options.timePasses) {
+        passManager.printTimings(stderr);
+    }
+
+    // 清理符号表，进程随即退出时交给操作系统回收
+    if (!options.fastExit) {
+        module->Delete();
+        delete module;
+    }
+
+    return result;
+}
+
+///
+/// @brief 对整个源文件进行编译处理，按选项生成AST图片、线性IR或汇编
+/// @param options 编译选项
+/// @param inputFile 源文件
+/// @param outputFile 输出文件
+/// @return 0 成功
+/// @return -1 失败
+///
+static int compileWhole(const CompileOptions & options, const std::string & inputFile, const std::string & outputFile)
+{
+    // 函数返回值，默认-1
+    int result = -1;
+
+    // 内部函数调用返回值保存变量
+    int subResult;
+
+    // 抽象语法树的根节点，出错退出时也要释放
+    ast_node * astRoot = nullptr;
+
+    // 符号表，出错退出时也要释放
+    Module * module = nullptr;
+
+    // 遍管理器，符号表创建后按优化级别创建
+    PassManager * passManager = nullptr;
+
+    // 这里采用do {} while(0)架构的目的是如果处理出错可通过break退出循环，出口唯一
+    // 在编译器编译优化时会自动去除，因为while恒假的缘故
+    do {
+
+        // 编译过程主要包括：
+        // 1）词法语法分析生成AST
+        // 2) 遍历AST生成线性IR
+        // 3) 对线性IR进行优化：按优化级别执行遍管理器中的遍
+        // 4) 把线性IR转换成汇编
+
+        // 创建词法语法分析器
+        FrontEndExecutor * frontEndExecutor = newFrontEndExecutor(options, inputFile);
+
+        // 前端执行：词法分析、语法分析后产生抽象语法树，AST存储在当前线程的ast_context中
+        subResult = frontEndExecutor->run();
+
+        if (options.showParseStats && (options.frontEnd == FrontEndKind::Antlr4)) {
+            Antlr4Executor::printParseStats(stderr);
+        }
+        // 获取抽象语法树的根节点
+        astRoot = frontEndExecutor->getASTRoot();
+
+        // 清理前端资源
+        delete frontEndExecutor;
+
+        if (!subResult) {
+
+            minic_log(LOG_ERROR, "前端分析错误");
+            // 退出循环
+            break;
+        }
+
+        // 构造完毕后按先根次序重排孩子数组，后续遍历时访问的孩子在内存中连续
+        ast_context->compact(astRoot);
+
+        // 计算各个函数的缓存键，翻译成线性IR后AST被释放
+        std::vector<std::pair<std::string, std::string>> functionKeys;
+        if (options.cache && options.showASM && astRoot->node_type == ast_operator_type::AST_OP_COMPILE_UNIT) {
+
+            FunctionKeyTable keyTable(functionOptionsKey(options));
+
+            for (auto item: astRoot->sons()) {
+                std::string key = keyTable.add(item);
+                if (!key.empty()) {
+                    functionKeys.emplace_back(symbolName(item->getName()), key);
+                }
+            }
+        }
+
+        // 这里可进行非线性AST的优化
+
+        if (options.showAST) {
+
+            // 遍历抽象语法树，生成抽象语法树图片。graphviz不是线程安全的，多个编译同时输出时串行进行
+            {
+                static std::mutex graphMutex;
+                std::lock_guard<std::mutex> lock(graphMutex);
+
+                OutputAST(astRoot, outputFile);
+            }
+
+            // 设置返回结果：正常
+            result = 0;
+
+            break;
+        }
+
+        // 输出线性中间IR、计算器模拟解释执行、输出汇编指令
+        // 都需要遍历AST转换成线性IR指令
+
+        // 符号表，保存所有的变量以及函数等信息
+        module = new Module(inputFile);
+
+        // 遍历抽象语法树产生线性IR，相关信息保存到符号表中
+        IRGenerator ast2IR(astRoot, module);
+        ast2IR.setThreadCount(options.threadCount);
+        subResult = ast2IR.run();
+        if (!subResult) {
+
+            // 输出错误信息
+            minic_log(LOG_ERROR, "中间IR生成错误");
+
+            break;
+        }
+
+        // 清理抽象语法树
+        free_ast(astRoot);
+        astRoot = nullptr;
+
+        // 按优化级别优化各函数的线性IR，-I输出的是优化后的IR
+        passManager = new PassManager(module, options.timePasses);
+        passManager->buildPipeline(options.optLevel);
+        passManager->optimize(module);
+
+        if (options.showLineIR) {
+
+            // 对IR的名字重命名
+            module->renameIR();
+
+            // 输出IR
+            module->outputIR(outputFile);
+
+            // 设置返回结果：正常
+            result = 0;
+
+            break;
+        }
+
+        // 后端不能处理的形式（如phi指令），先转换回非SSA形式
+        passManager->lower(module);
+
+        // 要使得汇编能输出IR指令作为注释，必须对IR的名字进行命名，否则为空值
+        if (options.asmAlsoShowIR) {
+            // 对IR的名字重命名
+            module->renameIR();
+        }
+
+        // 后端处理，体系结果相关的操作
+        // 这里提供一种面向ARM32的汇编产生器CodeGeneratorArm32作为参考
+        // 需要时可根据需要修改或追加新的目标体系架构
+        if (options.showASM) {
+
+            CodeGenerator * generator = nullptr;
+
+            if (options.cpuTarget == "ARM32") {
+                // 输出面向ARM32的汇编指令，未修改的函数从缓存中获取
+                CodeGeneratorArm32 * arm32Generator = new CodeGeneratorArm32(module);
+                arm32Generator->setFunctionCache(options.cache);
+                for (auto & [name, key]: functionKeys) {
+                    arm32Generator->setFunctionKey(name, key);
+                }
+
+                generator = arm32Generator;
+                generator->setShowLinearIR(options.asmAlsoShowIR);
+                generator->run(outputFile);
+            } else {
+                // 不支持指定的CPU架构
+                minic_log(LOG_ERROR, "指定的目标CPU架构(%s)不支持", options.cpuTarget.c_str());
+                break;
+            }
+
+            delete generator;
+        }
+
+        // 成功执行
+        result = 0;
+
+    } while (false);
+
+    // 出错退出时AST可能还未释放
+    if (astRoot) {
+        free_ast(astRoot);
+    }
+
+    if (passManager) {
+        if (options.timePasses) {
+            passManager->printTimings(stderr);
+        }
+        delete passManager;
+    }
+
+    // 清理符号表，进程随即退出时交给操作系统回收
+    if (module && !options.fastExit) {
+        module->Delete();
+        delete module;
+    }
+
+    return result;
+}
+
+///
+/// @brief 使用编译缓存编译：整个源文件的缓存命中时直接输出缓存的结果，否则编译后把结果写入缓存。
+/// 编译时未修改的函数从函数级的缓存中获取汇编代码
+/// @param options 编译选项
+/// @param inputFile 源文件
+/// @param outputFile 输出文件
+/// @return 0 成功
+/// @return -1 失败
+///
+static int compileWithCache(const CompileOptions & options, const std::string & inputFile, const std::string & outputFile)
+{
+    std::string source;
+    std::string key;
+    std::string data;
+
+    // 源文件读取失败时不使用缓存，由前端报告错误
+    bool cacheable = CompileCache::readFile(inputFile, source);
+    if (cacheable) {
+        key = fileCacheKey(options, source);
+
+        if (options.cache->load(key, data) && CompileCache::writeFile(outputFile, data)) {
+            return 0;
+        }
+    }
+
+    int result;
+    if (options.streamCompile && options.showASM) {
+        result = compileStream(options, inputFile, outputFile);
+    } else {
+        result = compileWhole(options, inputFile, outputFile);
+    }
+
+    if (cacheable && (result == 0) && CompileCache::readFile(outputFile, data)) {
+        options.cache->store(key, data);
+    }
+
+    return result;
+}
+
+///
+/// @brief 编译一个源文件。前端、AST、符号表与后端的状态都属于本次编译，
+/// 多个线程可同时调用以并发编译不同的源文件，但输出文件不能相同
+/// @param options 编译选项
+/// @param inputFile 源文件
+/// @param outputFile 输出文件，按选项输出AST图片、线性IR或者汇编
+/// @return 0 成功
+/// @return -1 失败
+///
+int compile(const CompileOptions & options, const std::string & inputFile, const std::string & outputFile)
+{
+    if (options.cache && !options.showAST) {
+        // 使用编译缓存，只缓存线性IR与汇编
+        return compileWithCache(options, inputFile, outputFile);
+    }
+
+    if (options.streamCompile && options.showASM) {
+        // 以函数为单位流式编译，只在输出汇编时有效
+        return compileStream(options, inputFile, outputFile);
+    }
+
+    return compileWhole(options, inputFile, outputFile);
+}
+
+///
+/// @brief 输出一个源文件的诊断信息，每行前加上源文件名
+/// @param job 编译完成的源文件
+/// @param output 诊断信息的输出，为空时输出到标准输出
+///
+static void printDiagnostics(const CompileJob & job, std::string * output)
+{
+    std::string text;
+
+    size_t start = 0;
+    while (start < job.diagnostics.size()) {
+        size_t end = job.diagnostics.find('\n', start);
+        if (end == std::string::npos) {
+            end = job.diagnostics.size();
+        }
+
+        // 空行不输出
+        if (end > start) {
+            text += job.inputFile;
+            text += ": ";
+            text.append(job.diagnostics, start, end - start);
+            text += '\n';
+        }
+
+        start = end + 1;
+    }
+
+    if (output) {
+        output->append(text);
+        return;
+    }
+
+    // 一个文件的诊断信息一次写出
+    fwrite(text.data(), 1, text.size(), stdout);
+    fflush(stdout);
+}
+
+///
+/// @brief 批量编译多个源文件。各源文件在工作窃取的线程池上并发编译，每个文件的诊断信息单独收集，
+/// 一个文件编译完成后整体输出，不同文件的诊断信息不会交错
+/// @param options 编译选项，各文件相同
+/// @param jobs 各源文件与输出文件，编译后填写结果与诊断信息
+/// @param jobCount 同时编译的文件数，为0表示按硬件支持的并发线程数
+/// @param output 诊断信息的输出，为空时输出到标准输出
+/// @return 0 全部成功
+/// @return -1 有文件失败
+///
+int compileBatch(const CompileOptions & options, std::vector<CompileJob> & jobs, unsigned jobCount, std::string * output)
+{
+    if (jobs.empty()) {
+        return 0;
+    }
+
+    // 文件之间已经并发，文件内部不再并行翻译函数体，避免线程数相乘
+    CompileOptions fileOptions = options;
+    fileOptions.threadCount = 1;
+
+    // 每个文件编译后都要释放，否则内存随文件数累积
+    fileOptions.fastExit = false;
+
+    if (jobCount == 0) {
+        jobCount = ThreadPool::hardwareThreads();
+    }
+    jobCount = (unsigned) std::min<size_t>(jobCount, jobs.size());
+
+    // 按源文件从小到大提交，轮流放入各线程的队列。线程从自己的队尾取任务，先编译大文件；
+    // 空闲线程从别人的队头窃取小文件，最后各线程差不多同时结束
+    std::vector<off_t> sizes(jobs.size(), 0);
+    for (size_t k = 0; k < jobs.size(); ++k) {
+        struct stat st;
+        if (stat(jobs[k].inputFile.c_str(), &st) == 0) {
+            sizes[k] = st.st_size;
+        }
+    }
+
+    std::vector<size_t> order(jobs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) { return sizes[a] < sizes[b]; });
+
+    // 诊断信息的输出互斥
+    std::mutex outputMutex;
+
+    {
+        WorkStealingPool pool(jobCount);
+
+        for (size_t index: order) {
+            pool.submit([&fileOptions, &jobs, &outputMutex, output, index] {
+                CompileJob & job = jobs[index];
+
+                // 本线程在编译期间产生的诊断信息都收集到该文件中
+                minic_set_diag_buffer(&job.diagnostics);
+                job.result = compile(fileOptions, job.inputFile, job.outputFile);
+                minic_set_diag_buffer(nullptr);
+
+                if (!job.diagnostics.empty()) {
+                    std::lock_guard<std::mutex> lock(outputMutex);
+                    printDiagnostics(job, output);
+                }
+            });
+        }
+
+        pool.wait();
+    }
+
+    for (auto & job: jobs) {
+        if (job.result != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+///
+/// @file Compiler.h
+/// @brief 编译入口，一次调用完成一个源文件的编译，多个线程可同时调用
+/// @author zenglj (zenglj@live.com)
+/// @version 1.4
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>批量编译多个源文件
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>增加编译结束时跳过资源释放的选项
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>增加输出各遍耗时的选项
+/// <tr><td>2026-10-15 <td>1.4     <td>zenglj  <td>默认串行翻译函数体
+/// </table>
+///
+#pragma once
+
+#include <string>
+#include <vector>
+
+class CompileCache;
+
+///
+/// @brief 词法与语法分析的前端
+///
+enum class FrontEndKind {
+    /// @brief Flex+Bison
+    FlexBison,
+
+    /// @brief Antlr4
+    Antlr4,
+
+    /// @brief 递归下降分析法
+    RecursiveDescent,
+};
+
+///
+/// @brief 编译选项，对应命令行的各个选项
+///
+struct CompileOptions {
+    /// @brief 输出抽象语法树的图片
+    bool showAST = false;
+
+    /// @brief 输出线性IR
+    bool showLineIR = false;
+
+    /// @brief 输出汇编
+    bool showASM = true;
+
+    /// @brief 词法与语法分析的前端
+    FrontEndKind frontEnd = FrontEndKind::FlexBison;
+
+    /// @brief 在输出汇编时是否输出中间IR作为注释
+    bool asmAlsoShowIR = false;
+
+    /// @brief 以函数为单位流式编译，只在输出汇编时有效
+    bool streamCompile = false;
+
+    /// @brief 是否输出前端语法分析的统计信息，目前只有antlr4前端支持
+    bool showParseStats = false;
+
+    /// @brief 并行翻译函数体的线程数，默认为1即串行翻译，为0表示按硬件支持的并发线程数
+    unsigned threadCount = 1;
+
+    /// @brief 优化的级别，0不优化，1构造SSA并删除死代码，2再做常量传播等优化
+    int optLevel = 0;
+
+    /// @brief 是否在标准错误上输出各遍与各分析的耗时
+    bool timePasses = false;
+
+    /// @brief CPU目标架构
+    std::string cpuTarget = "ARM32";
+
+    /// @brief 编译结束时不释放符号表与线性IR，由进程退出时整体回收，只适合编译后随即退出的单个文件编译
+    bool fastExit = false;
+
+    /// @brief 编译缓存，为空时不使用缓存。只缓存线性IR与汇编，可被多个同时进行的编译共享
+    CompileCache * cache = nullptr;
+};
+
+///
+/// @brief 编译一个源文件。前端、AST、符号表与后端的状态都属于本次编译，
+/// 多个线程可同时调用以并发编译不同的源文件，但输出文件不能相同
+/// @param options 编译选项
+/// @param inputFile 源文件
+/// @param outputFile 输出文件，按选项输出AST图片、线性IR或者汇编
+/// @return 0 成功
+/// @return -1 失败
+///
+int compile(const CompileOptions & options, const std::string & inputFile, const std::string & outputFile);
+
+///
+/// @brief 批量编译中的一个源文件
+///
+struct CompileJob {
+    /// @brief 源文件
+    std::string inputFile;
+
+    /// @brief 输出文件
+    std::string outputFile;
+
+    /// @brief 编译结果，0 成功 -1 失败
+    int result = -1;
+
+    /// @brief 编译该文件时产生的诊断信息
+    std::string diagnostics;
+};
+
+///
+/// @brief 批量编译多个源文件。各源文件在工作窃取的线程池上并发编译，每个文件的诊断信息单独收集，
+/// 一个文件编译完成后整体输出，不同文件的诊断信息不会交错
+/// @param options 编译选项，各文件相同
+/// @param jobs 各源文件与输出文件，编译后填写结果与诊断信息
+/// @param jobCount 同时编译的文件数，为0表示按硬件支持的并发线程数
+/// @param output 诊断信息的输出，为空时输出到标准输出
+/// @return 0 全部成功
+/// @return -1 有文件失败
+///
+int compileBatch(const CompileOptions & options,
+                 std::vector<CompileJob> & jobs,
+                 unsigned jobCount,
+                 std::string * output = nullptr);
@@ -2,8 +2,8 @@
 /// @file CodeGenerator.cpp
 /// @brief 代码生成器共同类的实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.1
+/// @date 2026-10-15
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>支持以函数为单位的流式代码产生
 /// </table>
 ///
 #include <cstdio>
@@ -18,16 +19,23 @@
 
 #include "Module.h"
 #include "CodeGenerator.h"
+#include "Common.h"
 
 /// @brief 构造函数
 /// @param _module 符号表:模块
 CodeGenerator::CodeGenerator(Module * _module) : module(_module)
 {}
 
-/// @brief 代码产生器运行，结果保存到指定的文件中
-/// @param outFileName 输出内容所在文件
+/// @brief 析构函数，流式产生代码出错时可能未关闭的文件在这里关闭
+CodeGenerator::~CodeGenerator()
+{
+    closeFile();
+}
+
+/// @brief 打开输出文件
+/// @param outFileName 输出内容所在文件，为空时不创建文件
 /// @return true：成功，false：失败
-bool CodeGenerator::run(std::string outFileName)
+bool CodeGenerator::openFile(const std::string & outFileName)
 {
     // 打开文件，也可以以C++的方式打开文件进行操作
     // 这里主要便于C语言学习的学生
@@ -35,21 +43,64 @@ bool CodeGenerator::run(std::string outFileName)
         // 指定文件非空时，则创建文件
         fp = fopen(outFileName.c_str(), "w");
         if (nullptr == fp) {
-            printf("open file(%s) failed", outFileName.c_str());
+            minic_diag("open file(%s) failed\n", outFileName.c_str());
             return false;
         }
     } else {
         fp = nullptr;
     }
 
-    // 执行真正的代码
-    const bool result = run();
+    return true;
+}
 
-    // 关闭文件
+/// @brief 关闭输出文件
+void CodeGenerator::closeFile()
+{
     if (fp) {
         fclose(fp);
         fp = nullptr;
     }
+}
+
+/// @brief 代码产生器运行，结果保存到指定的文件中
+/// @param outFileName 输出内容所在文件
+/// @return true：成功，false：失败
+bool CodeGenerator::run(std::string outFileName)
+{
+    if (!openFile(outFileName)) {
+        return false;
+    }
+
+    // 执行真正的代码
+    const bool result = run();
+
+    // 关闭文件
+    closeFile();
 
     return result;
 }
+
+/// @brief 流式产生代码的开始：打开输出文件并产生文件头部
+/// @param outFileName 输出内容所在文件
+/// @return true：成功，false：失败
+bool CodeGenerator::beginStream(std::string outFileName)
+{
+    if (!openFile(outFileName)) {
+        return false;
+    }
+
+    streamHeader();
+
+    return true;
+}
+
+/// @brief 流式产生代码的结束：产生全局变量等文件尾部的内容并关闭输出文件
+/// @return true：成功，false：失败
+bool CodeGenerator::endStream()
+{
+    streamTrailer();
+
+    closeFile();
+
+    return true;
+}
@@ -2,8 +2,8 @@
 /// @file CodeGenerator.h
 /// @brief 代码生成器共同类的头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.1
+/// @date 2026-10-15
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>支持以函数为单位的流式代码产生
 /// </table>
 ///
 #pragma once
@@ -28,14 +29,28 @@ public:
     /// @param _symtab 符号表
     CodeGenerator(Module * _module);
 
-    /// @brief 析构函数
-    virtual ~CodeGenerator() = default;
+    /// @brief 析构函数，流式产生代码出错时可能未关闭的文件在这里关闭
+    virtual ~CodeGenerator();
 
     /// @brief 代码产生器运行，结果保存到指定的文件中
     /// @param outFileName 输出内容所在文件
     /// @return true：成功，false：失败
     bool run(std::string outFileName);
 
+    /// @brief 流式产生代码的开始：打开输出文件并产生文件头部
+    /// @param outFileName 输出内容所在文件
+    /// @return true：成功，false：失败
+    bool beginStream(std::string outFileName);
+
+    /// @brief 流式产生代码：函数的线性IR产生完毕后立即产生其代码，之后函数的线性IR即可释放
+    /// @param func 要处理的函数
+    /// @return true：成功，false：失败
+    virtual bool streamFunction(Function * func) = 0;
+
+    /// @brief 流式产生代码的结束：产生全局变量等文件尾部的内容并关闭输出文件
+    /// @return true：成功，false：失败
+    bool endStream();
+
     ///
     /// @brief 设置是否显示IR指令内容
     /// @param show true：显示，false：不显示
@@ -51,6 +66,20 @@ protected:
     /// @return true：成功，false：失败
     virtual bool run() = 0;
 
+    /// @brief 流式产生代码时产生文件头部
+    virtual void streamHeader() = 0;
+
+    /// @brief 流式产生代码时产生文件尾部，如全局变量
+    virtual void streamTrailer() = 0;
+
+    /// @brief 打开输出文件
+    /// @param outFileName 输出内容所在文件，为空时不创建文件
+    /// @return true：成功，false：失败
+    bool openFile(const std::string & outFileName);
+
+    /// @brief 关闭输出文件
+    void closeFile();
+
     ///
     /// @brief 一个C语言的文件对应一个Module
     ///
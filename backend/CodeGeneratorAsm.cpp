@@ -2,8 +2,8 @@
 /// @file CodeGeneratorAsm.cpp
 /// @brief 后端汇编代码生成器接口的实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.4
+/// @date 2026-10-15
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,10 +11,18 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>支持以函数为单位的流式代码产生
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>支持以函数为单位缓存汇编代码
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>函数的汇编产生后释放其线性IR
+/// <tr><td>2026-10-15 <td>1.4     <td>zenglj  <td>流式产生代码时在第一个函数前输出已定义的全局变量
 /// </table>
 ///
+#include <cctype>
+#include <string>
+
 #include "CodeGenerator.h"
 #include "CodeGeneratorAsm.h"
+#include "IRConstant.h"
 #include "Module.h"
 #include "Function.h"
 
@@ -34,7 +42,10 @@ void CodeGeneratorAsm::genCodeSection()
         if (!func->isBuiltin()) {
 
             // 针对func产生汇编指令
-            genCodeSection(func);
+            emitFunction(func);
+
+            // 汇编已产生，函数体的线性IR不再需要，随函数的内存池整体释放
+            func->Delete();
         }
     }
 }
@@ -55,3 +66,164 @@ bool CodeGeneratorAsm::run()
 
     return true;
 }
+
+/// @brief 流式产生代码时产生汇编头部，代码段在前
+void CodeGeneratorAsm::streamHeader()
+{
+    // 重新设置为0
+    labelIndex = 0;
+
+    // 产生头，汇编器的缺省段为代码段
+    genHeader();
+}
+
+/// @brief 流式产生代码：函数的线性IR产生完毕后立即产生其汇编指令
+/// @param func 要处理的函数
+/// @return true：成功，false：失败
+bool CodeGeneratorAsm::streamFunction(Function * func)
+{
+    if (!func->isBuiltin()) {
+        // 第一个函数前先输出已定义的全局变量，全局变量都在函数之前定义时，与整体产生的汇编相同
+        if (!dataSectionStarted) {
+            genDataSection();
+        }
+
+        // 针对func产生汇编指令
+        emitFunction(func);
+    }
+
+    return true;
+}
+
+/// @brief 流式产生代码时产生数据段，输出第一个函数之后才定义的全局变量
+void CodeGeneratorAsm::streamTrailer()
+{
+    // 产生数据段，含初始化和未初始化数据
+    genDataSection();
+}
+
+/// @brief 产生一个函数的汇编指令，设置了缓存键时先查找缓存，未命中时产生后写入缓存
+/// @param func 要处理的函数
+void CodeGeneratorAsm::emitFunction(Function * func)
+{
+    auto iter = functionKeys.end();
+    if (functionCache) {
+        iter = functionKeys.find(func->getName());
+    }
+
+    if (iter == functionKeys.end()) {
+        // 不使用缓存
+        genCodeSection(func);
+        return;
+    }
+
+    const std::string & key = iter->second;
+
+    std::string data;
+    if (functionCache->load(key, data) && emitCachedFunction(data)) {
+        return;
+    }
+
+    // 未命中，先把汇编代码产生到临时文件中，以便写入缓存
+    FILE * tmpFp = tmpfile();
+    if (!tmpFp) {
+        genCodeSection(func);
+        return;
+    }
+
+    int64_t firstLabel = labelIndex;
+
+    FILE * outFp = fp;
+    fp = tmpFp;
+    genCodeSection(func);
+    fp = outFp;
+
+    std::string text;
+    char buf[16384];
+    size_t n;
+
+    rewind(tmpFp);
+    while ((n = fread(buf, 1, sizeof(buf), tmpFp)) > 0) {
+        text.append(buf, n);
+    }
+    fclose(tmpFp);
+
+    fwrite(text.data(), 1, text.size(), fp);
+
+    // 缓存的内容：第一行为函数使用的Label个数，之后为Label从0开始编号的汇编代码
+    functionCache->store(key, std::to_string(labelIndex - firstLabel) + "\n" + rebaseLabels(text, -firstLabel));
+}
+
+/// @brief 把缓存的函数汇编代码输出到文件中，其中的Label按当前的Label索引编号重新编号
+/// @param data 缓存的内容
+/// @return true：成功，false：缓存内容无效
+bool CodeGeneratorAsm::emitCachedFunction(const std::string & data)
+{
+    size_t pos = data.find('\n');
+    if (pos == std::string::npos || pos == 0) {
+        return false;
+    }
+
+    int64_t labelCount = 0;
+    for (size_t k = 0; k < pos; ++k) {
+        if (!isdigit((unsigned char) data[k])) {
+            return false;
+        }
+        labelCount = labelCount * 10 + (data[k] - '0');
+    }
+
+    std::string text = rebaseLabels(data.substr(pos + 1), labelIndex);
+    fwrite(text.data(), 1, text.size(), fp);
+
+    labelIndex += labelCount;
+
+    return true;
+}
+
+/// @brief 汇编代码中的Label编号加上一个偏移。只处理注释符@之前的部分，注释中的IR指令使用函数内的Label名字
+/// @param text 汇编代码
+/// @param delta 偏移
+/// @return std::string 重新编号后的汇编代码
+std::string CodeGeneratorAsm::rebaseLabels(const std::string & text, int64_t delta)
+{
+    const std::string prefix = IR_LABEL_PREFIX;
+
+    std::string result;
+    result.reserve(text.size());
+
+    bool inComment = false;
+    size_t k = 0;
+
+    while (k < text.size()) {
+
+        char ch = text[k];
+
+        if (ch == '\n') {
+            inComment = false;
+        } else if (ch == '@') {
+            inComment = true;
+        } else if (!inComment && text.compare(k, prefix.size(), prefix) == 0 &&
+                   (k + prefix.size() < text.size()) && isdigit((unsigned char) text[k + prefix.size()]) &&
+                   (k == 0 || !(isalnum((unsigned char) text[k - 1]) || text[k - 1] == '_'))) {
+
+            // Label的名字，形如.L12，编号加上偏移
+            size_t end = k + prefix.size();
+            int64_t index = 0;
+            while (end < text.size() && isdigit((unsigned char) text[end])) {
+                index = index * 10 + (text[end] - '0');
+                end++;
+            }
+
+            result += prefix;
+            result += std::to_string(index + delta);
+            k = end;
+
+            continue;
+        }
+
+        result += ch;
+        k++;
+    }
+
+    return result;
+}
@@ -2,8 +2,8 @@
 /// @file CodeGeneratorAsm.h
 /// @brief 后端汇编代码生成器接口的头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.3
+/// @date 2026-10-15
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,12 +11,18 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>支持以函数为单位的流式代码产生
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>支持以函数为单位缓存汇编代码
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>流式产生代码时在第一个函数前输出已定义的全局变量
 /// </table>
 ///
 #include <cstdio>
 #include <cstring>
+#include <string>
+#include <unordered_map>
 
 #include "CodeGenerator.h"
+#include "CompileCache.h"
 
 /// @brief 生成汇编的代码生成器共同类
 class CodeGeneratorAsm : public CodeGenerator {
@@ -46,16 +52,73 @@ public:
     /// @param func 要处理的函数
     virtual void registerAllocation(Function * func) = 0;
 
+    /// @brief 流式产生代码：函数的线性IR产生完毕后立即产生其汇编指令
+    /// @param func 要处理的函数
+    /// @return true：成功，false：失败
+    bool streamFunction(Function * func) override;
+
+    ///
+    /// @brief 设置函数级的编译缓存，设置了缓存键的函数优先从缓存中获取汇编代码
+    /// @param cache 编译缓存，为空时不使用缓存
+    ///
+    void setFunctionCache(CompileCache * cache)
+    {
+        this->functionCache = cache;
+    }
+
+    ///
+    /// @brief 设置函数的缓存键
+    /// @param name 函数名
+    /// @param key 缓存键
+    ///
+    void setFunctionKey(const std::string & name, const std::string & key)
+    {
+        functionKeys[name] = key;
+    }
+
 protected:
     /// @brief 产生汇编文件
     /// @return true:成功，false:失败
     bool run() override;
 
+    /// @brief 流式产生代码时产生汇编头部，代码段在前
+    void streamHeader() override;
+
+    /// @brief 流式产生代码时产生数据段，输出第一个函数之后才定义的全局变量
+    void streamTrailer() override;
+
     /// @brief 汇编指令生成，放到.text代码段中
     void genCodeSection();
 
+    /// @brief 产生一个函数的汇编指令，设置了缓存键时先查找缓存，未命中时产生后写入缓存
+    /// @param func 要处理的函数
+    void emitFunction(Function * func);
+
+    /// @brief 把缓存的函数汇编代码输出到文件中，其中的Label按当前的Label索引编号重新编号
+    /// @param data 缓存的内容
+    /// @return true：成功，false：缓存内容无效
+    bool emitCachedFunction(const std::string & data);
+
+    /// @brief 汇编代码中的Label编号加上一个偏移。只处理注释符@之前的部分，注释中的IR指令使用函数内的Label名字
+    /// @param text 汇编代码
+    /// @param delta 偏移
+    /// @return std::string 重新编号后的汇编代码
+    static std::string rebaseLabels(const std::string & text, int64_t delta);
+
     ///
     /// @brief Label索引编号，要求文件级别的编号，而不是函数级别的编号
     ///
     int64_t labelIndex = 0;
+
+    /// @brief 是否已输出数据段的开头
+    bool dataSectionStarted = false;
+
+    /// @brief 已输出到数据段的全局变量个数。流式产生代码时数据段分两次输出，第二次只输出之后定义的全局变量
+    size_t dataSectionGlobals = 0;
+
+    /// @brief 函数级的编译缓存，为空时不使用
+    CompileCache * functionCache = nullptr;
+
+    /// @brief 函数名到缓存键的映射
+    std::unordered_map<std::string, std::string> functionKeys;
 };
@@ -2,7 +2,7 @@
 /// @file CodeGeneratorArm32.cpp
 /// @brief ARM32的后端处理实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.1
 /// @date 2024-11-21
 ///
 /// @copyright Copyright (c) 2024
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>流式产生代码时在第一个函数前输出已定义的全局变量
 /// </table>
 ///
 #include <cstdint>
@@ -51,15 +52,21 @@ void CodeGeneratorArm32::genHeader()
 /// @brief 全局变量Section，主要包含初始化的和未初始化过的
 void CodeGeneratorArm32::genDataSection()
 {
-    // 生成代码段
-    fprintf(fp, ".text\n");
+    // 生成代码段。流式产生代码时数据段分两次输出，只在第一次输出
+    if (!dataSectionStarted) {
+        fprintf(fp, ".text\n");
+        dataSectionStarted = true;
+    }
 
     // 可直接操作文件指针fp进行写操作
 
     // 目前不支持全局变量和静态变量，以及字符串常量
     // 全局变量分两种情况：初始化的全局变量和未初始化的全局变量
     // TODO 这里先处理未初始化的全局变量
-    for (auto var: module->getGlobalVariables()) {
+    std::vector<GlobalVariable *> & globals = module->getGlobalVariables();
+    for (size_t k = dataSectionGlobals; k < globals.size(); ++k) {
+
+        GlobalVariable * var = globals[k];
 
         if (var->isInBSSSection()) {
 
@@ -76,6 +83,8 @@ void CodeGeneratorArm32::genDataSection()
             // TODO 后面设置初始化的值，具体请参考ARM的汇编
         }
     }
+
+    dataSectionGlobals = globals.size();
 }
 
 ///
@@ -118,7 +127,7 @@ void CodeGeneratorArm32::genCodeSection(Function * func)
     registerAllocation(func);
 
     // 获取函数的指令列表
-    std::vector<Instruction *> & IrInsts = func->getInterCode().getInsts();
+    InterCode & IrInsts = func->getInterCode();
 
     // 汇编指令输出前要确保Label的名字有效，必须是程序级别的唯一，而不是函数内的唯一。要全局编号。
     for (auto inst: IrInsts) {
@@ -157,7 +166,7 @@ void CodeGeneratorArm32::genCodeSection(Function * func)
         }
 
         // 输出指令关联的临时变量信息
-        for (auto inst: func->getInterCode().getInsts()) {
+        for (auto inst: func->getInterCode()) {
             if (inst->hasResultValue()) {
                 std::string str;
                 getIRValueStr(inst, str);
@@ -254,17 +263,15 @@ void CodeGeneratorArm32::adjustFormalParamInsts(Function * func)
 /// @param func 要处理的函数
 void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
 {
-    std::vector<Instruction *> newInsts;
-
-    // 当前函数的指令列表
-    auto & insts = func->getInterCode().getInsts();
+    // 当前函数的指令列表，插入指令不会使迭代器失效
+    InterCode & insts = func->getInterCode();
 
     // 函数返回值用R0寄存器，若函数调用有返回值，则赋值R0到对应寄存器
     // 通过栈传递的实参，采用SP + 偏移的方式殉职，偏移肯定非负。
     for (auto pIter = insts.begin(); pIter != insts.end(); pIter++) {
 
         // 检查是否是函数调用指令，并且含有返回值
-        if (Instanceof(callInst, FuncCallInstruction *, *pIter)) {
+        if (auto callInst = dyn_cast<FuncCallInstruction>(*pIter)) {
 
             // 实参前四个要寄存器传值，其它参数通过栈传递
 
@@ -292,15 +299,13 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
                 esp += 4;
 
                 // 引入赋值指令，把实参的值保存到内存变量上
-                Instruction * assignInst = new MoveInstruction(func, newVal, arg);
+                Instruction * assignInst = new (func->getArena()) MoveInstruction(func, newVal, arg);
 
                 // 更换实参变量为内存变量
                 callInst->setOperand(k, newVal);
 
-                // 赋值指令插入到函数调用指令的前面
-                // 函数调用指令前插入后，pIter仍指向函数调用指令
-                pIter = insts.insert(pIter, assignInst);
-                pIter++;
+                // 赋值指令插入到函数调用指令的前面，pIter仍指向函数调用指令
+                insts.insertBefore(callInst, assignInst);
             }
 
             // ARM32的函数调用约定，前四个参数通过寄存器传递
@@ -310,13 +315,13 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
 
                 auto arg = callInst->getOperand(k);
 
-                Instruction * assignInst = new MoveInstruction(func, PlatformArm32::intRegVal[k], arg);
+                Instruction * assignInst =
+                    new (func->getArena()) MoveInstruction(func, PlatformArm32::intRegVal[k], arg);
 
                 callInst->setOperand(k, PlatformArm32::intRegVal[k]);
 
                 // 函数调用指令前插入后，pIter仍指向函数调用指令
-                pIter = insts.insert(pIter, assignInst);
-                pIter++;
+                insts.insertBefore(callInst, assignInst);
             }
 
 #if 0
@@ -325,8 +330,7 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
                 auto arg = callInst->getOperand(k);
 
                 // 产生ARG指令
-                pIter = insts.insert(pIter, new ArgInstruction(func, arg));
-                pIter++;
+                insts.insertBefore(callInst, new (func->getArena()) ArgInstruction(func, arg));
             }
 #endif
 
@@ -342,10 +346,11 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
                 } else {
                     // 其它情况，需要产生赋值指令
                     // 新建一个赋值操作
-                    Instruction * assignInst = new MoveInstruction(func, callInst, PlatformArm32::intRegVal[0]);
+                    Instruction * assignInst =
+                        new (func->getArena()) MoveInstruction(func, callInst, PlatformArm32::intRegVal[0]);
 
-                    // 函数调用指令的下一个指令的前面插入指令，因为有Exit指令，+1肯定有效
-                    pIter = insts.insert(pIter + 1, assignInst);
+                    // 函数调用指令的后面插入指令，循环接下来会经过该赋值指令，它不是函数调用不受影响
+                    insts.insertAfter(callInst, assignInst);
                 }
             }
         }
@@ -409,7 +414,7 @@ void CodeGeneratorArm32::stackAlloc(Function * func)
     }
 
     // 遍历包含有值的指令，也就是临时变量
-    for (auto inst: func->getInterCode().getInsts()) {
+    for (auto inst: func->getInterCode()) {
 
         if (inst->hasResultValue() && (inst->getRegId() == -1)) {
             // 有值，并且没有分配寄存器
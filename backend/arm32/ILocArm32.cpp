@@ -2,7 +2,7 @@
 /// @file ILocArm32.cpp
 /// @brief 指令序列管理的实现，ILOC的全称为Intermediate Language for Optimizing Compilers
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.1
 /// @date 2024-11-21
 ///
 /// @copyright Copyright (c) 2024
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>没有栈帧的函数也设置FP，出口用FP恢复SP时不会破坏栈
 /// </table>
 ///
 #include <cstdio>
@@ -359,7 +360,7 @@ void ILocArm32::mov_reg(int rs_reg_no, int src_reg_no)
 void ILocArm32::load_var(int rs_reg_no, Value * src_var)
 {
 
-    if (Instanceof(constVal, ConstInt *, src_var)) {
+    if (auto constVal = dyn_cast<ConstInt>(src_var)) {
         // 整型常量
 
         // TODO 目前只考虑整数类型 100
@@ -375,7 +376,7 @@ void ILocArm32::load_var(int rs_reg_no, Value * src_var)
             // mov r8,r2 | 这里有优化空间——消除r8
             emit("mov", PlatformArm32::regName[rs_reg_no], PlatformArm32::regName[src_regId]);
         }
-    } else if (Instanceof(globalVar, GlobalVariable *, src_var)) {
+    } else if (auto globalVar = dyn_cast<GlobalVariable>(src_var)) {
         // 全局变量
 
         // 读取全局变量的地址
@@ -452,7 +453,7 @@ void ILocArm32::store_var(int src_reg_no, Value * dest_var, int tmp_reg_no)
             emit("mov", PlatformArm32::regName[dest_reg_id], PlatformArm32::regName[src_reg_no]);
         }
 
-    } else if (Instanceof(globalVar, GlobalVariable *, dest_var)) {
+    } else if (auto globalVar = dyn_cast<GlobalVariable>(dest_var)) {
         // 全局变量
 
         // 读取符号的地址到寄存器r10
@@ -511,14 +512,15 @@ void ILocArm32::allocStack(Function * func, int tmp_reg_no)
     // 计算栈帧大小
     int off = func->getMaxDep();
 
-    // 不需要在栈内额外分配空间，则什么都不做
+    // 保存SP寄存器到FP寄存器中。FP总是被保护，出口总是用FP恢复SP，栈传递的形参也通过FP访问，
+    // 因此没有局部变量的函数也要设置FP
+    mov_reg(ARM32_FP_REG_NO, ARM32_SP_REG_NO);
+
+    // 不需要在栈内额外分配空间
     if (0 == off) {
         return;
     }
 
-    // 保存SP寄存器到FP寄存器中
-    mov_reg(ARM32_FP_REG_NO, ARM32_SP_REG_NO);
-
     if (PlatformArm32::constExpr(off)) {
         // sub sp,sp,#16
         emit("sub", "sp", "sp", toStr(off));
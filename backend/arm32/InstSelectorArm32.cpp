@@ -2,7 +2,7 @@
 /// @file InstSelectorArm32.cpp
 /// @brief 指令选择器-ARM32的实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.1
 /// @date 2024-11-21
 ///
 /// @copyright Copyright (c) 2024
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>处理函数清单改为按操作码索引的编译期数组，用cast代替dynamic_cast
 /// </table>
 ///
 #include <cstdio>
@@ -33,29 +34,37 @@
 /// @param _irCode 指令
 /// @param _iloc ILoc
 /// @param _func 函数
-InstSelectorArm32::InstSelectorArm32(vector<Instruction *> & _irCode,
+InstSelectorArm32::InstSelectorArm32(InterCode & _irCode,
                                      ILocArm32 & _iloc,
                                      Function * _func,
                                      SimpleRegisterAllocator & allocator)
     : ir(_irCode), iloc(_iloc), func(_func), simpleRegisterAllocator(allocator)
-{
-    translator_handlers[IRInstOperator::IRINST_OP_ENTRY] = &InstSelectorArm32::translate_entry;
-    translator_handlers[IRInstOperator::IRINST_OP_EXIT] = &InstSelectorArm32::translate_exit;
+{}
 
-    translator_handlers[IRInstOperator::IRINST_OP_LABEL] = &InstSelectorArm32::translate_label;
-    translator_handlers[IRInstOperator::IRINST_OP_GOTO] = &InstSelectorArm32::translate_goto;
+/// @brief IR动作处理函数清单，按操作码直接索引，编译期生成
+constexpr std::array<InstSelectorArm32::translate_handler, (size_t) IRInstOperator::IRINST_OP_MAX>
+    InstSelectorArm32::translator_handlers = [] {
+        std::array<translate_handler, (size_t) IRInstOperator::IRINST_OP_MAX> handlers{};
 
-    translator_handlers[IRInstOperator::IRINST_OP_ASSIGN] = &InstSelectorArm32::translate_assign;
+        handlers[(size_t) IRInstOperator::IRINST_OP_ENTRY] = &InstSelectorArm32::translate_entry;
+        handlers[(size_t) IRInstOperator::IRINST_OP_EXIT] = &InstSelectorArm32::translate_exit;
 
-    translator_handlers[IRInstOperator::IRINST_OP_ADD_I] = &InstSelectorArm32::translate_add_int32;
-    translator_handlers[IRInstOperator::IRINST_OP_SUB_I] = &InstSelectorArm32::translate_sub_int32;
-    translator_handlers[IRInstOperator::IRINST_OP_MUL_I] = &InstSelectorArm32::translate_mul_int32;
-    translator_handlers[IRInstOperator::IRINST_OP_DIV_I] = &InstSelectorArm32::translate_div_int32;
-    translator_handlers[IRInstOperator::IRINST_OP_MOD_I] = &InstSelectorArm32::translate_mod_int32;
+        handlers[(size_t) IRInstOperator::IRINST_OP_LABEL] = &InstSelectorArm32::translate_label;
+        handlers[(size_t) IRInstOperator::IRINST_OP_GOTO] = &InstSelectorArm32::translate_goto;
 
-    translator_handlers[IRInstOperator::IRINST_OP_FUNC_CALL] = &InstSelectorArm32::translate_call;
-    translator_handlers[IRInstOperator::IRINST_OP_ARG] = &InstSelectorArm32::translate_arg;
-}
+        handlers[(size_t) IRInstOperator::IRINST_OP_ASSIGN] = &InstSelectorArm32::translate_assign;
+
+        handlers[(size_t) IRInstOperator::IRINST_OP_ADD_I] = &InstSelectorArm32::translate_add_int32;
+        handlers[(size_t) IRInstOperator::IRINST_OP_SUB_I] = &InstSelectorArm32::translate_sub_int32;
+        handlers[(size_t) IRInstOperator::IRINST_OP_MUL_I] = &InstSelectorArm32::translate_mul_int32;
+        handlers[(size_t) IRInstOperator::IRINST_OP_DIV_I] = &InstSelectorArm32::translate_div_int32;
+        handlers[(size_t) IRInstOperator::IRINST_OP_MOD_I] = &InstSelectorArm32::translate_mod_int32;
+
+        handlers[(size_t) IRInstOperator::IRINST_OP_FUNC_CALL] = &InstSelectorArm32::translate_call;
+        handlers[(size_t) IRInstOperator::IRINST_OP_ARG] = &InstSelectorArm32::translate_arg;
+
+        return handlers;
+    }();
 
 ///
 /// @brief 析构函数
@@ -82,11 +91,14 @@ void InstSelectorArm32::translate(Instruction * inst)
     // 操作符
     IRInstOperator op = inst->getOp();
 
-    map<IRInstOperator, translate_handler>::const_iterator pIter;
-    pIter = translator_handlers.find(op);
-    if (pIter == translator_handlers.end()) {
+    translate_handler handler = nullptr;
+    if ((size_t) op < translator_handlers.size()) {
+        handler = translator_handlers[(size_t) op];
+    }
+
+    if (handler == nullptr) {
         // 没有找到，则说明当前不支持
-        printf("Translate: Operator(%d) not support", (int) op);
+        minic_diag("Translate: Operator(%d) not support\n", (int) op);
         return;
     }
 
@@ -95,7 +107,7 @@ void InstSelectorArm32::translate(Instruction * inst)
         outputIRInstruction(inst);
     }
 
-    (this->*(pIter->second))(inst);
+    (this->*handler)(inst);
 }
 
 ///
@@ -122,7 +134,7 @@ void InstSelectorArm32::translate_nop(Instruction * inst)
 /// @param inst IR指令
 void InstSelectorArm32::translate_label(Instruction * inst)
 {
-    Instanceof(labelInst, LabelInstruction *, inst);
+    LabelInstruction * labelInst = cast<LabelInstruction>(inst);
 
     iloc.label(labelInst->getName());
 }
@@ -131,7 +143,7 @@ void InstSelectorArm32::translate_label(Instruction * inst)
 /// @param inst IR指令
 void InstSelectorArm32::translate_goto(Instruction * inst)
 {
-    Instanceof(gotoInst, GotoInstruction *, inst);
+    GotoInstruction * gotoInst = cast<GotoInstruction>(inst);
 
     // 无条件跳转
     iloc.jump(gotoInst->getTarget()->getName());
@@ -400,7 +412,7 @@ void InstSelectorArm32::translate_mod_int32(Instruction * inst)
 /// @param inst IR指令
 void InstSelectorArm32::translate_call(Instruction * inst)
 {
-    FuncCallInstruction * callInst = dynamic_cast<FuncCallInstruction *>(inst);
+    FuncCallInstruction * callInst = cast<FuncCallInstruction>(inst);
 
     int32_t operandNum = callInst->getOperandsNum();
 
@@ -432,7 +444,7 @@ void InstSelectorArm32::translate_call(Instruction * inst)
             newVal->setMemoryAddr(ARM32_SP_REG_NO, esp);
             esp += 4;
 
-            Instruction * assignInst = new MoveInstruction(func, newVal, arg);
+            Instruction * assignInst = new (func->getArena()) MoveInstruction(func, newVal, arg);
 
             // 翻译赋值指令
             translate_assign(assignInst);
@@ -448,7 +460,7 @@ void InstSelectorArm32::translate_call(Instruction * inst)
             // 如果是临时变量，该变量可更改为寄存器变量即可，或者设置寄存器号
             // 如果不是，则必须开辟一个寄存器变量，然后赋值即可
 
-            Instruction * assignInst = new MoveInstruction(func, PlatformArm32::intRegVal[k], arg);
+            Instruction * assignInst = new (func->getArena()) MoveInstruction(func, PlatformArm32::intRegVal[k], arg);
 
             // 翻译赋值指令
             translate_assign(assignInst);
@@ -470,7 +482,7 @@ void InstSelectorArm32::translate_call(Instruction * inst)
     if (callInst->hasResultValue()) {
 
         // 新建一个赋值操作
-        Instruction * assignInst = new MoveInstruction(func, callInst, PlatformArm32::intRegVal[0]);
+        Instruction * assignInst = new (func->getArena()) MoveInstruction(func, callInst, PlatformArm32::intRegVal[0]);
 
         // 翻译赋值指令
         translate_assign(assignInst);
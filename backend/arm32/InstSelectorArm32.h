@@ -2,7 +2,7 @@
 /// @file InstSelectorArm32.h
 /// @brief 指令选择器-ARM32
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.1
 /// @date 2024-11-21
 ///
 /// @copyright Copyright (c) 2024
@@ -11,15 +11,17 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>处理函数清单改为按操作码索引的编译期数组
 /// </table>
 ///
 #pragma once
 
-#include <map>
+#include <array>
 #include <vector>
 
 #include "Function.h"
 #include "ILocArm32.h"
+#include "IRCode.h"
 #include "Instruction.h"
 #include "PlatformArm32.h"
 #include "SimpleRegisterAllocator.h"
@@ -31,7 +33,7 @@ using namespace std;
 class InstSelectorArm32 {
 
     /// @brief 所有的IR指令
-    std::vector<Instruction *> & ir;
+    InterCode & ir;
 
     /// @brief 指令变换
     ILocArm32 & iloc;
@@ -111,8 +113,8 @@ protected:
     /// @brief IR翻译动作函数原型
     typedef void (InstSelectorArm32::*translate_handler)(Instruction *);
 
-    /// @brief IR动作处理函数清单
-    map<IRInstOperator, translate_handler> translator_handlers;
+    /// @brief IR动作处理函数清单，按操作码直接索引，编译期生成，不支持的操作码为nullptr
+    static const std::array<translate_handler, (size_t) IRInstOperator::IRINST_OP_MAX> translator_handlers;
 
     ///
     /// @brief 简单的朴素寄存器分配方法
@@ -137,7 +139,7 @@ public:
     /// @param _irCode IR指令
     /// @param _func 函数
     /// @param _iloc 后端指令
-    InstSelectorArm32(std::vector<Instruction *> & _irCode,
+    InstSelectorArm32(InterCode & _irCode,
                       ILocArm32 & _iloc,
                       Function * _func,
                       SimpleRegisterAllocator & allocator);
@@ -37,23 +37,26 @@ const std::string PlatformArm32::regName[PlatformArm32::maxRegNum] = {
     "pc", // r15，程序计数器。PC 存储着下一条将要执行的指令的地址。在执行分支指令时，PC会更新为新的地址。
 };
 
+/// @brief 寄存器Value的内存池，寄存器Value在进程内一直有效，不释放
+static Arena regArena{4 * 1024};
+
 RegVariable * PlatformArm32::intRegVal[PlatformArm32::maxRegNum] = {
-    new RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[0], 0),
-    new RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[1], 1),
-    new RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[2], 2),
-    new RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[3], 3),
-    new RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[4], 4),
-    new RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[5], 5),
-    new RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[6], 6),
-    new RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[7], 7),
-    new RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[8], 8),
-    new RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[9], 9),
-    new RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[10], 10),
-    new RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[11], 11),
-    new RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[12], 12),
-    new RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[13], 13),
-    new RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[14], 14),
-    new RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[15], 15),
+    new (regArena) RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[0], 0),
+    new (regArena) RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[1], 1),
+    new (regArena) RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[2], 2),
+    new (regArena) RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[3], 3),
+    new (regArena) RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[4], 4),
+    new (regArena) RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[5], 5),
+    new (regArena) RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[6], 6),
+    new (regArena) RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[7], 7),
+    new (regArena) RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[8], 8),
+    new (regArena) RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[9], 9),
+    new (regArena) RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[10], 10),
+    new (regArena) RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[11], 11),
+    new (regArena) RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[12], 12),
+    new (regArena) RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[13], 13),
+    new (regArena) RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[14], 14),
+    new (regArena) RegVariable(IntegerType::getTypeInt(), PlatformArm32::regName[15], 15),
 };
 
 /// @brief 循环左移两位
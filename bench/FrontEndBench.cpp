@@ -0,0 +1,554 @@
+///
+/// @file FrontEndBench.cpp
+/// @brief 前端吞吐量测试程序，比较flex+bison、ANTLR4与递归下降三种前端
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+/// 按指定的规模与形状生成MiniC源文件，依次用三种前端执行器分析，
+/// 输出每种前端的Token吞吐量、AST节点吞吐量与内存峰值，并检查三种前端产生的AST结构是否一致。
+/// 生成的源程序只使用三种前端都支持的文法子集（int类型、无参函数、加减运算、语句块嵌套与函数调用）。
+///
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <getopt.h>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#include "AST.h"
+#include "Antlr4Executor.h"
+#include "FlexBisonExecutor.h"
+#include "FrontEndExecutor.h"
+#include "RecursiveDescentExecutor.h"
+#include "RecursiveDescentFlex.h"
+#include "RecursiveDescentParser.h"
+#include "SourceBuffer.h"
+#include "StringInterner.h"
+
+///
+/// @brief 生成源程序的规模与形状
+///
+struct SourceShape {
+    /// @brief 全局变量个数
+    int globals = 16;
+
+    /// @brief 函数个数
+    int functions = 100;
+
+    /// @brief 每个语句块中的语句条数
+    int statements = 20;
+
+    /// @brief 表达式中的操作数个数，越大表达式越长
+    int exprLength = 4;
+
+    /// @brief 语句块的嵌套层数
+    int nesting = 2;
+
+    /// @brief 随机数种子
+    unsigned seed = 1;
+};
+
+///
+/// @brief 一种前端的测试结果
+///
+struct FrontEndResult {
+    /// @brief 前端名称
+    std::string name;
+
+    /// @brief 是否分析成功
+    bool ok = false;
+
+    /// @brief 多次运行中最短的耗时，单位秒
+    double seconds = 0;
+
+    /// @brief AST节点个数
+    uint32_t nodes = 0;
+
+    /// @brief 内存峰值，单位KB
+    long peakKB = 0;
+
+    /// @brief AST结构的先根序列化结果，用于比较
+    std::string fingerprint;
+};
+
+/// @brief 生成的源文件路径
+static std::string gSourceFile;
+
+/// @brief 每种前端重复运行的次数，取最短耗时
+static int gRepeat = 3;
+
+/// @brief 是否保留生成的源文件
+static bool gKeepSource = false;
+
+static struct option long_options[] = {
+    {"help", no_argument, 0, 'h'},
+    {"globals", required_argument, 0, 'g'},
+    {"functions", required_argument, 0, 'f'},
+    {"statements", required_argument, 0, 's'},
+    {"expr-length", required_argument, 0, 'e'},
+    {"nesting", required_argument, 0, 'n'},
+    {"seed", required_argument, 0, 'r'},
+    {"repeat", required_argument, 0, 'k'},
+    {"output", required_argument, 0, 'o'},
+    {0, 0, 0, 0}
+};
+
+/// @brief 显示帮助
+/// @param exeName
+static void showHelp(const std::string & exeName)
+{
+    std::cout << exeName + " [options]\n";
+    std::cout << "Options:\n";
+    std::cout << "  -h, --help                 Show this help message\n";
+    std::cout << "  -g, --globals=N            Number of global variables (default 16)\n";
+    std::cout << "  -f, --functions=N          Number of functions (default 100)\n";
+    std::cout << "  -s, --statements=N         Statements per block (default 20)\n";
+    std::cout << "  -e, --expr-length=N        Operands per expression (default 4)\n";
+    std::cout << "  -n, --nesting=N            Nesting depth of blocks (default 2)\n";
+    std::cout << "  -r, --seed=N               Random seed (default 1)\n";
+    std::cout << "  -k, --repeat=N             Runs per front end, the fastest is reported (default 3)\n";
+    std::cout << "  -o, --output=FILE          Write the generated source to FILE and keep it\n";
+}
+
+///
+/// @brief 参数解析
+/// @param argc
+/// @param argv
+/// @param shape 生成源程序的规模与形状
+/// @return 0: 成功 1: 显示帮助 -1: 错误
+///
+static int ArgsAnalysis(int argc, char * argv[], SourceShape & shape)
+{
+    int ch;
+    int option_index = 0;
+
+    const char options[] = "hg:f:s:e:n:r:k:o:";
+
+    while ((ch = getopt_long(argc, argv, options, long_options, &option_index)) != -1) {
+        switch (ch) {
+            case 'h':
+                return 1;
+            case 'g':
+                shape.globals = std::stoi(optarg);
+                break;
+            case 'f':
+                shape.functions = std::stoi(optarg);
+                break;
+            case 's':
+                shape.statements = std::stoi(optarg);
+                break;
+            case 'e':
+                shape.exprLength = std::stoi(optarg);
+                break;
+            case 'n':
+                shape.nesting = std::stoi(optarg);
+                break;
+            case 'r':
+                shape.seed = (unsigned) std::stoul(optarg);
+                break;
+            case 'k':
+                gRepeat = std::stoi(optarg);
+                break;
+            case 'o':
+                gSourceFile = optarg;
+                gKeepSource = true;
+                break;
+            default:
+                return -1;
+        }
+    }
+
+    if ((shape.globals < 1) || (shape.functions < 1) || (shape.statements < 1) || (shape.exprLength < 1) ||
+        (shape.nesting < 0) || (gRepeat < 1)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+///
+/// @brief MiniC源程序生成器
+///
+class SourceGenerator {
+
+public:
+    /// @brief 构造函数
+    /// @param _shape 规模与形状
+    explicit SourceGenerator(const SourceShape & _shape) : shape(_shape), rng(_shape.seed)
+    {}
+
+    ///
+    /// @brief 生成源程序
+    /// @return std::string 源程序文本
+    ///
+    std::string generate()
+    {
+        out.str("");
+
+        out << "int ";
+        for (int k = 0; k < shape.globals; ++k) {
+            out << (k ? ", " : "") << "g" << k;
+        }
+        out << ";\n";
+
+        for (int k = 0; k < shape.functions; ++k) {
+            genFunction(k);
+        }
+
+        return out.str();
+    }
+
+private:
+    ///
+    /// @brief 生成函数，函数只调用定义在前面的函数
+    /// @param index 函数序号
+    ///
+    void genFunction(int index)
+    {
+        out << "int f" << index << "()\n{\n";
+
+        genBlockBody(index, 0, 1);
+
+        out << "}\n";
+    }
+
+    ///
+    /// @brief 生成语句块的内容
+    /// @param func 所在函数的序号
+    /// @param level 嵌套层级，函数体为0
+    /// @param indent 缩进层级
+    ///
+    void genBlockBody(int func, int level, int indent)
+    {
+        std::string pad(indent * 4, ' ');
+
+        // 每一层定义自己的局部变量，内层可以访问外层的变量
+        out << pad << "int l" << level << "a, l" << level << "b, l" << level << "c;\n";
+
+        for (int k = 0; k < shape.statements; ++k) {
+
+            if ((level < shape.nesting) && (k % 8 == 7)) {
+                // 嵌套的语句块
+                out << pad << "{\n";
+                genBlockBody(func, level + 1, indent + 1);
+                out << pad << "}\n";
+                continue;
+            }
+
+            out << pad << randomVar(level) << " = ";
+
+            if ((func > 0) && (k % 5 == 4)) {
+                // 调用前面定义的函数
+                out << "f" << pick(func) << "()";
+            } else {
+                genExpr(level);
+            }
+
+            out << ";\n";
+        }
+
+        if (level == 0) {
+            out << pad << "return ";
+            genExpr(level);
+            out << ";\n";
+        }
+    }
+
+    ///
+    /// @brief 生成加减运算的表达式
+    /// @param level 所在语句块的嵌套层级
+    ///
+    void genExpr(int level)
+    {
+        for (int k = 0; k < shape.exprLength; ++k) {
+
+            if (k) {
+                out << ((rng() & 1) ? " + " : " - ");
+            }
+
+            if (rng() % 3 == 0) {
+                out << rng() % 100000;
+            } else {
+                out << randomVar(level);
+            }
+        }
+    }
+
+    ///
+    /// @brief 随机选择一个当前语句块可见的变量
+    /// @param level 所在语句块的嵌套层级
+    /// @return std::string 变量名
+    ///
+    std::string randomVar(int level)
+    {
+        if (rng() % 4 == 0) {
+            return "g" + std::to_string(pick(shape.globals));
+        }
+
+        static const char suffix[] = {'a', 'b', 'c'};
+
+        return "l" + std::to_string(pick(level + 1)) + suffix[pick(3)];
+    }
+
+    ///
+    /// @brief 生成[0, n)范围内的随机数
+    /// @param n 上界
+    /// @return int
+    ///
+    int pick(int n)
+    {
+        return (int) (rng() % (unsigned) n);
+    }
+
+    /// @brief 规模与形状
+    SourceShape shape;
+
+    /// @brief 随机数发生器，同一种子生成同一程序
+    std::mt19937 rng;
+
+    /// @brief 输出的源程序
+    std::ostringstream out;
+};
+
+///
+/// @brief 复位内存峰值，Linux下通过/proc/self/clear_refs实现，其它平台不支持时峰值为整个进程的峰值
+///
+static void resetPeakRSS()
+{
+#ifdef __linux__
+    FILE * fp = fopen("/proc/self/clear_refs", "w");
+    if (fp) {
+        fputs("5", fp);
+        fclose(fp);
+    }
+#endif
+}
+
+///
+/// @brief 获取内存峰值
+/// @return long 内存峰值，单位KB
+///
+static long peakRSS()
+{
+#ifdef __linux__
+    FILE * fp = fopen("/proc/self/status", "r");
+    if (fp) {
+        char line[256];
+        long kb = 0;
+        while (fgets(line, sizeof(line), fp)) {
+            if (sscanf(line, "VmHWM: %ld", &kb) == 1) {
+                break;
+            }
+        }
+        fclose(fp);
+        return kb;
+    }
+#endif
+
+#ifndef _WIN32
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+///
+/// @brief 用递归下降的词法分析统计Token个数，三种前端的词法相同，Token个数也相同
+/// @param filename 源文件
+/// @return uint64_t Token个数，失败返回0
+///
+static uint64_t countTokens(const std::string & filename)
+{
+    SourceBuffer source;
+    if (!source.open(filename)) {
+        return 0;
+    }
+
+    RDFlexContext ctx;
+    rd_flex_init(ctx, source.data(), source.size());
+
+    RDSType lval;
+
+    uint64_t count = 0;
+    for (;;) {
+        int token = rd_flex(ctx, lval);
+        if ((token == RDTokenType::T_EOF) || (token == RDTokenType::T_ERR)) {
+            break;
+        }
+        count++;
+    }
+
+    return count;
+}
+
+///
+/// @brief 测试一种前端
+/// @param name 前端名称
+/// @param newExecutor 创建前端执行器的函数
+/// @return FrontEndResult 测试结果
+///
+static FrontEndResult benchFrontEnd(const std::string & name,
+                                    const std::function<FrontEndExecutor *(const std::string &)> & newExecutor)
+{
+    FrontEndResult result;
+    result.name = name;
+
+    for (int k = 0; k < gRepeat; ++k) {
+
+        resetPeakRSS();
+
+        std::unique_ptr<FrontEndExecutor> executor(newExecutor(gSourceFile));
+
+        auto start = std::chrono::steady_clock::now();
+        bool ok = executor->run();
+        auto stop = std::chrono::steady_clock::now();
+
+        ast_node * root = executor->getASTRoot();
+        if (!ok || !root) {
+            free_ast(root);
+            result.ok = false;
+            return result;
+        }
+
+        double seconds = std::chrono::duration<double>(stop - start).count();
+        if ((k == 0) || (seconds < result.seconds)) {
+            result.seconds = seconds;
+        }
+
+        long peak = peakRSS();
+        if (peak > result.peakKB) {
+            result.peakKB = peak;
+        }
+
+        if (k == 0) {
+            result.nodes = ast_context->getNodeCount();
+            result.fingerprint = ast_fingerprint(root);
+        }
+
+        free_ast(root);
+    }
+
+    result.ok = true;
+
+    return result;
+}
+
+///
+/// @brief 主程序
+/// @param argc
+/// @param argv
+/// @return int 0: 成功，三种前端的AST一致 1: 失败或AST不一致
+///
+int main(int argc, char * argv[])
+{
+    SourceShape shape;
+
+    int argResult = ArgsAnalysis(argc, argv, shape);
+    if (argResult != 0) {
+        showHelp(argv[0]);
+        return argResult > 0 ? 0 : 1;
+    }
+
+    if (!gKeepSource) {
+#ifndef _WIN32
+        gSourceFile = "/tmp/minic-frontend-bench-" + std::to_string(getpid()) + ".c";
+#else
+        gSourceFile = "minic-frontend-bench.c";
+#endif
+    }
+
+    SourceGenerator generator(shape);
+    std::string text = generator.generate();
+
+    {
+        std::ofstream ofs(gSourceFile, std::ios::binary);
+        if (!ofs) {
+            std::cerr << "cannot write " << gSourceFile << "\n";
+            return 1;
+        }
+        ofs << text;
+    }
+
+    uint64_t tokens = countTokens(gSourceFile);
+
+    printf("source: %s, %zu bytes, %llu tokens\n", gSourceFile.c_str(), text.size(), (unsigned long long) tokens);
+
+    std::vector<FrontEndResult> results;
+
+    results.push_back(benchFrontEnd("flex+bison", [](const std::string & f) { return new FlexBisonExecutor(f); }));
+    results.push_back(benchFrontEnd("antlr4", [](const std::string & f) { return new Antlr4Executor(f); }));
+    results.push_back(benchFrontEnd("recursive-descent",
+                                    [](const std::string & f) { return new RecursiveDescentExecutor(f); }));
+
+    printf("%-18s %10s %14s %10s %14s %10s\n", "front end", "time(ms)", "tokens/s", "AST nodes", "nodes/s", "peak(KB)");
+
+    for (auto & r: results) {
+        if (!r.ok) {
+            printf("%-18s %10s\n", r.name.c_str(), "failed");
+            continue;
+        }
+
+        printf("%-18s %10.2f %14.0f %10u %14.0f %10ld\n",
+               r.name.c_str(),
+               r.seconds * 1000,
+               tokens / r.seconds,
+               r.nodes,
+               r.nodes / r.seconds,
+               r.peakKB);
+    }
+
+    // 检查各个前端产生的AST结构是否一致
+    bool same = true;
+    const FrontEndResult * reference = nullptr;
+    for (auto & r: results) {
+        if (!r.ok) {
+            printf("AST check: %s failed to parse the source\n", r.name.c_str());
+            same = false;
+            continue;
+        }
+
+        if (!reference) {
+            reference = &r;
+        } else if (r.fingerprint != reference->fingerprint) {
+            printf("AST mismatch: %s differs from %s\n", r.name.c_str(), reference->name.c_str());
+            same = false;
+        }
+    }
+
+    if (same) {
+        printf("AST check: all front ends produced identical ASTs\n");
+    }
+
+    if (!gKeepSource) {
+        std::remove(gSourceFile.c_str());
+    }
+
+    return same ? 0 : 1;
+}
@@ -2,8 +2,8 @@
 /// @file AST.cpp
 /// @brief 抽象语法树AST管理的实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.4
+/// @date 2026-10-15
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,8 +12,12 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>紧凑的节点布局，冷数据与孩子数组分离
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>增加AST的结构指纹，用于编译缓存
+/// <tr><td>2026-10-15 <td>1.4     <td>zenglj  <td>AST存储按线程区分，去掉全局根节点，可多线程同时编译
 /// </table>
 ///
+#include <algorithm>
 #include <cstdarg>
 #include <cstdint>
 #include <string>
@@ -23,14 +27,115 @@
 #include "Types/IntegerType.h"
 #include "Types/VoidType.h"
 
-/* 整个AST的根节点 */
-ast_node * ast_root = nullptr;
+/* 每个线程默认的AST存储 */
+static thread_local ASTContext threadASTContext;
+
+/* 当前线程的AST存储 */
+thread_local ASTContext * ast_context = &threadASTContext;
+
+/* 流式编译时顶层定义的处理函数 */
+thread_local std::function<void(ast_node *)> ast_unit_item_handler;
+
+///
+/// @brief 分配节点编号，同时为冷数据表增加一项
+/// @param lineNo 行号
+/// @return uint32_t 节点编号
+///
+uint32_t ASTContext::newNodeId(int64_t lineNo)
+{
+    uint32_t id = (uint32_t) lineNos.size();
+
+    lineNos.push_back((int32_t) lineNo);
+    names.push_back(EmptySymbol);
+    sonCapacities.push_back(0);
+
+    return id;
+}
+
+///
+/// @brief 按先根次序重排共享孩子数组，去掉构造过程中留下的空洞
+/// @param root AST的根
+///
+void ASTContext::compact(ast_node * root)
+{
+    if (!root) {
+        return;
+    }
+
+    std::vector<ast_node *> newSons;
+    newSons.reserve(sons.size());
+
+    // 显式栈，避免深层嵌套的表达式导致递归过深
+    std::vector<ast_node *> stack;
+    stack.push_back(root);
+
+    while (!stack.empty()) {
+
+        ast_node * node = stack.back();
+        stack.pop_back();
+
+        if (node->sonCount == 0) {
+            continue;
+        }
+
+        uint32_t oldBegin = node->sonBegin;
+
+        node->sonBegin = (uint32_t) newSons.size();
+        newSons.insert(newSons.end(), sons.begin() + oldBegin, sons.begin() + oldBegin + node->sonCount);
+        sonCapacities[node->id] = node->sonCount;
+
+        // 逆序入栈，保证先处理左边的孩子
+        for (uint32_t k = node->sonCount; k > 0; --k) {
+            stack.push_back(newSons[node->sonBegin + k - 1]);
+        }
+    }
+
+    sons.swap(newSons);
+}
+
+///
+/// @brief 回退到之前获取的分配位置，其后创建的节点全部失效
+/// @param m 分配位置
+///
+void ASTContext::rewind(const Mark & m)
+{
+    arena.rewind(m.arenaMark);
+
+    sons.resize(m.sonCount);
+    sonCapacities.resize(m.nodeCount);
+    names.resize(m.nodeCount);
+    lineNos.resize(m.nodeCount);
+
+    for (auto pIter = floatVals.begin(); pIter != floatVals.end();) {
+        if (pIter->first >= m.nodeCount) {
+            pIter = floatVals.erase(pIter);
+        } else {
+            ++pIter;
+        }
+    }
+}
+
+///
+/// @brief 释放全部节点与冷数据
+///
+void ASTContext::release()
+{
+    arena.release();
+
+    std::vector<ast_node *>().swap(sons);
+    std::vector<uint32_t>().swap(sonCapacities);
+    std::vector<SymbolId>().swap(names);
+    std::vector<int32_t>().swap(lineNos);
+    floatVals.clear();
+
+    itemMark = Mark();
+}
 
 /// @brief 创建指定节点类型的节点
 /// @param _node_type 节点类型
 /// @param _line_no 行号
 ast_node::ast_node(ast_operator_type _node_type, Type * _type, int64_t _line_no)
-    : node_type(_node_type), line_no(-1), type(_type)
+    : node_type(_node_type), id(ast_context->newNodeId(_line_no)), type(_type)
 {}
 
 /// @brief 构造函数
@@ -51,7 +156,7 @@ ast_node::ast_node(digit_int_attr attr)
 /// @param attr 字符型字面量
 ast_node::ast_node(var_id_attr attr) : ast_node(ast_operator_type::AST_OP_LEAF_VAR_ID, VoidType::getType(), attr.lineno)
 {
-    name = attr.id;
+    setName(attr.id);
 }
 
 /// @brief 针对标识符ID的叶子构造函数
@@ -60,7 +165,22 @@ ast_node::ast_node(var_id_attr attr) : ast_node(ast_operator_type::AST_OP_LEAF_V
 ast_node::ast_node(std::string _id, int64_t _line_no)
     : ast_node(ast_operator_type::AST_OP_LEAF_VAR_ID, VoidType::getType(), _line_no)
 {
-    name = _id;
+    setName(internSymbol(_id));
+}
+
+/// @brief 获取float类型字面量值
+/// @return 字面量值
+float ast_node::getFloatVal() const
+{
+    auto pIter = ast_context->floatVals.find(id);
+    return pIter == ast_context->floatVals.end() ? 0.0f : pIter->second;
+}
+
+/// @brief 设置float类型字面量值
+/// @param val 字面量值
+void ast_node::setFloatVal(float val)
+{
+    ast_context->floatVals[id] = val;
 }
 
 /// @brief 判断是否是叶子节点
@@ -125,8 +245,28 @@ ast_node * ast_node::insert_son_node(ast_node * node)
     if (node) {
 
         // 孩子节点有效时加入，主要为了避免空语句等时会返回空指针
-        node->parent = this;
-        this->sons.push_back(node);
+        std::vector<ast_node *> & sons = ast_context->sons;
+        uint32_t & capacity = ast_context->sonCapacities[id];
+
+        if (sonCount == capacity) {
+
+            uint32_t newCapacity = capacity ? capacity * 2 : 2;
+
+            if ((sonCount > 0) && (sonBegin + capacity == sons.size())) {
+                // 预留空间正好在共享数组的末尾，原地扩充
+                sons.resize(sonBegin + newCapacity, nullptr);
+            } else {
+                // 搬到共享数组的末尾，原来的位置留下空洞，由compact统一清理
+                uint32_t newBegin = (uint32_t) sons.size();
+                sons.resize(newBegin + newCapacity, nullptr);
+                std::copy(sons.begin() + sonBegin, sons.begin() + sonBegin + sonCount, sons.begin() + newBegin);
+                sonBegin = newBegin;
+            }
+
+            capacity = newCapacity;
+        }
+
+        sons[sonBegin + sonCount++] = node;
     }
 
     return this;
@@ -171,30 +311,69 @@ ast_node * ast_node::New(Type * type)
     return node;
 }
 
-/// @brief 递归清理抽象语法树
+/// @brief 释放节点。节点由ast_context整体释放，这里不再递归释放
 /// @param node AST的节点
 void ast_node::Delete(ast_node * node)
 {
-    if (node) {
+    // 节点及孩子数组都在ast_context中，析构函数不执行，释放由free_ast统一完成
+    (void) node;
+}
 
-        for (auto child: node->sons) {
-            ast_node::Delete(child);
-        }
+///
+/// @brief AST资源清理，整体释放ast_context，所有AST节点都失效。
+/// 节点不持有堆内存，释放只需归还内存池的内存块与各个数据表
+///
+void free_ast(ast_node * root)
+{
+    (void) root;
 
-        // 这里没有必要清理孩子，由于下面就要删除该节点
-        // node->sons.clear();
-    }
+    ast_context->release();
+}
+
+///
+/// @brief 创建编译单元节点，并记录流式编译时的回退位置
+/// @return ast_node* 编译单元节点
+///
+ast_node * create_compile_unit()
+{
+    ast_node * node = create_contain_node(ast_operator_type::AST_OP_COMPILE_UNIT);
 
-    // 清理node资源
-    delete node;
+    // 编译单元节点之后创建的都是顶层定义的节点，流式编译时处理完一个释放一个
+    ast_context->itemMark = ast_context->mark();
+
+    return node;
 }
 
 ///
-/// @brief AST资源清理
+/// @brief 向编译单元追加顶层定义（函数定义或者变量声明语句）。
+/// 流式编译时顶层定义交给ast_unit_item_handler处理后即释放
+/// @param unit 编译单元节点，为空时创建
+/// @param item 顶层定义，可以为空
+/// @return ast_node* 编译单元节点
 ///
-void free_ast(ast_node * root)
+ast_node * add_compile_unit_item(ast_node * unit, ast_node * item)
 {
-    ast_node::Delete(root);
+    if (!ast_unit_item_handler) {
+
+        if (!unit) {
+            unit = create_compile_unit();
+        }
+
+        return unit->insert_son_node(item);
+    }
+
+    if (item) {
+
+        // 词法分析不创建节点，顶层定义的节点都在回退位置之后，处理后整体回退
+        ast_unit_item_handler(item);
+        ast_context->rewind(ast_context->itemMark);
+    }
+
+    if (!unit) {
+        unit = create_compile_unit();
+    }
+
+    return unit;
 }
 
 /// @brief 创建函数定义类型的内部AST节点
@@ -205,10 +384,10 @@ void free_ast(ast_node * root)
 /// @return 创建的节点
 ast_node * create_func_def(ast_node * type_node, ast_node * name_node, ast_node * block_node, ast_node * params_node)
 {
-    ast_node * node = new ast_node(ast_operator_type::AST_OP_FUNC_DEF, type_node->type, name_node->line_no);
+    ast_node * node = new ast_node(ast_operator_type::AST_OP_FUNC_DEF, type_node->type, name_node->getLineNo());
 
     // 设置函数名
-    node->name = name_node->name;
+    node->setName(name_node->getName());
 
     // 如果没有参数，则创建参数节点
     if (!params_node) {
@@ -240,11 +419,7 @@ ast_node * create_func_def(type_attr & type, var_id_attr & id, ast_node * block_
     ast_node * type_node = create_type_node(type);
 
     // 创建标识符终结符节点
-    ast_node * id_node = ast_node::New(id.id, id.lineno);
-
-    // 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-    free(id.id);
-    id.id = nullptr;
+    ast_node * id_node = ast_node::New(id);
 
     return create_func_def(type_node, id_node, block_node, params_node);
 }
@@ -307,7 +482,7 @@ ast_node * create_func_call(ast_node * funcname_node, ast_node * params_node)
     ast_node * node = new ast_node(ast_operator_type::AST_OP_FUNC_CALL);
 
     // 设置调用函数名
-    node->name = funcname_node->name;
+    node->setName(funcname_node->getName());
 
     // 如果没有参数，则创建参数节点
     if (!params_node) {
@@ -347,11 +522,7 @@ ast_node * createVarDeclNode(Type * type, var_id_attr & id)
     ast_node * type_node = ast_node::New(type);
 
     // 创建标识符终结符节点
-    ast_node * id_node = ast_node::New(id.id, id.lineno);
-
-    // 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-    free(id.id);
-    id.id = nullptr;
+    ast_node * id_node = ast_node::New(id);
 
     // 创建变量定义节点
     ast_node * decl_node = create_contain_node(ast_operator_type::AST_OP_VAR_DECL, type_node, id_node);
@@ -405,3 +576,45 @@ ast_node * add_var_decl_node(ast_node * stmt_node, var_id_attr & id)
 
     return stmt_node;
 }
+
+///
+/// @brief AST的结构指纹：先根次序下各节点的类型、值与孩子个数，不含行号。
+/// 只有空白、注释或行号不同的两段源代码指纹相同，可作为编译缓存的键
+/// @param root 子树的根节点
+/// @return std::string 指纹
+///
+std::string ast_fingerprint(ast_node * root)
+{
+    std::string result;
+
+    std::vector<ast_node *> stack{root};
+    while (!stack.empty()) {
+
+        ast_node * node = stack.back();
+        stack.pop_back();
+
+        result += std::to_string((int) node->node_type);
+        result += ':';
+
+        // 翻译时只使用类型节点上的类型，内部节点上的类型各前端设置不一，不计入指纹
+        if (node->node_type == ast_operator_type::AST_OP_LEAF_TYPE) {
+            result += node->type->toString();
+        } else if (node->node_type == ast_operator_type::AST_OP_LEAF_LITERAL_UINT) {
+            result += std::to_string(node->integer_val);
+        } else if (node->getName() != EmptySymbol) {
+            result += symbolName(node->getName());
+        }
+
+        result += ':';
+        result += std::to_string(node->sons().size());
+        result += '\n';
+
+        // 逆序压栈，保证先访问第一个孩子
+        auto sons = node->sons();
+        for (size_t k = sons.size(); k > 0; --k) {
+            stack.push_back(sons[k - 1]);
+        }
+    }
+
+    return result;
+}
@@ -2,8 +2,8 @@
 /// @file AST.h
 /// @brief 抽象语法树AST管理的头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.4
+/// @date 2026-10-15
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,24 +12,29 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>紧凑的节点布局，冷数据与孩子数组分离
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>增加AST的结构指纹，用于编译缓存
+/// <tr><td>2026-10-15 <td>1.4     <td>zenglj  <td>AST存储按线程区分，去掉全局根节点，可多线程同时编译
 /// </table>
 ///
 #pragma once
 
 #include <cstdint>
 #include <cstdio>
+#include <functional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "Arena.h"
 #include "AttrType.h"
-#include "IRCode.h"
-#include "Value.h"
+#include "Type.h"
 #include "VoidType.h"
 
 ///
 /// @brief AST节点的类型。C++专门因为枚举类来区分C语言的结构体
 ///
-enum class ast_operator_type : int {
+enum class ast_operator_type : std::uint8_t {
 
     /* 以下为AST的叶子节点 */
 
@@ -107,46 +112,186 @@ enum class ast_operator_type : int {
     AST_OP_MAX,
 };
 
+class ast_node;
+
 ///
-/// @brief 抽象语法树AST的节点描述类
+/// @brief AST节点孩子的视图，指向共享孩子数组中连续的一段。孩子数组在构造AST时可能扩容，视图不能跨越插入孩子的操作保存
 ///
-class ast_node {
+class ast_node_sons {
 public:
-    /// @brief 节点类型
-    ast_operator_type node_type;
+    /// @brief 构造函数
+    /// @param _first 第一个孩子在共享孩子数组中的地址
+    /// @param _count 孩子个数
+    ast_node_sons(ast_node * const * _first, uint32_t _count) : first(_first), count(_count)
+    {}
+
+    ast_node * const * begin() const
+    {
+        return first;
+    }
+
+    ast_node * const * end() const
+    {
+        return first + count;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    ast_node * operator[](size_t index) const
+    {
+        return first[index];
+    }
+
+private:
+    /// @brief 第一个孩子的地址
+    ast_node * const * first;
+
+    /// @brief 孩子个数
+    uint32_t count;
+};
 
-    /// @brief 行号信息，主要针对叶子节点有用
-    int64_t line_no;
+///
+/// @brief 一次编译的AST存储。节点在内存池中分配，孩子存放在共享的孩子数组中，
+/// 名字、行号、浮点数字面量等不常访问的冷数据存放在按节点编号索引的表中。整体一次释放。
+///
+class ASTContext {
 
-    /// @brief 节点值的类型，可用于函数返回值类型
-    Type * type;
+public:
+    ///
+    /// @brief 分配节点编号，同时为冷数据表增加一项
+    /// @param lineNo 行号
+    /// @return uint32_t 节点编号
+    ///
+    uint32_t newNodeId(int64_t lineNo);
 
-    /// @brief 无符号整数字面量值
-    uint32_t integer_val;
+    ///
+    /// @brief 节点个数，也就是下一个节点编号
+    /// @return uint32_t
+    ///
+    uint32_t getNodeCount() const
+    {
+        return (uint32_t) lineNos.size();
+    }
 
-    /// @brief float类型字面量值
-    float float_val;
+    ///
+    /// @brief 按先根次序重排共享孩子数组，去掉构造过程中留下的空洞，同一节点的孩子及其子树在数组中相邻
+    /// @param root AST的根
+    ///
+    void compact(ast_node * root);
 
-    /// @brief 变量名，或者函数名
-    std::string name;
+    ///
+    /// @brief 当前的分配位置，包括内存池、节点编号与孩子数组，用于回退
+    ///
+    struct Mark {
+        /// @brief 内存池的分配位置
+        Arena::Mark arenaMark;
+
+        /// @brief 节点个数
+        uint32_t nodeCount = 0;
+
+        /// @brief 共享孩子数组的大小
+        size_t sonCount = 0;
+    };
+
+    ///
+    /// @brief 获取当前的分配位置
+    /// @return Mark 分配位置
+    ///
+    Mark mark() const
+    {
+        return Mark{arena.mark(), getNodeCount(), sons.size()};
+    }
+
+    ///
+    /// @brief 回退到之前获取的分配位置，其后创建的节点全部失效
+    /// @param m 分配位置
+    ///
+    void rewind(const Mark & m);
+
+    ///
+    /// @brief 释放全部节点与冷数据
+    ///
+    void release();
 
-    /// @brief 父节点
-    ast_node * parent = nullptr;
+    /// @brief 节点的内存池
+    Arena arena;
 
-    /// @brief 孩子节点
+    /// @brief 共享孩子数组，每个节点的孩子占用其中连续的一段
     std::vector<ast_node *> sons;
 
-    /// @brief 线性IR指令块，可包含多条IR指令，用于线性IR指令产生用
-    InterCode blockInsts;
+    /// @brief 构造过程中每个节点在孩子数组中预留的空间大小，按节点编号索引
+    std::vector<uint32_t> sonCapacities;
+
+    /// @brief 变量名或函数名，按节点编号索引
+    std::vector<SymbolId> names;
+
+    /// @brief 行号，按节点编号索引
+    std::vector<int32_t> lineNos;
+
+    /// @brief 浮点数字面量值，很少出现，只保存浮点数字面量节点
+    std::unordered_map<uint32_t, float> floatVals;
 
-    /// @brief 线性IR指令或者运行产生的Value，用于线性IR指令产生用
-    Value * val = nullptr;
+    /// @brief 流式编译时编译单元节点创建后的分配位置，每个顶层定义处理完毕后回退到这里
+    Mark itemMark;
+};
+
+///
+/// @brief 当前线程的AST存储。每个线程默认有自己的存储，多个线程可同时编译不同的源文件；
+/// 工作线程遍历其它线程构造的AST前，需先指向构造该AST的线程的存储
+///
+extern thread_local ASTContext * ast_context;
+
+///
+/// @brief 抽象语法树AST的节点描述类。只保存遍历时常用的热数据，共24字节，
+/// 节点在ast_context的内存池中分配，不执行析构函数，由free_ast整体释放
+///
+class ast_node {
+public:
+    /// @brief 节点类型
+    ast_operator_type node_type;
 
     ///
     /// @brief 在进入block等节点时是否要进行作用域管理。默认要做。
     ///
     bool needScope = true;
 
+    /// @brief 节点编号，用于索引冷数据表
+    uint32_t id;
+
+    /// @brief 节点值的类型，可用于函数返回值类型
+    Type * type;
+
+    union {
+        /// @brief 内部节点：第一个孩子在共享孩子数组中的位置
+        uint32_t sonBegin = 0;
+
+        /// @brief 无符号整数字面量叶子节点：字面量值。叶子节点没有孩子，与sonBegin共用空间
+        uint32_t integer_val;
+    };
+
+    /// @brief 孩子个数
+    uint32_t sonCount = 0;
+
+    /// @brief 节点从ast_context的内存池中分配
+    /// @param size 字节数
+    /// @return 内存地址
+    static void * operator new(size_t size)
+    {
+        return ast_context->arena.allocate(size, alignof(ast_node));
+    }
+
+    /// @brief 节点内存由ast_context整体释放，这里不做事情
+    static void operator delete(void *)
+    {}
+
     /// @brief 创建指定节点类型的节点
     /// @param _node_type 节点类型
     ast_node(ast_operator_type _node_type, Type * _type = VoidType::getType(), int64_t _line_no = -1);
@@ -168,6 +313,42 @@ public:
     /// @param _line_no 行号
     ast_node(std::string id, int64_t _line_no);
 
+    /// @brief 获取孩子节点
+    /// @return 孩子的视图
+    ast_node_sons sons() const
+    {
+        return ast_node_sons(ast_context->sons.data() + (sonCount ? sonBegin : 0), sonCount);
+    }
+
+    /// @brief 获取变量名或者函数名
+    /// @return 名字的符号编号
+    SymbolId getName() const
+    {
+        return ast_context->names[id];
+    }
+
+    /// @brief 设置变量名或者函数名
+    /// @param name 名字的符号编号
+    void setName(SymbolId name)
+    {
+        ast_context->names[id] = name;
+    }
+
+    /// @brief 获取行号
+    /// @return 行号，-1表示没有行号
+    int64_t getLineNo() const
+    {
+        return ast_context->lineNos[id];
+    }
+
+    /// @brief 获取float类型字面量值
+    /// @return 字面量值
+    float getFloatVal() const;
+
+    /// @brief 设置float类型字面量值
+    /// @param val 字面量值
+    void setFloatVal(float val);
+
     /// @brief 判断是否是叶子节点
     /// @param type 节点类型
     /// @return true：是叶子节点 false：内部节点
@@ -206,17 +387,37 @@ public:
     static ast_node * New(Type * type);
 
     ///
-    /// @brief 释放节点
+    /// @brief 释放节点。节点由ast_context整体释放，这里不再递归释放
     /// @param node
     ///
     static void Delete(ast_node * node);
 };
 
-/// @brief AST资源清理
+static_assert(sizeof(ast_node) <= 24, "ast_node的热数据应保持紧凑");
+
+/// @brief AST资源清理，整体释放ast_context，所有AST节点都失效
 void free_ast(ast_node * root);
 
-/// @brief抽象语法树的根节点指针
-extern ast_node * ast_root;
+///
+/// @brief 流式编译时顶层定义（函数定义或者变量声明语句）的处理函数。
+/// 不为空时，前端每归约出一个顶层定义就交给它处理，处理后其AST立即释放，不再挂到编译单元上。每个线程各自设置
+///
+extern thread_local std::function<void(ast_node *)> ast_unit_item_handler;
+
+///
+/// @brief 创建编译单元节点，并记录流式编译时的回退位置
+/// @return ast_node* 编译单元节点
+///
+ast_node * create_compile_unit();
+
+///
+/// @brief 向编译单元追加顶层定义（函数定义或者变量声明语句）。
+/// 流式编译时顶层定义交给ast_unit_item_handler处理后即释放
+/// @param unit 编译单元节点，为空时创建
+/// @param item 顶层定义，可以为空
+/// @return ast_node* 编译单元节点
+///
+ast_node * add_compile_unit_item(ast_node * unit, ast_node * item);
 
 /// @brief 创建AST的内部节点，请注意可追加孩子节点，请按次序依次加入，最多3个
 /// @param node_type 节点类型
@@ -291,4 +492,12 @@ ast_node * create_var_decl_stmt_node(type_attr & type, var_id_attr & id);
 /// @param id 变量的名字
 /// @return ast_node* 变量声明语句节点
 ///
-ast_node * add_var_decl_node(ast_node * stmt_node, var_id_attr & id);
\ No newline at end of file
+ast_node * add_var_decl_node(ast_node * stmt_node, var_id_attr & id);
+
+///
+/// @brief AST的结构指纹：先根次序下各节点的类型、值与孩子个数，不含行号。
+/// 只有空白、注释或行号不同的两段源代码指纹相同，可作为编译缓存的键
+/// @param root 子树的根节点
+/// @return std::string 指纹
+///
+std::string ast_fingerprint(ast_node * root);
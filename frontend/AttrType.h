@@ -17,6 +17,8 @@
 
 #include <cstdint>
 
+#include "StringInterner.h"
+
 ///
 /// @brief 基本类型枚举类
 ///
@@ -48,7 +50,7 @@ typedef struct digit_real_attr {
 /// @brief 词法与语法通信的标识符（变量名、函数名等）
 ///
 typedef struct var_id_attr {
-    char * id;      // 标识符名称
+    SymbolId id;    // 标识符名称，驻留在全局字符串驻留表中
     int64_t lineno; // 行号
 } var_id_attr;
 
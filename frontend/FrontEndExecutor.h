@@ -18,6 +18,7 @@
 #include <string>
 
 #include "AST.h"
+#include "SourceBuffer.h"
 
 ///
 /// @brief 前端执行器的接口类
@@ -56,8 +57,13 @@ protected:
     ///
     std::string filename;
 
+    ///
+    /// @brief 源文件缓冲区，各前端共用，源文件只映射一次
+    ///
+    SourceBuffer source;
+
     ///
     /// @brief  抽象语法树的根
     ///
-    ast_node * astRoot;
+    ast_node * astRoot = nullptr;
 };
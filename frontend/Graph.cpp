@@ -37,10 +37,10 @@ string getNodeName(ast_node * astnode)
             nodeName = to_string((int32_t) astnode->integer_val);
             break;
         case ast_operator_type::AST_OP_LEAF_LITERAL_FLOAT:
-            nodeName = to_string(astnode->float_val);
+            nodeName = to_string(astnode->getFloatVal());
             break;
         case ast_operator_type::AST_OP_LEAF_VAR_ID:
-            nodeName = astnode->name;
+            nodeName = symbolName(astnode->getName());
             break;
         case ast_operator_type::AST_OP_LEAF_TYPE:
             nodeName = astnode->type->toString();
@@ -149,14 +149,13 @@ Agnode_t * genInternalGraphNode(Agraph_t * g, ast_node * astnode)
 
     // 即使没有孩子，也要返回节点，只是显示节点信息
     // 如果不显示，则可以取消掉下面的注释即可。
-    // if (astnode->sons.empty()) {
+    // if (astnode->sons().empty()) {
     //     return nullptr;
     // }
 
     // 遍历AST内部结点的孩子，获取创建孩子的图形结点，递归
     // 这里用到了C++向量的容器遍历方式之一，从头开始到尾部
-    std::vector<ast_node *>::iterator pIter;
-    for (pIter = astnode->sons.begin(); pIter != astnode->sons.end(); ++pIter) {
+    for (auto pIter = astnode->sons().begin(); pIter != astnode->sons().end(); ++pIter) {
 
         Agnode_t * son_node = graph_visit_ast_node(g, *pIter);
         if (son_node) {
@@ -0,0 +1,135 @@
+///
+/// @file SourceBuffer.cpp
+/// @brief 前端共用的源文件缓冲区的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "SourceBuffer.h"
+#include "Common.h"
+
+/// @brief 析构函数，释放映射或内存
+SourceBuffer::~SourceBuffer()
+{
+    close();
+}
+
+/// @brief 释放映射或内存
+void SourceBuffer::close()
+{
+    if (base) {
+#ifndef _WIN32
+        if (mappedSize) {
+            munmap(base, mappedSize);
+        } else {
+            delete[] base;
+        }
+#else
+        delete[] base;
+#endif
+    }
+
+    base = nullptr;
+    length = 0;
+    mappedSize = 0;
+}
+
+/// @brief 打开并映射源文件，若之前已打开则先释放
+/// @param _filename 源文件路径
+/// @return true: 成功 false: 失败
+bool SourceBuffer::open(const std::string & _filename)
+{
+    close();
+
+    filename = _filename;
+
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        minic_log(LOG_ERROR, "文件(%s)不能打开，可能不存在", filename.c_str());
+        return false;
+    }
+
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || !S_ISREG(st.st_mode) || (st.st_size == 0)) {
+        // 非普通文件或空文件不能映射，改为读入
+        ::close(fd);
+        return readAll();
+    }
+
+    size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    size_t fileSize = (size_t) st.st_size;
+    size_t totalSize = (fileSize + PaddingSize + pageSize - 1) / pageSize * pageSize;
+
+    // 先预留含尾部'\0'在内的整块匿名区域，再把文件覆盖映射到其开头。
+    // 文件最后一页超出文件长度的部分以及其后的匿名页都由内核清零，这样尾部的'\0'无需拷贝文件即可得到。
+    void * region = mmap(nullptr, totalSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        ::close(fd);
+        return readAll();
+    }
+
+    void * file = mmap(region, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0);
+
+    ::close(fd);
+
+    if (file == MAP_FAILED) {
+        munmap(region, totalSize);
+        return readAll();
+    }
+
+    base = (char *) region;
+    length = fileSize;
+    mappedSize = totalSize;
+
+    return true;
+#else
+    return readAll();
+#endif
+}
+
+/// @brief 不能映射时（如管道、空文件等）采用一次性读入的方式
+/// @return true: 成功 false: 失败
+bool SourceBuffer::readAll()
+{
+    FILE * fp = fopen(filename.c_str(), "rb");
+    if (fp == nullptr) {
+        minic_log(LOG_ERROR, "文件(%s)不能打开，可能不存在", filename.c_str());
+        return false;
+    }
+
+    std::string content;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+        content.append(buf, n);
+    }
+
+    fclose(fp);
+
+    base = new char[content.size() + PaddingSize];
+    memcpy(base, content.data(), content.size());
+    memset(base + content.size(), 0, PaddingSize);
+    length = content.size();
+    mappedSize = 0;
+
+    return true;
+}
@@ -0,0 +1,118 @@
+///
+/// @file SourceBuffer.h
+/// @brief 前端共用的源文件缓冲区，源文件只映射（读入）一次
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+///
+/// @brief 源文件缓冲区。
+/// POSIX平台下采用mmap私有映射（写时复制）整个文件，其它情况下一次性读入内存。
+/// 缓冲区内容的后面固定跟有两个'\0'字节，可直接交给flex的yy_scan_buffer使用，
+/// 也可作为递归下降词法分析的哨兵。
+///
+class SourceBuffer {
+
+public:
+    /// @brief 缓冲区尾部追加的'\0'字节个数，flex的yy_scan_buffer要求为2
+    static constexpr size_t PaddingSize = 2;
+
+    /// @brief 构造函数
+    SourceBuffer() = default;
+
+    /// @brief 析构函数，释放映射或内存
+    ~SourceBuffer();
+
+    SourceBuffer(const SourceBuffer &) = delete;
+    SourceBuffer & operator=(const SourceBuffer &) = delete;
+
+    ///
+    /// @brief 打开并映射源文件，若之前已打开则先释放
+    /// @param filename 源文件路径
+    /// @return true: 成功 false: 失败
+    ///
+    bool open(const std::string & filename);
+
+    ///
+    /// @brief 释放映射或内存
+    ///
+    void close();
+
+    ///
+    /// @brief 获取可写的缓冲区首地址，内容后跟PaddingSize个'\0'。flex扫描时会临时改写缓冲区，需可写
+    /// @return char*
+    ///
+    char * data()
+    {
+        return base;
+    }
+
+    ///
+    /// @brief 获取只读的缓冲区首地址
+    /// @return const char*
+    ///
+    const char * data() const
+    {
+        return base;
+    }
+
+    ///
+    /// @brief 源文件内容的字节数，不含尾部追加的'\0'
+    /// @return size_t
+    ///
+    size_t size() const
+    {
+        return length;
+    }
+
+    ///
+    /// @brief 源文件内容视图，不含尾部追加的'\0'
+    /// @return std::string_view
+    ///
+    std::string_view view() const
+    {
+        return std::string_view(base, length);
+    }
+
+    ///
+    /// @brief 源文件路径
+    /// @return const std::string&
+    ///
+    const std::string & getFileName() const
+    {
+        return filename;
+    }
+
+private:
+    ///
+    /// @brief 不能映射时（如管道、空文件等）采用一次性读入的方式
+    /// @return true: 成功 false: 失败
+    ///
+    bool readAll();
+
+    /// @brief 源文件路径
+    std::string filename;
+
+    /// @brief 缓冲区首地址
+    char * base = nullptr;
+
+    /// @brief 源文件内容的字节数
+    size_t length = 0;
+
+    /// @brief 映射区域的总字节数，为0时表示缓冲区由new[]分配
+    size_t mappedSize = 0;
+};
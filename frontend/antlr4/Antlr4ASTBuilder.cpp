@@ -0,0 +1,346 @@
+///
+/// @file Antlr4ASTBuilder.cpp
+/// @brief Antlr4语法分析的同时产生AST
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做，取代具体语法树的遍历
+/// </table>
+///
+#include <exception>
+#include <string>
+
+#include "Antlr4ASTBuilder.h"
+#include "AttrType.h"
+
+/// @brief 构造函数
+/// @param _tokens 语法分析器的记号流，用于获取规则中的终结符
+MiniCASTBuilder::MiniCASTBuilder(antlr4::TokenStream * _tokens) : tokens(_tokens)
+{}
+
+/// @brief 重新分析前复位。流式编译时前一次分析已提交的顶层定义不再重复提交
+void MiniCASTBuilder::restart()
+{
+    // 文法没有二义性，重新分析时前面成功分析的顶层定义与前一次完全相同
+    if (ast_unit_item_handler && (unitItems > skipUnitItems)) {
+        skipUnitItems = unitItems;
+    }
+
+    values.clear();
+    marks.clear();
+    root = nullptr;
+    broken = false;
+    unitItems = 0;
+}
+
+/// @brief 规则进入，记录值栈的位置
+/// @param ctx 规则上下文
+void MiniCASTBuilder::enterEveryRule(antlr4::ParserRuleContext * ctx)
+{
+    marks.push_back(values.size());
+
+    if (ctx->getRuleIndex() == MiniCParser::RuleCompileUnit) {
+        // 编译单元节点最先创建，流式编译时记录回退位置
+        root = create_compile_unit();
+    }
+}
+
+/// @brief 规则退出，即非终结符归约，产生AST节点
+/// @param ctx 规则上下文
+void MiniCASTBuilder::exitEveryRule(antlr4::ParserRuleContext * ctx)
+{
+    size_t first = marks.back();
+
+    // 编译单元的孩子规则即为顶层定义
+    bool topLevel = marks.size() == 2;
+
+    marks.pop_back();
+
+    if (std::uncaught_exceptions() > 0) {
+        // SLL分析放弃时异常穿过各层规则，规则的孩子不全，不再产生节点
+        broken = true;
+        return;
+    }
+
+    ast_node * node = reduce(ctx, first, topLevel);
+    if (node) {
+        values.resize(first);
+        push(node);
+    }
+}
+
+/// @brief 终结符，信息在规则退出时从记号流获取，这里无动作
+/// @param node 终结符节点
+void MiniCASTBuilder::visitTerminal(antlr4::tree::TerminalNode * node)
+{
+    (void) node;
+}
+
+/// @brief 出错的终结符，无动作
+/// @param node 终结符节点
+void MiniCASTBuilder::visitErrorNode(antlr4::tree::ErrorNode * node)
+{
+    (void) node;
+}
+
+/// @brief 规则开始Token后的第n个Token
+/// @param ctx 规则上下文
+/// @param n 偏移
+/// @return antlr4::Token*
+antlr4::Token * MiniCASTBuilder::tokenAt(antlr4::ParserRuleContext * ctx, size_t n)
+{
+    return tokens->get(ctx->getStart()->getTokenIndex() + n);
+}
+
+/// @brief 加入编译单元的顶层定义，流式编译时交给后续处理
+/// @param item 函数定义或者变量声明语句
+void MiniCASTBuilder::addUnitItem(ast_node * item)
+{
+    if (unitItems++ < skipUnitItems) {
+        // 前一次分析已经提交过，丢弃
+        ast_context->rewind(ast_context->itemMark);
+        return;
+    }
+
+    (void) add_compile_unit_item(root, item);
+}
+
+/// @brief 由子表达式与运算符交替组成的二元表达式，按照左结合产生AST
+/// @param first 子表达式在值栈中的开始位置
+/// @return ast_node* 表达式节点
+ast_node * MiniCASTBuilder::reduceBinary(size_t first)
+{
+    // 值栈中为：表达式 (运算符 表达式)*
+    if (((values.size() - first) % 2) == 0) {
+        broken = true;
+        return nullptr;
+    }
+
+    ast_node * lhs = values[first].node;
+
+    for (size_t k = first + 1; k < values.size(); k += 2) {
+
+        // 左边优先，左操作数和右操作数之间按照运算符构成二元运算树
+        lhs = create_contain_node(values[k].op, lhs, values[k + 1].node);
+    }
+
+    return lhs;
+}
+
+/// @brief 非终结符归约，产生AST节点
+/// @param ctx 规则上下文
+/// @param first 本规则的孩子在值栈中的开始位置
+/// @param topLevel 是否为编译单元的顶层定义
+/// @return ast_node* 产生的节点，为空时孩子原样保留在值栈中
+ast_node * MiniCASTBuilder::reduce(antlr4::ParserRuleContext * ctx, size_t first, bool topLevel)
+{
+    // 本规则的孩子个数
+    size_t count = values.size() - first;
+
+    antlr4::Token * start = ctx->getStart();
+
+    switch (ctx->getRuleIndex()) {
+
+        case MiniCParser::RuleFuncDef: {
+            // funcDef: T_INT T_ID T_L_PAREN T_R_PAREN block;
+            if (count != 1) {
+                broken = true;
+                return nullptr;
+            }
+
+            type_attr funcReturnType{BasicType::TYPE_INT, (int64_t) start->getLine()};
+
+            // 函数名，名字驻留到全局字符串驻留表中
+            antlr4::Token * idToken = tokenAt(ctx, 1);
+            var_id_attr funcId{internSymbol(idToken->getText()), (int64_t) idToken->getLine()};
+
+            // 形参结点目前没有，设置为空指针
+            ast_node * funcNode = create_func_def(funcReturnType, funcId, values[first].node, nullptr);
+
+            values.resize(first);
+
+            // 流式编译时函数定义直接交给后续处理
+            addUnitItem(funcNode);
+
+            return nullptr;
+        }
+
+        case MiniCParser::RuleBlock: {
+            // block: T_L_BRACE blockItemList? T_R_BRACE;
+            // blockItemList与blockItem不产生节点，语句都留在值栈中
+            ast_node * blockNode = create_contain_node(ast_operator_type::AST_OP_BLOCK);
+
+            for (size_t k = first; k < values.size(); ++k) {
+
+                // 空语句没有节点，插入时忽略
+                (void) blockNode->insert_son_node(values[k].node);
+            }
+
+            return blockNode;
+        }
+
+        case MiniCParser::RuleVarDecl: {
+            // varDecl: basicType varDef (T_COMMA varDef)* T_SEMICOLON;
+            // basicType只有T_INT，即开始Token
+            type_attr typeAttr{BasicType::TYPE_INT, (int64_t) start->getLine()};
+
+            ast_node * stmtNode = create_contain_node(ast_operator_type::AST_OP_DECL_STMT);
+
+            for (size_t k = first; k < values.size(); ++k) {
+
+                ast_node * typeNode = create_type_node(typeAttr);
+
+                // 创建变量定义节点并插入到变量声明语句
+                (void) stmtNode->insert_son_node(
+                    ast_node::New(ast_operator_type::AST_OP_VAR_DECL, typeNode, values[k].node, nullptr));
+            }
+
+            if (topLevel) {
+                values.resize(first);
+
+                // 全局变量声明
+                addUnitItem(stmtNode);
+
+                return nullptr;
+            }
+
+            return stmtNode;
+        }
+
+        case MiniCParser::RuleVarDef:
+        case MiniCParser::RuleLVal:
+            // varDef: T_ID; lVal: T_ID;
+            return ast_node::New(start->getText(), (int64_t) start->getLine());
+
+        case MiniCParser::RuleStatement:
+            if (dynamic_cast<MiniCParser::ReturnStatementContext *>(ctx)) {
+
+                // T_RETURN expr T_SEMICOLON
+                if (count != 1) {
+                    broken = true;
+                    return nullptr;
+                }
+
+                return create_contain_node(ast_operator_type::AST_OP_RETURN, values[first].node);
+            }
+
+            if (dynamic_cast<MiniCParser::AssignStatementContext *>(ctx)) {
+
+                // lVal T_ASSIGN expr T_SEMICOLON
+                if (count != 2) {
+                    broken = true;
+                    return nullptr;
+                }
+
+                return ast_node::New(ast_operator_type::AST_OP_ASSIGN,
+                                     values[first].node,
+                                     values[first + 1].node,
+                                     nullptr);
+            }
+
+            // 语句块与表达式语句的节点已在值栈中，空语句没有节点
+            return nullptr;
+
+        case MiniCParser::RuleAddExp:
+        case MiniCParser::RuleMulExp:
+            // addExp: mulExp (addOp mulExp)*; mulExp: unaryExp (mulOp unaryExp)*;
+            return count == 1 ? nullptr : reduceBinary(first);
+
+        case MiniCParser::RuleAddOp:
+        case MiniCParser::RuleMulOp:
+        case MiniCParser::RuleUnaryOp:
+            switch (start->getType()) {
+                case MiniCParser::T_ADD:
+                    pushOp(ast_operator_type::AST_OP_ADD);
+                    break;
+                case MiniCParser::T_SUB:
+                    // 一元运算符只有求负
+                    pushOp(ctx->getRuleIndex() == MiniCParser::RuleUnaryOp ? ast_operator_type::AST_OP_NEG
+                                                                           : ast_operator_type::AST_OP_SUB);
+                    break;
+                case MiniCParser::T_MUL:
+                    pushOp(ast_operator_type::AST_OP_MUL);
+                    break;
+                case MiniCParser::T_DIV:
+                    pushOp(ast_operator_type::AST_OP_DIV);
+                    break;
+                case MiniCParser::T_MOD:
+                    pushOp(ast_operator_type::AST_OP_MOD);
+                    break;
+                default:
+                    pushOp(ast_operator_type::AST_OP_MAX);
+                    break;
+            }
+
+            return nullptr;
+
+        case MiniCParser::RuleUnaryExp:
+            // unaryExp: primaryExp | T_ID T_L_PAREN realParamList? T_R_PAREN | unaryOp unaryExp;
+            if ((start->getType() == MiniCParser::T_ID) && (tokenAt(ctx, 1)->getType() == MiniCParser::T_L_PAREN)) {
+
+                // 函数调用，实参可能为空
+                var_id_attr funcId{internSymbol(start->getText()), (int64_t) start->getLine()};
+
+                ast_node * paramsNode = count ? values[first].node : nullptr;
+
+                return create_func_call(ast_node::New(funcId), paramsNode);
+            }
+
+            if (count == 2) {
+
+                // 一元运算
+                return create_contain_node(values[first].op, values[first + 1].node);
+            }
+
+            return nullptr;
+
+        case MiniCParser::RulePrimaryExp:
+            // primaryExp: T_L_PAREN expr T_R_PAREN | T_DIGIT | lVal;
+            if (start->getType() == MiniCParser::T_DIGIT) {
+
+                std::string strVal = start->getText();
+                uint32_t intVal = 0;
+
+                // 解析八进制和十六进制数字
+                if (strVal.size() > 1 && strVal[0] == '0') {
+                    if (strVal.size() > 2 && (strVal[1] == 'x' || strVal[1] == 'X')) {
+                        // 十六进制
+                        intVal = std::stoul(strVal, nullptr, 16);
+                    } else {
+                        // 八进制
+                        intVal = std::stoul(strVal, nullptr, 8);
+                    }
+                } else {
+                    // 十进制
+                    intVal = std::stoul(strVal);
+                }
+
+                digit_int_attr digitAttr{intVal, (int64_t) start->getLine()};
+                return ast_node::New(digitAttr);
+            }
+
+            // 括号表达式与左值的节点已在值栈中
+            return nullptr;
+
+        case MiniCParser::RuleRealParamList: {
+            // realParamList: expr (T_COMMA expr)*;
+            ast_node * paramListNode = create_contain_node(ast_operator_type::AST_OP_FUNC_REAL_PARAMS);
+
+            for (size_t k = first; k < values.size(); ++k) {
+                (void) paramListNode->insert_son_node(values[k].node);
+            }
+
+            return paramListNode;
+        }
+
+        default:
+            // compileUnit、blockItemList、blockItem、basicType、expr等不产生节点
+            return nullptr;
+    }
+}
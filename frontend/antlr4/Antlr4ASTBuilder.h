@@ -0,0 +1,144 @@
+///
+/// @file Antlr4ASTBuilder.h
+/// @brief Antlr4语法分析的同时产生AST
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做，取代具体语法树的遍历
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "AST.h"
+#include "MiniCParser.h"
+
+///
+/// @brief 语法分析监听器，在语法分析的过程中产生AST，不需要构造完整的具体语法树。
+/// 与bison的语义动作类似，每个非终结符归约（规则退出）时从值栈中取出其孩子的AST节点，创建本节点后压栈。
+/// 终结符的信息通过规则的开始Token以及记号流获取。
+///
+class MiniCASTBuilder : public antlr4::tree::ParseTreeListener {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _tokens 语法分析器的记号流，用于获取规则中的终结符
+    ///
+    explicit MiniCASTBuilder(antlr4::TokenStream * _tokens);
+
+    ///
+    /// @brief 语法分析得到的编译单元节点
+    /// @return ast_node* 编译单元节点，语法分析失败时为空
+    ///
+    ast_node * getRoot() const
+    {
+        return broken ? nullptr : root;
+    }
+
+    ///
+    /// @brief 重新分析前复位。流式编译时前一次分析已提交的顶层定义不再重复提交
+    ///
+    void restart();
+
+    /// @brief 规则进入，记录值栈的位置
+    /// @param ctx 规则上下文
+    void enterEveryRule(antlr4::ParserRuleContext * ctx) override;
+
+    /// @brief 规则退出，即非终结符归约，产生AST节点
+    /// @param ctx 规则上下文
+    void exitEveryRule(antlr4::ParserRuleContext * ctx) override;
+
+    /// @brief 终结符，信息在规则退出时从记号流获取，这里无动作
+    /// @param node 终结符节点
+    void visitTerminal(antlr4::tree::TerminalNode * node) override;
+
+    /// @brief 出错的终结符，无动作
+    /// @param node 终结符节点
+    void visitErrorNode(antlr4::tree::ErrorNode * node) override;
+
+private:
+    ///
+    /// @brief 值栈中的一项，可以是AST节点，也可以是运算符
+    ///
+    struct Item {
+        /// @brief AST节点，运算符时为空
+        ast_node * node;
+
+        /// @brief 运算符，AST节点时为AST_OP_MAX
+        ast_operator_type op;
+    };
+
+    /// @brief 压入AST节点
+    /// @param node AST节点
+    void push(ast_node * node)
+    {
+        values.push_back(Item{node, ast_operator_type::AST_OP_MAX});
+    }
+
+    /// @brief 压入运算符
+    /// @param op 运算符
+    void pushOp(ast_operator_type op)
+    {
+        values.push_back(Item{nullptr, op});
+    }
+
+    ///
+    /// @brief 非终结符归约，产生AST节点
+    /// @param ctx 规则上下文
+    /// @param first 本规则的孩子在值栈中的开始位置
+    /// @param topLevel 是否为编译单元的顶层定义
+    /// @return ast_node* 产生的节点，为空时孩子原样保留在值栈中
+    ///
+    ast_node * reduce(antlr4::ParserRuleContext * ctx, size_t first, bool topLevel);
+
+    ///
+    /// @brief 由子表达式与运算符交替组成的二元表达式，按照左结合产生AST
+    /// @param first 子表达式在值栈中的开始位置
+    /// @return ast_node* 表达式节点
+    ///
+    ast_node * reduceBinary(size_t first);
+
+    ///
+    /// @brief 加入编译单元的顶层定义，流式编译时交给后续处理
+    /// @param item 函数定义或者变量声明语句
+    ///
+    void addUnitItem(ast_node * item);
+
+    ///
+    /// @brief 规则开始Token后的第n个Token
+    /// @param ctx 规则上下文
+    /// @param n 偏移
+    /// @return antlr4::Token*
+    ///
+    antlr4::Token * tokenAt(antlr4::ParserRuleContext * ctx, size_t n);
+
+    /// @brief 记号流
+    antlr4::TokenStream * tokens;
+
+    /// @brief 值栈
+    std::vector<Item> values;
+
+    /// @brief 每个正在分析的规则的孩子在值栈中的开始位置
+    std::vector<size_t> marks;
+
+    /// @brief 编译单元节点
+    ast_node * root = nullptr;
+
+    /// @brief 出错恢复时孩子不全，产生的AST无效
+    bool broken = false;
+
+    /// @brief 本次分析已提交的顶层定义个数
+    size_t unitItems = 0;
+
+    /// @brief 流式编译重新分析时，前面已提交过的顶层定义个数，这些定义不再提交
+    size_t skipUnitItems = 0;
+};
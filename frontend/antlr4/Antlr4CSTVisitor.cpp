@@ -1,519 +0,0 @@
-///
-/// @file Antlr4CSTVisitor.cpp
-/// @brief Antlr4的具体语法树的遍历产生AST
-/// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
-///
-/// @copyright Copyright (c) 2024
-///
-/// @par 修改日志:
-/// <table>
-/// <tr><th>Date       <th>Version <th>Author  <th>Description
-/// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
-/// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
-/// </table>
-///
-
-#include <string>
-
-#include "Antlr4CSTVisitor.h"
-#include "AST.h"
-#include "AttrType.h"
-
-#define Instanceof(res, type, var) auto res = dynamic_cast<type>(var)
-
-/// @brief 构造函数
-MiniCCSTVisitor::MiniCCSTVisitor()
-{}
-
-/// @brief 析构函数
-MiniCCSTVisitor::~MiniCCSTVisitor()
-{}
-
-/// @brief 遍历CST产生AST
-/// @param root CST语法树的根结点
-/// @return AST的根节点
-ast_node * MiniCCSTVisitor::run(MiniCParser::CompileUnitContext * root)
-{
-    return std::any_cast<ast_node *>(visitCompileUnit(root));
-}
-
-/// @brief 非终结运算符compileUnit的遍历
-/// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitCompileUnit(MiniCParser::CompileUnitContext * ctx)
-{
-    // compileUnit: (funcDef | varDecl)* EOF
-
-    // 请注意这里必须先遍历全局变量后遍历函数。肯定可以确保全局变量先声明后使用的规则，但有些情况却不能检查出。
-    // 事实上可能函数A后全局变量B后函数C，这时在函数A中是不能使用变量B的，需要报语义错误，但目前的处理不会。
-    // 因此在进行语义检查时，可能追加检查行号和列号，如果函数的行号/列号在全局变量的行号/列号的前面则需要报语义错误
-    // TODO 请追加实现。
-
-    ast_node * temp_node;
-    ast_node * compileUnitNode = create_contain_node(ast_operator_type::AST_OP_COMPILE_UNIT);
-
-    // 可能多个变量，因此必须循环遍历
-    for (auto varCtx: ctx->varDecl()) {
-
-        // 变量函数定义
-        temp_node = std::any_cast<ast_node *>(visitVarDecl(varCtx));
-        (void) compileUnitNode->insert_son_node(temp_node);
-    }
-
-    // 可能有多个函数，因此必须循环遍历
-    for (auto funcCtx: ctx->funcDef()) {
-
-        // 变量函数定义
-        temp_node = std::any_cast<ast_node *>(visitFuncDef(funcCtx));
-        (void) compileUnitNode->insert_son_node(temp_node);
-    }
-
-    return compileUnitNode;
-}
-
-/// @brief 非终结运算符funcDef的遍历
-/// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitFuncDef(MiniCParser::FuncDefContext * ctx)
-{
-    // 识别的文法产生式：funcDef : T_INT T_ID T_L_PAREN T_R_PAREN block;
-
-    // 函数返回类型，终结符
-    type_attr funcReturnType{BasicType::TYPE_INT, (int64_t) ctx->T_INT()->getSymbol()->getLine()};
-
-    // 创建函数名的标识符终结符节点，终结符
-    char * id = strdup(ctx->T_ID()->getText().c_str());
-
-    var_id_attr funcId{id, (int64_t) ctx->T_ID()->getSymbol()->getLine()};
-
-    // 形参结点目前没有，设置为空指针
-    ast_node * formalParamsNode = nullptr;
-
-    // 遍历block结点创建函数体节点，非终结符
-    auto blockNode = std::any_cast<ast_node *>(visitBlock(ctx->block()));
-
-    // 创建函数定义的节点，孩子有类型，函数名，语句块和形参(实际上无)
-    // create_func_def函数内会释放funcId中指向的标识符空间，切记，之后不要再释放，之前一定要是通过strdup函数或者malloc分配的空间
-    return create_func_def(funcReturnType, funcId, blockNode, formalParamsNode);
-}
-
-/// @brief 非终结运算符block的遍历
-/// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitBlock(MiniCParser::BlockContext * ctx)
-{
-    // 识别的文法产生式：block : T_L_BRACE blockItemList? T_R_BRACE';
-    if (!ctx->blockItemList()) {
-        // 语句块没有语句
-
-        // 为了方便创建一个空的Block节点
-        return create_contain_node(ast_operator_type::AST_OP_BLOCK);
-    }
-
-    // 语句块含有语句
-
-    // 内部创建Block节点，并把语句加入，这里不需要创建Block节点
-    return visitBlockItemList(ctx->blockItemList());
-}
-
-/// @brief 非终结运算符blockItemList的遍历
-/// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitBlockItemList(MiniCParser::BlockItemListContext * ctx)
-{
-    // 识别的文法产生式：blockItemList : blockItem +;
-    // 正闭包 循环 至少一个blockItem
-    auto block_node = create_contain_node(ast_operator_type::AST_OP_BLOCK);
-
-    for (auto blockItemCtx: ctx->blockItem()) {
-
-        // 非终结符，需遍历
-        auto blockItem = std::any_cast<ast_node *>(visitBlockItem(blockItemCtx));
-
-        // 插入到块节点中
-        (void) block_node->insert_son_node(blockItem);
-    }
-
-    return block_node;
-}
-
-///
-/// @brief 非终结运算符blockItem的遍历
-/// @param ctx CST上下文
-///
-std::any MiniCCSTVisitor::visitBlockItem(MiniCParser::BlockItemContext * ctx)
-{
-    // 识别的文法产生式：blockItem : statement | varDecl
-    if (ctx->statement()) {
-        // 语句识别
-
-        return visitStatement(ctx->statement());
-    } else if (ctx->varDecl()) {
-        return visitVarDecl(ctx->varDecl());
-    }
-
-    return nullptr;
-}
-
-/// @brief 非终结运算符statement中的遍历
-/// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitStatement(MiniCParser::StatementContext * ctx)
-{
-    // 识别的文法产生式：statement: T_ID T_ASSIGN expr T_SEMICOLON  # assignStatement
-    // | T_RETURN expr T_SEMICOLON # returnStatement
-    // | block  # blockStatement
-    // | expr ? T_SEMICOLON #expressionStatement;
-    if (Instanceof(assignCtx, MiniCParser::AssignStatementContext *, ctx)) {
-        return visitAssignStatement(assignCtx);
-    } else if (Instanceof(returnCtx, MiniCParser::ReturnStatementContext *, ctx)) {
-        return visitReturnStatement(returnCtx);
-    } else if (Instanceof(blockCtx, MiniCParser::BlockStatementContext *, ctx)) {
-        return visitBlockStatement(blockCtx);
-    } else if (Instanceof(exprCtx, MiniCParser::ExpressionStatementContext *, ctx)) {
-        return visitExpressionStatement(exprCtx);
-    }
-
-    return nullptr;
-}
-
-///
-/// @brief 非终结运算符statement中的returnStatement的遍历
-/// @param ctx CST上下文
-///
-std::any MiniCCSTVisitor::visitReturnStatement(MiniCParser::ReturnStatementContext * ctx)
-{
-    // 识别的文法产生式：returnStatement -> T_RETURN expr T_SEMICOLON
-
-    // 非终结符，表达式expr遍历
-    auto exprNode = std::any_cast<ast_node *>(visitExpr(ctx->expr()));
-
-    // 创建返回节点，其孩子为Expr
-    return create_contain_node(ast_operator_type::AST_OP_RETURN, exprNode);
-}
-
-/// @brief 非终结运算符expr的遍历
-/// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitExpr(MiniCParser::ExprContext * ctx)
-{
-    // 识别产生式：expr: addExp;
-
-    return visitAddExp(ctx->addExp());
-}
-
-///
-/// @brief 非终结符AddExp的分析
-/// @param ctx CST上下文
-/// @return std::any AST的节点
-///
-std::any MiniCCSTVisitor::visitAddExp(MiniCParser::AddExpContext * ctx)
-{
-    // 识别产生式：addExp: mulExp (addOp mulExp)*;
-
-    // mulExp 至少有一个
-    ast_node * lhs = std::any_cast<ast_node *>(visitMulExp(ctx->mulExp(0)));
-
-    // (addOp mulExp)* 可以没有
-    int size = ctx->addOp().size();
-
-    // 无右操作数时返回左操作数
-    if (size == 0) {
-        return lhs;
-    }
-
-    // 遍历链
-    for (int i = 0; i < size; i++) {
-
-        auto opType = std::any_cast<ast_operator_type>(visitAddOp(ctx->addOp(i)));
-        auto rhs = std::any_cast<ast_node *>(visitMulExp(ctx->mulExp(i + 1)));
-
-        // 递归方式建立左边优先的语法树，左操作数和右操作数之间按照运算符构成二元运算树
-        lhs = create_contain_node(opType, lhs, rhs);
-    }
-
-    return lhs;
-}
-
-///
-/// @brief 非终结符addOp的分析
-/// @param ctx CST上下文
-/// @return std::any 类型
-///
-std::any MiniCCSTVisitor::visitAddOp(MiniCParser::AddOpContext * ctx)
-{
-    if (ctx->T_ADD()) {
-        return ast_operator_type::AST_OP_ADD;
-    } else if (ctx->T_SUB()) {
-        return ast_operator_type::AST_OP_SUB;
-    } else {
-        return ast_operator_type::AST_OP_MAX;
-    }
-}
-
-///
-/// @brief 非终结符MulExp的分析
-/// @param ctx CST上下文
-/// @return std::any AST的节点
-///
-std::any MiniCCSTVisitor::visitMulExp(MiniCParser::MulExpContext * ctx)
-{
-    // 识别产生式：mulExp: unaryExp (mulOp unaryExp)*;
-
-    // unaryExp 至少有一个
-    ast_node * lhs = std::any_cast<ast_node *>(visitUnaryExp(ctx->unaryExp(0)));
-
-    // (mulOp unaryExp)* 可以没有
-    int size = ctx->mulOp().size();
-
-    // 无右操作数时返回左操作数
-    if (size == 0) {
-        return lhs;
-    }
-
-    // 遍历链
-    for (int i = 0; i < size; i++) {
-
-        auto opType = std::any_cast<ast_operator_type>(visitMulOp(ctx->mulOp(i)));
-        auto rhs = std::any_cast<ast_node *>(visitUnaryExp(ctx->unaryExp(i + 1)));
-
-        // 递归方式建立左边优先的语法树，左操作数和右操作数之间按照运算符构成二元运算树
-        lhs = create_contain_node(opType, lhs, rhs);
-    }
-
-    return lhs;
-}
-
-///
-/// @brief 非终结符mulOp的分析
-/// @param ctx CST上下文
-/// @return std::any 类型
-///
-std::any MiniCCSTVisitor::visitMulOp(MiniCParser::MulOpContext * ctx)
-{
-    if (ctx->T_MUL()) {
-        return ast_operator_type::AST_OP_MUL;
-    } else if (ctx->T_DIV()) {
-        return ast_operator_type::AST_OP_DIV;
-    } else if (ctx->T_MOD()) {
-        return ast_operator_type::AST_OP_MOD;
-    } else {
-        return ast_operator_type::AST_OP_MAX;
-    }
-}
-
-///
-/// @brief 非终结符unaryExp的分析
-/// @param ctx CST上下文
-/// @return std::any AST的节点
-///
-std::any MiniCCSTVisitor::visitUnaryExp(MiniCParser::UnaryExpContext * ctx)
-{
-    // 识别产生式：unaryExp: primaryExp | T_ID T_L_PAREN realParamList? T_R_PAREN | unaryOp unaryExp;
-
-    // primaryExp
-    if (ctx->primaryExp()) {
-        return visitPrimaryExp(ctx->primaryExp());
-    }
-
-    // T_ID T_L_PAREN realParamList? T_R_PAREN
-    if (ctx->T_ID()) {
-        char * id = strdup(ctx->T_ID()->getText().c_str());
-        var_id_attr funcId{id, (int64_t) ctx->T_ID()->getSymbol()->getLine()};
-
-        auto funcNameNode = ast_node::New(funcId);
-
-        // 函数调用的实参，可能为空
-        ast_node * realParamsNode = nullptr;
-        if (ctx->realParamList()) {
-            realParamsNode = std::any_cast<ast_node *>(visitRealParamList(ctx->realParamList()));
-        }
-
-        // 创建函数调用节点
-        return create_func_call(funcNameNode, realParamsNode);
-    }
-
-    // unaryOp unaryExp
-    if (ctx->unaryOp()) {
-        auto opType = std::any_cast<ast_operator_type>(visitUnaryOp(ctx->unaryOp()));
-        auto operand = std::any_cast<ast_node *>(visitUnaryExp(ctx->unaryExp()));
-
-        // 创建一元运算节点
-        return create_contain_node(opType, operand);
-    }
-
-    // 其它情况（语法错误）
-    return nullptr;
-}
-
-///
-/// @brief 非终结符unaryOp的分析
-/// @param ctx CST上下文
-/// @return std::any 类型
-///
-std::any MiniCCSTVisitor::visitUnaryOp(MiniCParser::UnaryOpContext * ctx)
-{
-    if (ctx->T_SUB()) {
-        return ast_operator_type::AST_OP_NEG;
-    } else {
-        return ast_operator_type::AST_OP_MAX;
-    }
-}
-
-///
-/// @brief 非终结符PrimaryExp的分析
-/// @param ctx CST上下文
-/// @return std::any AST的节点
-///
-std::any MiniCCSTVisitor::visitPrimaryExp(MiniCParser::PrimaryExpContext * ctx)
-{
-    // 识别产生式：primaryExp: T_L_PAREN expr T_R_PAREN | T_DIGIT | lVal;
-
-    // T_L_PAREN expr T_R_PAREN
-    if (ctx->T_L_PAREN()) {
-        return visitExpr(ctx->expr());
-    }
-
-    // T_DIGIT
-    if (ctx->T_DIGIT()) {
-        std::string strVal = ctx->T_DIGIT()->getText();
-        uint32_t intVal = 0;
-
-        // 解析八进制和十六进制数字
-        if (strVal.size() > 1 && strVal[0] == '0') {
-            if (strVal.size() > 2 && (strVal[1] == 'x' || strVal[1] == 'X')) {
-                // 十六进制
-                intVal = std::stoul(strVal, nullptr, 16);
-            } else {
-                // 八进制
-                intVal = std::stoul(strVal, nullptr, 8);
-            }
-        } else {
-            // 十进制
-            intVal = std::stoul(strVal);
-        }
-
-        digit_int_attr digitAttr{intVal, (int64_t) ctx->T_DIGIT()->getSymbol()->getLine()};
-        return ast_node::New(digitAttr);
-    }
-
-    // lVal
-    if (ctx->lVal()) {
-        return visitLVal(ctx->lVal());
-    }
-
-    // 其它情况（语法错误）
-    return nullptr;
-}
-
-std::any MiniCCSTVisitor::visitAssignStatement(MiniCParser::AssignStatementContext * ctx)
-{
-    // 识别文法产生式：assignStatement: lVal T_ASSIGN expr T_SEMICOLON
-
-    // 赋值左侧左值Lval遍历产生节点
-    auto lvalNode = std::any_cast<ast_node *>(visitLVal(ctx->lVal()));
-
-    // 赋值右侧expr遍历
-    auto exprNode = std::any_cast<ast_node *>(visitExpr(ctx->expr()));
-
-    // 创建一个AST_OP_ASSIGN类型的中间节点，孩子为Lval和Expr
-    return ast_node::New(ast_operator_type::AST_OP_ASSIGN, lvalNode, exprNode, nullptr);
-}
-
-std::any MiniCCSTVisitor::visitBlockStatement(MiniCParser::BlockStatementContext * ctx)
-{
-    // 识别文法产生式 blockStatement: block
-
-    return visitBlock(ctx->block());
-}
-
-std::any MiniCCSTVisitor::visitLVal(MiniCParser::LValContext * ctx)
-{
-    // 识别文法产生式：lVal: T_ID;
-    // 获取ID的名字
-    auto varId = ctx->T_ID()->getText();
-
-    // 获取行号
-    int64_t lineNo = (int64_t) ctx->T_ID()->getSymbol()->getLine();
-
-    return ast_node::New(varId, lineNo);
-}
-
-std::any MiniCCSTVisitor::visitVarDecl(MiniCParser::VarDeclContext * ctx)
-{
-    // varDecl: basicType varDef (T_COMMA varDef)* T_SEMICOLON;
-
-    // 声明语句节点
-    ast_node * stmt_node = create_contain_node(ast_operator_type::AST_OP_DECL_STMT);
-
-    // 类型节点
-    type_attr typeAttr = std::any_cast<type_attr>(visitBasicType(ctx->basicType()));
-
-    for (auto & varCtx: ctx->varDef()) {
-        // 变量名节点
-        ast_node * id_node = std::any_cast<ast_node *>(visitVarDef(varCtx));
-
-        // 创建类型节点
-        ast_node * type_node = create_type_node(typeAttr);
-
-        // 创建变量定义节点
-        ast_node * decl_node = ast_node::New(ast_operator_type::AST_OP_VAR_DECL, type_node, id_node, nullptr);
-
-        // 插入到变量声明语句
-        (void) stmt_node->insert_son_node(decl_node);
-    }
-
-    return stmt_node;
-}
-
-std::any MiniCCSTVisitor::visitVarDef(MiniCParser::VarDefContext * ctx)
-{
-    // varDef: T_ID;
-
-    auto varId = ctx->T_ID()->getText();
-
-    // 获取行号
-    int64_t lineNo = (int64_t) ctx->T_ID()->getSymbol()->getLine();
-
-    return ast_node::New(varId, lineNo);
-}
-
-std::any MiniCCSTVisitor::visitBasicType(MiniCParser::BasicTypeContext * ctx)
-{
-    // basicType: T_INT;
-    type_attr attr{BasicType::TYPE_VOID, -1};
-    if (ctx->T_INT()) {
-        attr.type = BasicType::TYPE_INT;
-        attr.lineno = (int64_t) ctx->T_INT()->getSymbol()->getLine();
-    }
-
-    return attr;
-}
-
-std::any MiniCCSTVisitor::visitRealParamList(MiniCParser::RealParamListContext * ctx)
-{
-    // 识别的文法产生式：realParamList : expr (T_COMMA expr)*;
-
-    auto paramListNode = create_contain_node(ast_operator_type::AST_OP_FUNC_REAL_PARAMS);
-
-    for (auto paramCtx: ctx->expr()) {
-
-        auto paramNode = std::any_cast<ast_node *>(visitExpr(paramCtx));
-
-        paramListNode->insert_son_node(paramNode);
-    }
-
-    return paramListNode;
-}
-
-std::any MiniCCSTVisitor::visitExpressionStatement(MiniCParser::ExpressionStatementContext * ctx)
-{
-    // 识别文法产生式  expr ? T_SEMICOLON #expressionStatement;
-    if (ctx->expr()) {
-        // 表达式语句
-
-        // 遍历expr非终结符，创建表达式节点后返回
-        return visitExpr(ctx->expr());
-    } else {
-        // 空语句
-
-        // 直接返回空指针，需要再把语句加入到语句块时要注意判断，空语句不要加入
-        return nullptr;
-    }
-}
\ No newline at end of file
@@ -2,7 +2,7 @@
 /// @file Antlr4Executor.cpp
 /// @brief antlr4的词法与语法分析解析器
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.3
 /// @date 2024-09-29
 ///
 /// @copyright Copyright (c) 2024
@@ -11,51 +11,134 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>先SLL后LL的两阶段分析
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>语法分析时直接产生AST，不构造具体语法树
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>词法与语法错误通过minic_diag输出
 /// </table>
 ///
 #include <iostream>
 
 #include "AST.h"
 #include "Antlr4Executor.h"
-#include "Antlr4CSTVisitor.h"
+#include "Antlr4ASTBuilder.h"
 #include "MiniCLexer.h"
+#include "SourceCharStream.h"
 #include "Common.h"
 
+/// @brief 两阶段分析的统计信息，每个线程各自统计本线程的分析
+thread_local Antlr4Executor::ParseStats Antlr4Executor::stats;
+
+///
+/// @brief 词法与语法错误的监听器，与antlr4的ConsoleErrorListener输出相同的内容，
+/// 但通过minic_diag输出，批量编译时可按源文件收集
+///
+class SyntaxErrorListener : public antlr4::BaseErrorListener {
+
+public:
+    void syntaxError(antlr4::Recognizer * recognizer,
+                     antlr4::Token * offendingSymbol,
+                     size_t line,
+                     size_t charPositionInLine,
+                     const std::string & msg,
+                     std::exception_ptr e) override
+    {
+        (void) recognizer;
+        (void) offendingSymbol;
+        (void) e;
+
+        minic_diag("line %zu:%zu %s\n", line, charPositionInLine, msg.c_str());
+    }
+};
+
 /// @brief 前端词法与语法解析生成AST
 /// @return true: 成功 false：错误
 bool Antlr4Executor::run()
 {
-    std::ifstream ifs;
-    ifs.open(filename);
-    if (!ifs.is_open()) {
-        minic_log(LOG_ERROR, "文件(%s)不能打开，可能不存在", filename.c_str());
+    // 源文件只映射一次
+    if (!source.open(filename)) {
         return false;
     }
 
-    // antlr4的输入流类实例
-    antlr4::ANTLRInputStream input{ifs};
+    // antlr4的输入流类实例，直接建立在源文件缓冲区上，不再解码拷贝为UTF-32串
+    SourceCharStream input{source.view(), filename};
 
     // 词法分析器实例
     MiniCLexer lexer{&input};
 
+    // 词法错误与语法错误都通过minic_diag输出
+    SyntaxErrorListener errorListener;
+    lexer.removeErrorListeners();
+    lexer.addErrorListener(&errorListener);
+
     // 词法分析器实例转化成记号(Token)流
     antlr4::CommonTokenStream tokenStream{&lexer};
 
     // 利用antlr4进行分析，从compileUnit开始分析输入字符串
     MiniCParser parser{&tokenStream};
 
-    // 从具体语法树的根结点进行深度优先遍历，生成抽象语法树
-    auto cstRoot = parser.compileUnit();
-    if (!cstRoot) {
+    auto interpreter = parser.getInterpreter<antlr4::atn::ParserATNSimulator>();
+
+    // 语法分析时由监听器直接产生AST，不再构造具体语法树，也不需要再遍历一次
+    MiniCASTBuilder builder{&tokenStream};
+    parser.setBuildParseTree(false);
+    parser.addParseListener(&builder);
+
+    // 分析前AST的分配位置，重新分析时回退到这里
+    ASTContext::Mark astMark = ast_context->mark();
+
+    // 第一阶段：SLL预测模式，遇到第一个语法错误就放弃，不输出错误信息。
+    // SLL不考虑完整的调用上下文，预测比LL快得多，对绝大多数源程序结果与LL相同
+    interpreter->setPredictionMode(antlr4::atn::PredictionMode::SLL);
+    parser.removeErrorListeners();
+    parser.setErrorHandler(std::make_shared<antlr4::BailErrorStrategy>());
+
+    try {
+        (void) parser.compileUnit();
+        stats.sllParses++;
+    } catch (antlr4::ParseCancellationException &) {
+
+        // 第二阶段：SLL失败时可能是真正的语法错误，也可能是SLL的能力不足，用完整的LL预测模式从头重新分析。
+        // 记号流已经缓存了全部记号，回到开头即可，不需要重新词法分析
+        stats.llFallbacks++;
+
+        // 丢弃第一阶段产生的AST
+        ast_context->rewind(astMark);
+        builder.restart();
+
+        tokenStream.seek(0);
+        parser.reset();
+
+        parser.addErrorListener(&errorListener);
+        parser.setErrorHandler(std::make_shared<antlr4::DefaultErrorStrategy>());
+        interpreter->setPredictionMode(antlr4::atn::PredictionMode::LL);
+
+        (void) parser.compileUnit();
+    }
+
+    stats.decisions = interpreter->decisionToDFA.size();
+    stats.dfaStates = 0;
+    for (auto & dfa: interpreter->decisionToDFA) {
+        stats.dfaStates += dfa.states.size();
+    }
+
+    // 出错恢复后产生的AST不完整，不能使用
+    if ((parser.getNumberOfSyntaxErrors() > 0) || !builder.getRoot()) {
         minic_log(LOG_ERROR, "Antlr4的词语与语法分析错误");
         return false;
     }
 
-    /// 新建遍历器对具体语法树进行分析，产生抽象语法树
-    MiniCCSTVisitor visitor;
-
-    // 遍历产生抽象语法树
-    astRoot = visitor.run(cstRoot);
+    astRoot = builder.getRoot();
 
     return true;
 }
+
+/// @brief 输出两阶段分析的统计信息
+/// @param fp 输出文件
+void Antlr4Executor::printParseStats(FILE * fp)
+{
+    fprintf(fp, "antlr4 parse stats:\n");
+    fprintf(fp, "  SLL parses:      %llu\n", (unsigned long long) stats.sllParses);
+    fprintf(fp, "  LL fallbacks:    %llu\n", (unsigned long long) stats.llFallbacks);
+    fprintf(fp, "  DFA decisions:   %zu\n", stats.decisions);
+    fprintf(fp, "  DFA states:      %zu\n", stats.dfaStates);
+}
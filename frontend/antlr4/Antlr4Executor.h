@@ -2,7 +2,7 @@
 /// @file Antlr4Executor.h
 /// @brief antlr4的词法与语法分析解析器
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.1
 /// @date 2024-09-29
 ///
 /// @copyright Copyright (c) 2024
@@ -11,19 +11,62 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>先SLL后LL的两阶段分析
 /// </table>
 ///
 
+#include <cstdint>
+#include <cstdio>
+
 #include "FrontEndExecutor.h"
 
+///
+/// @brief antlr4前端执行器。先以SLL预测模式快速分析，出错时再以完整的LL预测模式重新分析
+///
 class Antlr4Executor : public FrontEndExecutor {
 public:
+    ///
+    /// @brief 两阶段分析的统计信息，整个进程累计
+    ///
+    struct ParseStats {
+        /// @brief SLL分析成功的次数
+        uint64_t sllParses = 0;
+
+        /// @brief SLL分析失败后改用LL重新分析的次数
+        uint64_t llFallbacks = 0;
+
+        /// @brief 语法分析器的决策点个数
+        size_t decisions = 0;
+
+        /// @brief 语法分析器DFA缓存中的状态数，DFA缓存由同一文法的分析器共享
+        size_t dfaStates = 0;
+    };
+
     Antlr4Executor(std::string filename) : FrontEndExecutor(filename)
     {}
     virtual ~Antlr4Executor()
     {}
 
-    /// @brief 前端词法与语法解析生成AST
+    /// @brief 前端词法与语法分析生成AST
     /// @return true: 成功 false：错误
     bool run() override;
+
+    ///
+    /// @brief 获取当前线程两阶段分析的统计信息
+    /// @return const ParseStats&
+    ///
+    static const ParseStats & getParseStats()
+    {
+        return stats;
+    }
+
+    ///
+    /// @brief 输出两阶段分析的统计信息
+    /// @param fp 输出文件
+    ///
+    static void printParseStats(FILE * fp);
+
+private:
+    /// @brief 两阶段分析的统计信息，每个线程各自统计本线程的分析
+    static thread_local ParseStats stats;
 };
@@ -0,0 +1,138 @@
+///
+/// @file SourceCharStream.cpp
+/// @brief 直接建立在源文件缓冲区上的antlr4字符流的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include "SourceCharStream.h"
+
+/// @brief 构造函数
+/// @param _data 源文件内容
+/// @param _sourceName 源文件名，用于出错信息
+SourceCharStream::SourceCharStream(std::string_view _data, std::string _sourceName)
+    : data(_data), sourceName(std::move(_sourceName))
+{}
+
+/// @brief 前移一个字符
+void SourceCharStream::consume()
+{
+    if (p >= data.size()) {
+        throw antlr4::IllegalStateException("cannot consume EOF");
+    }
+
+    p++;
+}
+
+/// @brief 向前看第i个字符，i为负数时向后看
+/// @param i 偏移
+/// @return 字符，越界时为EOF
+size_t SourceCharStream::LA(ssize_t i)
+{
+    if (i == 0) {
+        // 未定义
+        return 0;
+    }
+
+    ssize_t position = (ssize_t) p;
+    if (i < 0) {
+        // LA(-1)为前一个字符
+        i++;
+        if ((position + i - 1) < 0) {
+            return antlr4::IntStream::EOF;
+        }
+    }
+
+    if ((position + i - 1) >= (ssize_t) data.size()) {
+        return antlr4::IntStream::EOF;
+    }
+
+    return (unsigned char) data[(size_t) (position + i - 1)];
+}
+
+/// @brief 标记位置，全部内容都在内存中，无需缓冲
+/// @return 标记
+ssize_t SourceCharStream::mark()
+{
+    return -1;
+}
+
+/// @brief 释放标记
+/// @param marker 标记
+void SourceCharStream::release(ssize_t)
+{}
+
+/// @brief 当前位置
+/// @return 位置
+size_t SourceCharStream::index()
+{
+    return p;
+}
+
+/// @brief 跳转到指定位置
+/// @param index 位置
+void SourceCharStream::seek(size_t index)
+{
+    // 按字节编码，位置与字符一一对应，可直接跳转
+    p = std::min(index, data.size());
+}
+
+/// @brief 字符个数
+/// @return 字符个数
+size_t SourceCharStream::size()
+{
+    return data.size();
+}
+
+/// @brief 源文件名
+/// @return 源文件名
+std::string SourceCharStream::getSourceName() const
+{
+    if (sourceName.empty()) {
+        return antlr4::IntStream::UNKNOWN_SOURCE_NAME;
+    }
+
+    return sourceName;
+}
+
+/// @brief 获取区间[a, b]内的文本，用于产生Token的文本
+/// @param interval 区间
+/// @return 文本
+std::string SourceCharStream::getText(const antlr4::misc::Interval & interval)
+{
+    if (interval.a < 0 || interval.b < 0) {
+        return "";
+    }
+
+    size_t start = (size_t) interval.a;
+    size_t stop = (size_t) interval.b;
+
+    if (start >= data.size()) {
+        return "";
+    }
+
+    if (stop >= data.size()) {
+        stop = data.size() - 1;
+    }
+
+    if (stop < start) {
+        return "";
+    }
+
+    return std::string(data.substr(start, stop - start + 1));
+}
+
+/// @brief 获取全部文本
+/// @return 文本
+std::string SourceCharStream::toString() const
+{
+    return std::string(data);
+}
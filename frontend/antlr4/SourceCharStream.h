@@ -0,0 +1,87 @@
+///
+/// @file SourceCharStream.h
+/// @brief 直接建立在源文件缓冲区上的antlr4字符流，不拷贝源文件内容
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "antlr4-runtime.h"
+
+///
+/// @brief 零拷贝的antlr4字符流。
+/// ANTLRInputStream会把整个输入解码并拷贝为UTF-32串，这里直接按字节访问SourceBuffer的内容。
+/// MiniC的词法只含ASCII字符，按字节作为码点即可；非ASCII字节按Latin-1码点看待。
+/// 字符流不拥有缓冲区，缓冲区的生命周期须长于词法与语法分析过程。
+///
+class SourceCharStream : public antlr4::CharStream {
+
+public:
+    /// @brief 构造函数
+    /// @param _data 源文件内容
+    /// @param _sourceName 源文件名，用于出错信息
+    SourceCharStream(std::string_view _data, std::string _sourceName);
+
+    /// @brief 前移一个字符
+    void consume() override;
+
+    /// @brief 向前看第i个字符，i为负数时向后看
+    /// @param i 偏移
+    /// @return 字符，越界时为EOF
+    size_t LA(ssize_t i) override;
+
+    /// @brief 标记位置，全部内容都在内存中，无需缓冲
+    /// @return 标记
+    ssize_t mark() override;
+
+    /// @brief 释放标记
+    /// @param marker 标记
+    void release(ssize_t marker) override;
+
+    /// @brief 当前位置
+    /// @return 位置
+    size_t index() override;
+
+    /// @brief 跳转到指定位置
+    /// @param index 位置
+    void seek(size_t index) override;
+
+    /// @brief 字符个数
+    /// @return 字符个数
+    size_t size() override;
+
+    /// @brief 源文件名
+    /// @return 源文件名
+    std::string getSourceName() const override;
+
+    /// @brief 获取区间[a, b]内的文本，用于产生Token的文本
+    /// @param interval 区间
+    /// @return 文本
+    std::string getText(const antlr4::misc::Interval & interval) override;
+
+    /// @brief 获取全部文本
+    /// @return 文本
+    std::string toString() const override;
+
+private:
+    /// @brief 源文件内容
+    std::string_view data;
+
+    /// @brief 源文件名
+    std::string sourceName;
+
+    /// @brief 当前位置
+    size_t p = 0;
+};
@@ -2,7 +2,7 @@
 /// @file BisonParser.h
 /// @brief Bison分析的头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.2
 /// @date 2024-11-21
 ///
 /// @copyright Copyright (c) 2024
@@ -11,25 +11,16 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>纯语法分析器，yyparse的原型由bison生成
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>词法与语法错误通过minic_diag输出
 /// </table>
 ///
 #pragma once
 
 #include "AttrType.h"
 
-/// @brief yyparse的类型声明
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse(void * YYPARSE_PARAM);
-#else
-int yyparse();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse(void);
-#else
-int yyparse();
-#endif
-#endif /* ! YYPARSE_PARAM */
+/// 词法与语法的错误信息通过minic_diag输出，批量编译时按源文件收集
+#include "Common.h"
 
+/// yyparse为纯语法分析器，原型为int yyparse(yyscan_t scanner, ast_node ** root)，由MiniCBison.h声明
 #include "MiniCBison.h"
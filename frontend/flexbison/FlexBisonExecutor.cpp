@@ -11,44 +11,62 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>使用可重入的扫描器与纯语法分析器，可多线程同时分析
 /// </table>
 ///
 #include "FlexBisonExecutor.h"
 #include "BisonParser.h"
 #include "FlexLexer.h"
+#include "Common.h"
 
 /// @brief 前端词法与语法解析生成AST
 /// @return true: 成功 false：错误
 bool FlexBisonExecutor::run()
 {
-    // 若指定有参数，则作为词法分析的输入文件
-    yyin = fopen(filename.c_str(), "r");
-    if (yyin == nullptr) {
-        printf("Can't open file %s\n", filename.c_str());
+    // 源文件只映射一次，flex直接在映射的缓冲区上扫描，不再经过stdio逐块读入与拷贝
+    if (!source.open(filename)) {
         return false;
     }
 
+    // 每次分析创建独立的扫描器，状态全部保存在scanner中，多个线程可同时分析不同的文件
+    yyscan_t scanner;
+    if (yylex_init(&scanner) != 0) {
+        minic_log(LOG_ERROR, "flex扫描器创建失败");
+        return false;
+    }
+
+    // 缓冲区尾部已有两个'\0'，满足yy_scan_buffer的要求；扫描时flex会临时改写缓冲区，映射为写时复制
+    YY_BUFFER_STATE buffer =
+        yy_scan_buffer(source.data(), source.size() + SourceBuffer::PaddingSize, scanner);
+    if (buffer == nullptr) {
+        minic_log(LOG_ERROR, "flex不能扫描文件(%s)的缓冲区", filename.c_str());
+        yylex_destroy(scanner);
+        return false;
+    }
+
+    // yy_scan_buffer不设置缓冲区的行号，这里从第一行开始
+    yyset_lineno(1, scanner);
+
     // 如果要查看LALR的移进与归约过程，请设置yydebug为1
 #ifdef BISON_DEBUG_ENABLE
     yydebug = 1;
 #endif
 
-    // 词法、语法分析生成抽象语法树AST
-    bool result = yyparse();
-    if (0 != result) {
-        printf("yyparse failed\n");
+    // 词法、语法分析生成抽象语法树AST，根节点通过参数返回
+    ast_node * root = nullptr;
+    int result = yyparse(scanner, &root);
 
-        // 关闭文件
-        fclose(yyin);
+    // 释放flex的缓冲区状态与扫描器，缓冲区内存本身归source所有
+    yy_delete_buffer(buffer, scanner);
+    yylex_destroy(scanner);
 
+    if (0 != result) {
+        minic_diag("yyparse failed\n");
         return false;
     }
 
     // 设置抽象语法树的根节点
-    astRoot = ast_root;
-
-    // 关闭文件
-    fclose(yyin);
+    astRoot = root;
 
     return true;
-}
\ No newline at end of file
+}
@@ -2,22 +2,41 @@
 #include <cstdio>
 #include <cstring>
 
-// 词法分析头文件
-#include "FlexLexer.h"
-
 // bison生成的头文件
 #include "BisonParser.h"
 
+// 词法分析头文件，可重入的扫描器要用到YYSTYPE，需在bison生成的头文件之后包含
+#include "FlexLexer.h"
+
 // 抽象语法树函数定义原型头文件
 #include "AST.h"
 
 #include "IntegerType.h"
 
-// LR分析失败时所调用函数的原型声明
-void yyerror(char * msg);
+// LR分析失败时所调用函数的原型声明，参数与yyparse的参数一致
+void yyerror(yyscan_t scanner, ast_node ** root, const char * msg);
 
 %}
 
+// 以下内容放在bison生成的头文件中，yyparse与yylex的参数类型要用到
+%code requires {
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void * yyscan_t;
+#endif
+
+class ast_node;
+}
+
+// 生成纯的（可重入的）语法分析器，yylval、yychar等不再是全局变量，多个线程可同时各自分析
+%define api.pure full
+
+// yylex的参数：可重入的flex扫描器
+%lex-param {yyscan_t scanner}
+
+// yyparse的参数：flex扫描器，以及返回抽象语法树根节点的指针
+%parse-param {yyscan_t scanner} {ast_node ** root}
+
 // 联合体声明，用于后续终结符和非终结符号属性指定使用
 %union {
     class ast_node * node;
@@ -74,26 +93,26 @@ void yyerror(char * msg);
 // compileUnit: funcDef | varDecl | compileUnit funcDef | compileUnit varDecl
 CompileUnit : FuncDef {
 
-		// 创建一个编译单元的节点AST_OP_COMPILE_UNIT
-		$$ = create_contain_node(ast_operator_type::AST_OP_COMPILE_UNIT, $1);
+		// 创建一个编译单元的节点AST_OP_COMPILE_UNIT，流式编译时函数定义直接交给后续处理
+		$$ = add_compile_unit_item(nullptr, $1);
 
-		// 设置到全局变量中
-		ast_root = $$;
+		// 设置到返回的根节点中
+		*root = $$;
 	}
 	| VarDecl {
 
-		// 创建一个编译单元的节点AST_OP_COMPILE_UNIT
-		$$ = create_contain_node(ast_operator_type::AST_OP_COMPILE_UNIT, $1);
-		ast_root = $$;
+		// 创建一个编译单元的节点AST_OP_COMPILE_UNIT，流式编译时变量定义直接交给后续处理
+		$$ = add_compile_unit_item(nullptr, $1);
+		*root = $$;
 	}
 	| CompileUnit FuncDef {
 
 		// 把函数定义的节点作为编译单元的孩子
-		$$ = $1->insert_son_node($2);
+		$$ = add_compile_unit_item($1, $2);
 	}
 	| CompileUnit VarDecl {
 		// 把变量定义的节点作为编译单元的孩子
-		$$ = $1->insert_son_node($2);
+		$$ = add_compile_unit_item($1, $2);
 	}
 	;
 
@@ -113,7 +132,6 @@ FuncDef : BasicType T_ID T_L_PAREN T_R_PAREN Block  {
 		ast_node * formalParamsNode = nullptr;
 
 		// 创建函数定义的节点，孩子有类型，函数名，语句块和形参(实际上无)
-		// create_func_def函数内会释放funcId中指向的标识符空间，切记，之后不要再释放，之前一定要是通过strdup函数或者malloc分配的空间
 		$$ = create_func_def(funcReturnType, funcId, blockNode, formalParamsNode);
 	}
 	;
@@ -203,9 +221,6 @@ VarDef : T_ID {
 		// 变量ID
 
 		$$ = ast_node::New(var_id_attr{$1.id, $1.lineno});
-
-		// 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-		free($1.id);
 	}
 	;
 
@@ -342,10 +357,7 @@ UnaryExp : PrimaryExp {
 		// 没有实参的函数调用
 
 		// 创建函数调用名终结符节点
-		ast_node * name_node = ast_node::New(std::string($1.id), $1.lineno);
-
-		// 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-		free($1.id);
+		ast_node * name_node = ast_node::New($1);
 
 		// 实参列表
 		ast_node * paramListNode = nullptr;
@@ -358,10 +370,7 @@ UnaryExp : PrimaryExp {
 		// 含有实参的函数调用
 
 		// 创建函数调用名终结符节点
-		ast_node * name_node = ast_node::New(std::string($1.id), $1.lineno);
-
-		// 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-		free($1.id);
+		ast_node * name_node = ast_node::New($1);
 
 		// 实参列表
 		ast_node * paramListNode = $3;
@@ -417,16 +426,15 @@ LVal : T_ID {
 
 		// 创建变量名终结符节点
 		$$ = ast_node::New($1);
-
-		// 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-		free($1.id);
 	}
 	;
 
 %%
 
 // 语法识别错误要调用函数的定义
-void yyerror(char * msg)
+void yyerror(yyscan_t scanner, ast_node ** root, const char * msg)
 {
-    printf("Line %d: %s\n", yylineno, msg);
+    (void) root;
+
+    minic_diag("Line %d: %s\n", yyget_lineno(scanner), msg);
 }
@@ -55,7 +55,7 @@
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -72,19 +72,19 @@
 #include <cstdio>
 #include <cstring>
 
-// 词法分析头文件
-#include "FlexLexer.h"
-
 // bison生成的头文件
 #include "BisonParser.h"
 
+// 词法分析头文件，可重入的扫描器要用到YYSTYPE，需在bison生成的头文件之后包含
+#include "FlexLexer.h"
+
 // 抽象语法树函数定义原型头文件
 #include "AST.h"
 
 #include "IntegerType.h"
 
-// LR分析失败时所调用函数的原型声明
-void yyerror(char * msg);
+// LR分析失败时所调用函数的原型声明，参数与yyparse的参数一致
+void yyerror(yyscan_t scanner, ast_node ** root, const char * msg);
 
 
 #line 91 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
@@ -541,11 +541,11 @@ static const yytype_int8 yytranslate[] =
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,    75,    75,    83,    89,    94,   101,   124,   130,   141,
-     146,   155,   159,   170,   176,   188,   202,   213,   222,   228,
-     234,   240,   246,   256,   266,   272,   278,   287,   290,   299,
-     305,   311,   320,   323,   326,   335,   341,   357,   372,   382,
-     386,   392,   404,   408,   415
+       0,    94,    94,   102,   108,   113,   120,   142,   148,   159,
+     164,   173,   177,   188,   194,   206,   220,   228,   237,   243,
+     249,   255,   261,   271,   281,   287,   293,   302,   305,   314,
+     320,   326,   335,   338,   341,   350,   356,   369,   381,   391,
+     395,   401,   413,   417,   424
 };
 #endif
 
@@ -719,7 +719,7 @@ enum { YYENOMEM = -2 };
       }                                                           \
     else                                                          \
       {                                                           \
-        yyerror (YY_("syntax error: cannot back up")); \
+        yyerror (scanner, root, YY_("syntax error: cannot back up")); \
         YYERROR;                                                  \
       }                                                           \
   while (0)
@@ -752,7 +752,7 @@ do {                                                                      \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Kind, Value); \
+                  Kind, Value, scanner, root); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
@@ -764,10 +764,12 @@ do {                                                                      \
 
 static void
 yy_symbol_value_print (FILE *yyo,
-                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, yyscan_t scanner, ast_node ** root)
 {
   FILE *yyoutput = yyo;
   YY_USE (yyoutput);
+  YY_USE (scanner);
+  YY_USE (root);
   if (!yyvaluep)
     return;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
@@ -782,12 +784,12 @@ yy_symbol_value_print (FILE *yyo,
 
 static void
 yy_symbol_print (FILE *yyo,
-                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, yyscan_t scanner, ast_node ** root)
 {
   YYFPRINTF (yyo, "%s %s (",
              yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  yy_symbol_value_print (yyo, yykind, yyvaluep, scanner, root);
   YYFPRINTF (yyo, ")");
 }
 
@@ -821,7 +823,7 @@ do {                                                            \
 
 static void
 yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
-                 int yyrule)
+                 int yyrule, yyscan_t scanner, ast_node ** root)
 {
   int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
@@ -834,7 +836,7 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
                        YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
-                       &yyvsp[(yyi + 1) - (yynrhs)]);
+                       &yyvsp[(yyi + 1) - (yynrhs)], scanner, root);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -842,7 +844,7 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, Rule, scanner, root); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
@@ -883,9 +885,11 @@ int yydebug;
 
 static void
 yydestruct (const char *yymsg,
-            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, yyscan_t scanner, ast_node ** root)
 {
   YY_USE (yyvaluep);
+  YY_USE (scanner);
+  YY_USE (root);
   if (!yymsg)
     yymsg = "Deleting";
   YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
@@ -896,13 +900,6 @@ yydestruct (const char *yymsg,
 }
 
 
-/* Lookahead token kind.  */
-int yychar;
-
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-/* Number of syntax errors so far.  */
-int yynerrs;
 
 
 
@@ -912,8 +909,21 @@ int yynerrs;
 `----------*/
 
 int
-yyparse (void)
+yyparse (yyscan_t scanner, ast_node ** root)
 {
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
     yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
     int yyerrstatus = 0;
@@ -1066,7 +1076,7 @@ yybackup:
   if (yychar == YYEMPTY)
     {
       YYDPRINTF ((stderr, "Reading a token\n"));
-      yychar = yylex ();
+      yychar = yylex (&yylval, scanner);
     }
 
   if (yychar <= YYEOF)
@@ -1154,50 +1164,50 @@ yyreduce:
   switch (yyn)
     {
   case 2: /* CompileUnit: FuncDef  */
-#line 75 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 94 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                       {
 
-		// 创建一个编译单元的节点AST_OP_COMPILE_UNIT
-		(yyval.node) = create_contain_node(ast_operator_type::AST_OP_COMPILE_UNIT, (yyvsp[0].node));
+		// 创建一个编译单元的节点AST_OP_COMPILE_UNIT，流式编译时函数定义直接交给后续处理
+		(yyval.node) = add_compile_unit_item(nullptr, (yyvsp[0].node));
 
-		// 设置到全局变量中
-		ast_root = (yyval.node);
+		// 设置到返回的根节点中
+		*root = (yyval.node);
 	}
-#line 1167 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1177 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 3: /* CompileUnit: VarDecl  */
-#line 83 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 102 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                   {
 
-		// 创建一个编译单元的节点AST_OP_COMPILE_UNIT
-		(yyval.node) = create_contain_node(ast_operator_type::AST_OP_COMPILE_UNIT, (yyvsp[0].node));
-		ast_root = (yyval.node);
+		// 创建一个编译单元的节点AST_OP_COMPILE_UNIT，流式编译时变量定义直接交给后续处理
+		(yyval.node) = add_compile_unit_item(nullptr, (yyvsp[0].node));
+		*root = (yyval.node);
 	}
-#line 1178 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1188 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 4: /* CompileUnit: CompileUnit FuncDef  */
-#line 89 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 108 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                               {
 
 		// 把函数定义的节点作为编译单元的孩子
-		(yyval.node) = (yyvsp[-1].node)->insert_son_node((yyvsp[0].node));
+		(yyval.node) = add_compile_unit_item((yyvsp[-1].node), (yyvsp[0].node));
 	}
-#line 1188 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1198 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 5: /* CompileUnit: CompileUnit VarDecl  */
-#line 94 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 113 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                               {
 		// 把变量定义的节点作为编译单元的孩子
-		(yyval.node) = (yyvsp[-1].node)->insert_son_node((yyvsp[0].node));
+		(yyval.node) = add_compile_unit_item((yyvsp[-1].node), (yyvsp[0].node));
 	}
-#line 1197 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1207 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 6: /* FuncDef: BasicType T_ID T_L_PAREN T_R_PAREN Block  */
-#line 101 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 120 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                                     {
 
 		// 函数返回类型
@@ -1213,81 +1223,80 @@ yyreduce:
 		ast_node * formalParamsNode = nullptr;
 
 		// 创建函数定义的节点，孩子有类型，函数名，语句块和形参(实际上无)
-		// create_func_def函数内会释放funcId中指向的标识符空间，切记，之后不要再释放，之前一定要是通过strdup函数或者malloc分配的空间
 		(yyval.node) = create_func_def(funcReturnType, funcId, blockNode, formalParamsNode);
 	}
-#line 1220 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1229 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 7: /* Block: T_L_BRACE T_R_BRACE  */
-#line 124 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 142 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                             {
 		// 语句块没有语句
 
 		// 为了方便创建一个空的Block节点
 		(yyval.node) = create_contain_node(ast_operator_type::AST_OP_BLOCK);
 	}
-#line 1231 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1240 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 8: /* Block: T_L_BRACE BlockItemList T_R_BRACE  */
-#line 130 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 148 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                             {
 		// 语句块含有语句
 
 		// BlockItemList归约时内部创建Block节点，并把语句加入，这里不创建Block节点
 		(yyval.node) = (yyvsp[-1].node);
 	}
-#line 1242 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1251 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 9: /* BlockItemList: BlockItem  */
-#line 141 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 159 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                           {
 		// 第一个左侧的孩子节点归约成Block节点，后续语句可持续作为孩子追加到Block节点中
 		// 创建一个AST_OP_BLOCK类型的中间节点，孩子为Statement($1)
 		(yyval.node) = create_contain_node(ast_operator_type::AST_OP_BLOCK, (yyvsp[0].node));
 	}
-#line 1252 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1261 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 10: /* BlockItemList: BlockItemList BlockItem  */
-#line 146 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 164 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                   {
 		// 把BlockItem归约的节点加入到BlockItemList的节点中
 		(yyval.node) = (yyvsp[-1].node)->insert_son_node((yyvsp[0].node));
 	}
-#line 1261 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1270 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 11: /* BlockItem: Statement  */
-#line 155 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 173 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                        {
 		// 语句节点传递给归约后的节点上，综合属性
 		(yyval.node) = (yyvsp[0].node);
 	}
-#line 1270 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1279 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 12: /* BlockItem: VarDecl  */
-#line 159 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 177 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                   {
 		// 变量声明节点传递给归约后的节点上，综合属性
 		(yyval.node) = (yyvsp[0].node);
 	}
-#line 1279 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1288 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 13: /* VarDecl: VarDeclExpr T_SEMICOLON  */
-#line 170 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 188 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                   {
 		(yyval.node) = (yyvsp[-1].node);
 	}
-#line 1287 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1296 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 14: /* VarDeclExpr: BasicType VarDef  */
-#line 176 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 194 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                               {
 
 		// 创建类型节点
@@ -1300,11 +1309,11 @@ yyreduce:
 		// 创建变量声明语句，并加入第一个变量
 		(yyval.node) = create_var_decl_stmt_node(decl_node);
 	}
-#line 1304 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1313 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 15: /* VarDeclExpr: VarDeclExpr T_COMMA VarDef  */
-#line 188 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 206 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                      {
 
 		// 创建类型节点，这里从VarDeclExpr获取类型，前面已经设置
@@ -1316,221 +1325,215 @@ yyreduce:
 		// 插入到变量声明语句
 		(yyval.node) = (yyvsp[-2].node)->insert_son_node(decl_node);
 	}
-#line 1320 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1329 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 16: /* VarDef: T_ID  */
-#line 202 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 220 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
               {
 		// 变量ID
 
 		(yyval.node) = ast_node::New(var_id_attr{(yyvsp[0].var_id).id, (yyvsp[0].var_id).lineno});
-
-		// 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-		free((yyvsp[0].var_id).id);
 	}
-#line 1333 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1339 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 17: /* BasicType: T_INT  */
-#line 213 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 228 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                  {
 		(yyval.type) = (yyvsp[0].type);
 	}
-#line 1341 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1347 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 18: /* Statement: T_RETURN Expr T_SEMICOLON  */
-#line 222 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 237 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                       {
 		// 返回语句
 
 		// 创建返回节点AST_OP_RETURN，其孩子为Expr，即$2
 		(yyval.node) = create_contain_node(ast_operator_type::AST_OP_RETURN, (yyvsp[-1].node));
 	}
-#line 1352 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1358 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 19: /* Statement: LVal T_ASSIGN Expr T_SEMICOLON  */
-#line 228 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 243 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                          {
 		// 赋值语句
 
 		// 创建一个AST_OP_ASSIGN类型的中间节点，孩子为LVal($1)和Expr($3)
 		(yyval.node) = create_contain_node(ast_operator_type::AST_OP_ASSIGN, (yyvsp[-3].node), (yyvsp[-1].node));
 	}
-#line 1363 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1369 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 20: /* Statement: Block  */
-#line 234 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 249 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                 {
 		// 语句块
 
 		// 内部已创建block节点，直接传递给Statement
 		(yyval.node) = (yyvsp[0].node);
 	}
-#line 1374 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1380 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 21: /* Statement: Expr T_SEMICOLON  */
-#line 240 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 255 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                            {
 		// 表达式语句
 
 		// 内部已创建表达式，直接传递给Statement
 		(yyval.node) = (yyvsp[-1].node);
 	}
-#line 1385 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1391 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 22: /* Statement: T_SEMICOLON  */
-#line 246 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 261 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                       {
 		// 空语句
 
 		// 直接返回空指针，需要再把语句加入到语句块时要注意判断，空语句不要加入
 		(yyval.node) = nullptr;
 	}
-#line 1396 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1402 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 23: /* Expr: AddExp  */
-#line 256 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 271 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
               {
 		// 直接传递给归约后的节点
 		(yyval.node) = (yyvsp[0].node);
 	}
-#line 1405 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1411 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 24: /* AddExp: MulExp  */
-#line 266 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 281 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                 {
 		// 乘除模表达式
 
 		// 直接传递到归约后的节点
 		(yyval.node) = (yyvsp[0].node);
 	}
-#line 1416 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1422 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 25: /* AddExp: MulExp AddOp MulExp  */
-#line 272 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 287 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                               {
 		// 两个乘除模表达式的加减运算
 
 		// 创建加减运算节点，其孩子为两个乘除模表达式节点
 		(yyval.node) = create_contain_node(ast_operator_type((yyvsp[-1].op_class)), (yyvsp[-2].node), (yyvsp[0].node));
 	}
-#line 1427 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1433 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 26: /* AddExp: AddExp AddOp MulExp  */
-#line 278 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 293 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                               {
 		// 左递归形式可通过加减连接多个乘除模表达式
 
 		// 创建加减运算节点，孩子为AddExp($1)和MulExp($3)
 		(yyval.node) = create_contain_node(ast_operator_type((yyvsp[-1].op_class)), (yyvsp[-2].node), (yyvsp[0].node));
 	}
-#line 1438 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1444 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 27: /* AddOp: T_ADD  */
-#line 287 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 302 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
              {
 		(yyval.op_class) = (int)ast_operator_type::AST_OP_ADD;
 	}
-#line 1446 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1452 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 28: /* AddOp: T_SUB  */
-#line 290 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 305 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                 {
 		(yyval.op_class) = (int)ast_operator_type::AST_OP_SUB;
 	}
-#line 1454 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1460 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 29: /* MulExp: UnaryExp  */
-#line 299 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 314 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                   {
 		// 一元表达式
 
 		// 直接传递到归约后的节点
 		(yyval.node) = (yyvsp[0].node);
 	}
-#line 1465 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1471 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 30: /* MulExp: UnaryExp MulOp UnaryExp  */
-#line 305 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 320 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                   {
 		// 两个一元表达式的乘除模运算
 
 		// 创建乘除模运算节点，其孩子为两个一元表达式节点
 		(yyval.node) = create_contain_node(ast_operator_type((yyvsp[-1].op_class)), (yyvsp[-2].node), (yyvsp[0].node));
 	}
-#line 1476 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1482 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 31: /* MulExp: MulExp MulOp UnaryExp  */
-#line 311 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 326 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                 {
 		// 左递归形式可通过乘除模连接多个一元表达式
 
 		// 创建乘除模运算节点，孩子为MulExp($1)和UnaryExp($3)
 		(yyval.node) = create_contain_node(ast_operator_type((yyvsp[-1].op_class)), (yyvsp[-2].node), (yyvsp[0].node));
 	}
-#line 1487 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1493 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 32: /* MulOp: T_MUL  */
-#line 320 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 335 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
              {
 		(yyval.op_class) = (int)ast_operator_type::AST_OP_MUL;
 	}
-#line 1495 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1501 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 33: /* MulOp: T_DIV  */
-#line 323 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 338 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                 {
 		(yyval.op_class) = (int)ast_operator_type::AST_OP_DIV;
 	}
-#line 1503 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1509 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 34: /* MulOp: T_MOD  */
-#line 326 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 341 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                 {
 		(yyval.op_class) = (int)ast_operator_type::AST_OP_MOD;
 	}
-#line 1511 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1517 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 35: /* UnaryExp: PrimaryExp  */
-#line 335 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 350 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                       {
 		// 基本表达式
 
 		// 传递到归约后的UnaryExp上
 		(yyval.node) = (yyvsp[0].node);
 	}
-#line 1522 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1528 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 36: /* UnaryExp: T_ID T_L_PAREN T_R_PAREN  */
-#line 341 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 356 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                    {
 		// 没有实参的函数调用
 
 		// 创建函数调用名终结符节点
-		ast_node * name_node = ast_node::New(std::string((yyvsp[-2].var_id).id), (yyvsp[-2].var_id).lineno);
-
-		// 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-		free((yyvsp[-2].var_id).id);
+		ast_node * name_node = ast_node::New((yyvsp[-2].var_id));
 
 		// 实参列表
 		ast_node * paramListNode = nullptr;
@@ -1539,19 +1542,16 @@ yyreduce:
 		(yyval.node) = create_func_call(name_node, paramListNode);
 
 	}
-#line 1543 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1546 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
   case 37: /* UnaryExp: T_ID T_L_PAREN RealParamList T_R_PAREN  */
-#line 357 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 369 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                                  {
 		// 含有实参的函数调用
 
 		// 创建函数调用名终结符节点
-		ast_node * name_node = ast_node::New(std::string((yyvsp[-3].var_id).id), (yyvsp[-3].var_id).lineno);
-
-		// 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-		free((yyvsp[-3].var_id).id);
+		ast_node * name_node = ast_node::New((yyvsp[-3].var_id));
 
 		// 实参列表
 		ast_node * paramListNode = (yyvsp[-1].node);
@@ -1563,7 +1563,7 @@ yyreduce:
     break;
 
   case 38: /* UnaryExp: T_SUB UnaryExp  */
-#line 372 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 381 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                          {
 		// 一元负号运算
 
@@ -1574,7 +1574,7 @@ yyreduce:
     break;
 
   case 39: /* PrimaryExp: T_L_PAREN Expr T_R_PAREN  */
-#line 382 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 391 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                        {
 		// 带有括号的表达式
 		(yyval.node) = (yyvsp[-1].node);
@@ -1583,7 +1583,7 @@ yyreduce:
     break;
 
   case 40: /* PrimaryExp: T_DIGIT  */
-#line 386 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 395 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                   {
         	// 无符号整型字面量
 
@@ -1594,7 +1594,7 @@ yyreduce:
     break;
 
   case 41: /* PrimaryExp: LVal  */
-#line 392 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 401 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                 {
 		// 具有左值的表达式
 
@@ -1605,7 +1605,7 @@ yyreduce:
     break;
 
   case 42: /* RealParamList: Expr  */
-#line 404 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 413 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                      {
 		// 创建实参列表节点，并把当前的Expr节点加入
 		(yyval.node) = create_contain_node(ast_operator_type::AST_OP_FUNC_REAL_PARAMS, (yyvsp[0].node));
@@ -1614,7 +1614,7 @@ yyreduce:
     break;
 
   case 43: /* RealParamList: RealParamList T_COMMA Expr  */
-#line 408 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 417 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
                                      {
 		// 左递归增加实参表达式
 		(yyval.node) = (yyvsp[-2].node)->insert_son_node((yyvsp[0].node));
@@ -1623,21 +1623,18 @@ yyreduce:
     break;
 
   case 44: /* LVal: T_ID  */
-#line 415 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 424 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
             {
 		// 变量名终结符
 
 		// 创建变量名终结符节点
 		(yyval.node) = ast_node::New((yyvsp[0].var_id));
-
-		// 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串复制
-		free((yyvsp[0].var_id).id);
 	}
-#line 1637 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1634 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
     break;
 
 
-#line 1641 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
+#line 1638 "/home/code/exp04-minic-expr/frontend/flexbison/autogenerated/MiniCBison.cpp"
 
       default: break;
     }
@@ -1684,7 +1681,7 @@ yyerrlab:
   if (!yyerrstatus)
     {
       ++yynerrs;
-      yyerror (YY_("syntax error"));
+      yyerror (scanner, root, YY_("syntax error"));
     }
 
   if (yyerrstatus == 3)
@@ -1701,7 +1698,7 @@ yyerrlab:
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval);
+                      yytoken, &yylval, scanner, root);
           yychar = YYEMPTY;
         }
     }
@@ -1757,7 +1754,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, scanner, root);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -1795,7 +1792,7 @@ yyabortlab:
 | yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
 `-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (scanner, root, YY_("memory exhausted"));
   yyresult = 2;
   goto yyreturnlab;
 
@@ -1810,7 +1807,7 @@ yyreturnlab:
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval);
+                  yytoken, &yylval, scanner, root);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -1819,7 +1816,7 @@ yyreturnlab:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, scanner, root);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
@@ -1830,11 +1827,13 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 426 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
+#line 432 "/home/code/exp04-minic-expr/frontend/flexbison/MiniC.y"
 
 
 // 语法识别错误要调用函数的定义
-void yyerror(char * msg)
+void yyerror(yyscan_t scanner, ast_node ** root, const char * msg)
 {
-    printf("Line %d: %s\n", yylineno, msg);
+    (void) root;
+
+    minic_diag("Line %d: %s\n", yyget_lineno(scanner), msg);
 }
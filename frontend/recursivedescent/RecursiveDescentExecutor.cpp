@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>分析状态放入上下文，可多线程同时分析
 /// </table>
 ///
 #include "RecursiveDescentExecutor.h"
@@ -21,28 +22,16 @@
 /// @return true: 成功 false：错误
 bool RecursiveDescentExecutor::run()
 {
-    // 若指定有参数，则作为词法分析的输入文件
-    rd_filein = fopen(filename.c_str(), "r");
-    if (rd_filein == nullptr) {
-        printf("Can't open file %s\n", filename.c_str());
+    // 源文件只映射一次，词法分析直接在缓冲区上移动指针
+    if (!source.open(filename)) {
         return false;
     }
 
-    // 如果要查看LALR的移进与归约过程，请设置yydebug为1
-    // yydebug = 1;
-
     // 词法、语法分析生成抽象语法树AST
-    astRoot = rd_parse();
+    astRoot = rd_parse(source.data(), source.size());
     if (!astRoot) {
-
-        // 关闭文件
-        fclose(rd_filein);
-
         return false;
     }
 
-    // 关闭文件
-    fclose(rd_filein);
-
     return true;
-}
\ No newline at end of file
+}
@@ -2,8 +2,8 @@
 /// @file RecursiveDescentFlex.cpp
 /// @brief 词法分析的手动实现源文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.3
+/// @date 2026-10-15
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,190 +12,444 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>表驱动扫描、SIMD跳过空白与标识符、关键字完美哈希
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>扫描状态放入上下文，可多线程同时分析
 /// </table>
 ///
-#include <cctype>
+#include <array>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <string>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "RecursiveDescentFlex.h"
 #include "RecursiveDescentParser.h"
 #include "Common.h"
 
-/// @brief 词法分析的行号信息
-int64_t rd_line_no = 1;
+/// @brief 字符的类别，扫描器按类别而不是逐个字符进行分支
+enum CharClass : uint8_t {
+    CC_OTHER,   // 非法字符
+    CC_SPACE,   // 空格、TAB等不影响行号的空白符
+    CC_LF,      // \n
+    CC_CR,      // \r
+    CC_DIGIT,   // 0-9
+    CC_IDSTART, // 字母或下划线
+    CC_PUNCT,   // 单字符的运算符或界符
+};
+
+/// @brief 字符类别表与单字符Token表
+struct ScanTables {
+    std::array<uint8_t, 256> charClass{};
+    std::array<int8_t, 256> punctToken{};
+};
+
+/// @brief 构造字符类别表与单字符Token表
+/// @return 表
+static constexpr ScanTables buildScanTables()
+{
+    ScanTables t{};
+
+    t.charClass[(uint8_t) ' '] = CC_SPACE;
+    t.charClass[(uint8_t) '\t'] = CC_SPACE;
+    t.charClass[(uint8_t) '\v'] = CC_SPACE;
+    t.charClass[(uint8_t) '\f'] = CC_SPACE;
+    t.charClass[(uint8_t) '\n'] = CC_LF;
+    t.charClass[(uint8_t) '\r'] = CC_CR;
+
+    for (int c = '0'; c <= '9'; c++) {
+        t.charClass[c] = CC_DIGIT;
+    }
+
+    for (int c = 'a'; c <= 'z'; c++) {
+        t.charClass[c] = CC_IDSTART;
+        t.charClass[c - 'a' + 'A'] = CC_IDSTART;
+    }
+    t.charClass[(uint8_t) '_'] = CC_IDSTART;
+
+    const struct {
+        char ch;
+        RDTokenType type;
+    } puncts[] = {
+        {'(', RDTokenType::T_L_PAREN},
+        {')', RDTokenType::T_R_PAREN},
+        {'{', RDTokenType::T_L_BRACE},
+        {'}', RDTokenType::T_R_BRACE},
+        {';', RDTokenType::T_SEMICOLON},
+        {',', RDTokenType::T_COMMA},
+        {'=', RDTokenType::T_ASSIGN},
+        {'+', RDTokenType::T_ADD},
+        {'-', RDTokenType::T_SUB},
+    };
+
+    for (auto & punct: puncts) {
+        t.charClass[(uint8_t) punct.ch] = CC_PUNCT;
+        t.punctToken[(uint8_t) punct.ch] = (int8_t) punct.type;
+    }
 
-/// @brief 词法分析的token对应的字符识别
-std::string tokenValue;
+    return t;
+}
 
-/// @brief 输入源文件指针
-FILE * rd_filein;
+/// @brief 字符类别表与单字符Token表，编译期生成
+static constexpr ScanTables scanTables = buildScanTables();
 
 /// @brief 关键字与Token类别的数据结构
 struct KeywordToken {
-    std::string name;
+    const char * name;
+    uint8_t length;
     enum RDTokenType type;
 };
 
 /// @brief  关键字与Token对应表
-static KeywordToken allKeywords[] = {
-    {"int", RDTokenType::T_INT},
-    {"return", RDTokenType::T_RETURN},
+static constexpr KeywordToken allKeywords[] = {
+    {"int", 3, RDTokenType::T_INT},
+    {"return", 6, RDTokenType::T_RETURN},
 };
 
+/// @brief 关键字数目
+static constexpr size_t KeywordCount = sizeof(allKeywords) / sizeof(allKeywords[0]);
+
+/// @brief 关键字哈希表的大小，必须是2的幂
+static constexpr size_t KeywordTableSize = 16;
+
+/// @brief 关键字的哈希函数，只用长度与首尾字符
+/// @param s 标识符首地址
+/// @param len 标识符长度，大于0
+/// @return 哈希值
+static constexpr uint32_t keywordHash(const char * s, size_t len)
+{
+    return (uint32_t) (len + (uint8_t) s[0] * 3u + (uint8_t) s[len - 1]) & (KeywordTableSize - 1);
+}
+
+/// @brief 构造关键字的哈希表，存放关键字在allKeywords中的下标，-1表示空
+/// @return 哈希表
+static constexpr std::array<int8_t, KeywordTableSize> buildKeywordTable()
+{
+    std::array<int8_t, KeywordTableSize> table{};
+
+    for (auto & slot: table) {
+        slot = -1;
+    }
+
+    for (size_t i = 0; i < KeywordCount; i++) {
+        table[keywordHash(allKeywords[i].name, allKeywords[i].length)] = (int8_t) i;
+    }
+
+    return table;
+}
+
+/// @brief 检查关键字的哈希没有冲突，即为完美哈希
+/// @return true：没有冲突，false：有冲突
+static constexpr bool keywordHashIsPerfect()
+{
+    for (size_t i = 0; i < KeywordCount; i++) {
+        for (size_t j = i + 1; j < KeywordCount; j++) {
+            if (keywordHash(allKeywords[i].name, allKeywords[i].length) ==
+                keywordHash(allKeywords[j].name, allKeywords[j].length)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static_assert(keywordHashIsPerfect(), "关键字的哈希有冲突，请调整keywordHash或KeywordTableSize");
+
+/// @brief 关键字哈希表，编译期生成
+static constexpr std::array<int8_t, KeywordTableSize> keywordTable = buildKeywordTable();
+
 /// @brief 在标识符中检查是否时关键字，若是关键字则返回对应关键字的Token，否则返回T_ID
-/// @param id 标识符
+/// @param id 标识符首地址
+/// @param len 标识符长度
 /// @return Token
-static RDTokenType getKeywordToken(std::string id)
+static RDTokenType getKeywordToken(const char * id, size_t len)
 {
-    //如果在allkeywords中找到，则说明为关键字
-    for (auto & keyword: allKeywords) {
-        if (keyword.name == id) {
-            return keyword.type;
-        }
+    int index = keywordTable[keywordHash(id, len)];
+
+    // 哈希无冲突，只需与槽中的一个关键字比较
+    if ((index >= 0) && (allKeywords[index].length == len) && (memcmp(allKeywords[index].name, id, len) == 0)) {
+        return allKeywords[index].type;
     }
+
     // 如果不再allkeywords中，说明是标识符
     return RDTokenType::T_ID;
 }
 
-/// @brief 词法文法，获取下一个Token
-/// @return  Token，值保存在rd_lval中
-int rd_flex()
+/// @brief 设置词法分析的输入缓冲区，并复位行号
+/// @param ctx 词法分析上下文
+/// @param buf 源文件内容首地址
+/// @param len 源文件内容的字节数
+void rd_flex_init(RDFlexContext & ctx, const char * buf, size_t len)
 {
-    int c;              // 扫描的字符
-    int tokenKind = -1; // Token的值
+    ctx.base = buf;
+    ctx.cursor = buf;
+    ctx.limit = buf + len;
+    ctx.lineNo = 1;
+    ctx.token = {0, 0};
+}
 
-    // 忽略空白符号，主要有空格，TAB键和换行符
-    while ((c = fgetc(rd_filein)) == ' ' || c == '\t' || c == '\n' || c == '\r') {
-
-        // 支持Linux/Windows/Mac系统的行号分析
-        // Windows：\r\n
-        // Mac: \n
-        // Unix(Linux): \r
-        if (c == '\r') {
-            c = fgetc(rd_filein);
-            rd_line_no++;
-            if (c != '\n') {
-                // 不是\n，则回退
-                ungetc(c, rd_filein);
-            }
-        } else if (c == '\n') {
-            rd_line_no++;
+/// @brief 获取当前Token的原始文本
+/// @param ctx 词法分析上下文
+/// @return 文本视图，指向输入缓冲区
+std::string_view rd_token_text(const RDFlexContext & ctx)
+{
+    return std::string_view(ctx.base + ctx.token.offset, ctx.token.length);
+}
+
+#if defined(__AVX2__)
+/// @brief 一次比较的字节数
+static constexpr size_t SimdWidth = 32;
+#elif defined(__SSE2__)
+/// @brief 一次比较的字节数
+static constexpr size_t SimdWidth = 16;
+#endif
+
+/// @brief 跳过空格、TAB与\n，统计其中的换行数。遇到其它字符（含\r）停止
+/// @param ctx 词法分析上下文
+/// @param p 起始位置
+/// @return 第一个不是上述空白符的位置
+static const char * skipBlanks(RDFlexContext & ctx, const char * p)
+{
+#if defined(__AVX2__)
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i lf = _mm256_set1_epi8('\n');
+
+    while ((size_t) (ctx.limit - p) >= SimdWidth) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i *) p);
+        __m256i isLf = _mm256_cmpeq_epi8(chunk, lf);
+        __m256i isBlank =
+            _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, space), _mm256_cmpeq_epi8(chunk, tab)), isLf);
+
+        uint32_t blankMask = (uint32_t) _mm256_movemask_epi8(isBlank);
+        uint32_t lfMask = (uint32_t) _mm256_movemask_epi8(isLf);
+
+        if (blankMask != 0xFFFFFFFFu) {
+            // 第一个非空白符之前的部分
+            unsigned n = (unsigned) __builtin_ctz(~blankMask);
+            ctx.lineNo += __builtin_popcount(lfMask & ((1u << n) - 1));
+            return p + n;
         }
+
+        ctx.lineNo += __builtin_popcount(lfMask);
+        p += SimdWidth;
     }
+#elif defined(__SSE2__)
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i lf = _mm_set1_epi8('\n');
+
+    while ((size_t) (ctx.limit - p) >= SimdWidth) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *) p);
+        __m128i isLf = _mm_cmpeq_epi8(chunk, lf);
+        __m128i isBlank = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)), isLf);
+
+        uint32_t blankMask = (uint32_t) _mm_movemask_epi8(isBlank);
+        uint32_t lfMask = (uint32_t) _mm_movemask_epi8(isLf);
 
-    // 文件结束符
-    if (c == EOF) {
-        // 返回文件结束符
-        return RDTokenType::T_EOF;
+        if (blankMask != 0xFFFFu) {
+            // 第一个非空白符之前的部分
+            unsigned n = (unsigned) __builtin_ctz(~blankMask);
+            ctx.lineNo += __builtin_popcount(lfMask & ((1u << n) - 1));
+            return p + n;
+        }
+
+        ctx.lineNo += __builtin_popcount(lfMask);
+        p += SimdWidth;
     }
+#endif
+
+    // 剩余不足一次比较的部分逐个处理
+    while (p < ctx.limit && (*p == ' ' || *p == '\t' || *p == '\n')) {
+        if (*p == '\n') {
+            ctx.lineNo++;
+        }
+        p++;
+    }
+
+    return p;
+}
+
+/// @brief 跳过字母、数字与下划线组成的串
+/// @param limit 输入缓冲区的结束位置
+/// @param p 起始位置
+/// @return 第一个不是字母、数字或下划线的位置
+static const char * skipIdChars(const char * limit, const char * p)
+{
+#if defined(__AVX2__)
+    // 有符号比较，大于0x7F的字节为负数，不会落在区间内
+    const __m256i lowerBit = _mm256_set1_epi8(0x20);
+    const __m256i aMinus1 = _mm256_set1_epi8('a' - 1);
+    const __m256i zPlus1 = _mm256_set1_epi8('z' + 1);
+    const __m256i zeroMinus1 = _mm256_set1_epi8('0' - 1);
+    const __m256i ninePlus1 = _mm256_set1_epi8('9' + 1);
+    const __m256i underline = _mm256_set1_epi8('_');
 
-    // TODO 请自行实现删除源文件中的注释，含单行注释和多行注释等
+    while ((size_t) (limit - p) >= SimdWidth) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i *) p);
+        __m256i lower = _mm256_or_si256(chunk, lowerBit);
+        __m256i isAlpha = _mm256_and_si256(_mm256_cmpgt_epi8(lower, aMinus1), _mm256_cmpgt_epi8(zPlus1, lower));
+        __m256i isDigit = _mm256_and_si256(_mm256_cmpgt_epi8(chunk, zeroMinus1), _mm256_cmpgt_epi8(ninePlus1, chunk));
+        __m256i isId = _mm256_or_si256(_mm256_or_si256(isAlpha, isDigit), _mm256_cmpeq_epi8(chunk, underline));
 
-    // 处理数字
-    if (isdigit(c)) {
+        uint32_t mask = (uint32_t) _mm256_movemask_epi8(isId);
+        if (mask != 0xFFFFFFFFu) {
+            return p + __builtin_ctz(~mask);
+        }
 
-        // 识别无符号数，这里只处理正整数或者0
-        // FIXME 0开头的整数这里也识别成了10进制整数，在C语言中0开头的数字串是8进制数字
+        p += SimdWidth;
+    }
+#elif defined(__SSE2__)
+    // 有符号比较，大于0x7F的字节为负数，不会落在区间内
+    const __m128i lowerBit = _mm_set1_epi8(0x20);
+    const __m128i aMinus1 = _mm_set1_epi8('a' - 1);
+    const __m128i zPlus1 = _mm_set1_epi8('z' + 1);
+    const __m128i zeroMinus1 = _mm_set1_epi8('0' - 1);
+    const __m128i ninePlus1 = _mm_set1_epi8('9' + 1);
+    const __m128i underline = _mm_set1_epi8('_');
 
-        rd_lval.integer_num.lineno = rd_line_no;
-        rd_lval.integer_num.val = c - '0';
+    while ((size_t) (limit - p) >= SimdWidth) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *) p);
+        __m128i lower = _mm_or_si128(chunk, lowerBit);
+        __m128i isAlpha = _mm_and_si128(_mm_cmpgt_epi8(lower, aMinus1), _mm_cmplt_epi8(lower, zPlus1));
+        __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(chunk, zeroMinus1), _mm_cmplt_epi8(chunk, ninePlus1));
+        __m128i isId = _mm_or_si128(_mm_or_si128(isAlpha, isDigit), _mm_cmpeq_epi8(chunk, underline));
 
-        // 最长匹配，直到非数字结束
-        while (isdigit(c = fgetc(rd_filein))) {
-            rd_lval.integer_num.val = rd_lval.integer_num.val * 10 + c - '0';
+        uint32_t mask = (uint32_t) _mm_movemask_epi8(isId);
+        if (mask != 0xFFFFu) {
+            return p + __builtin_ctz(~mask);
         }
 
-        // 存储数字的token值
-        tokenValue = std::to_string(rd_lval.integer_num.val);
-
-        // 多读的字符回退
-        ungetc(c, rd_filein);
-
-        tokenKind = RDTokenType::T_DIGIT;
-    } else if (c == '(') {
-        // 识别字符(
-        tokenKind = RDTokenType::T_L_PAREN;
-        // 存储字符(
-        tokenValue = "(";
-    } else if (c == ')') {
-        // 识别字符)
-        tokenKind = RDTokenType::T_R_PAREN;
-        // 存储字符)
-        tokenValue = ")";
-    } else if (c == '{') {
-        // 识别字符{
-        tokenKind = RDTokenType::T_L_BRACE;
-        // 存储字符{
-        tokenValue = "{";
-    } else if (c == '}') {
-        // 识别字符}
-        tokenKind = RDTokenType::T_R_BRACE;
-        // 存储字符}
-        tokenValue = "}";
-    } else if (c == ';') {
-        // 识别字符;
-        tokenKind = RDTokenType::T_SEMICOLON;
-        // 存储字符;
-        tokenValue = ";";
-    } else if (c == '+') {
-        // 识别字符+
-        tokenKind = RDTokenType::T_ADD;
-		// 存储字符+
-        tokenValue = "+";
-    } else if (c == '-') {
-        // 识别字符-
-        tokenKind = RDTokenType::T_SUB;
-		// 存储字符-
-        tokenValue = "-";
-    } else if (c == '=') {
-        // 识别字符=
-        tokenKind = RDTokenType::T_ASSIGN;
-    }  else if (c == ',') {
-        // 识别字符;
-        tokenKind = RDTokenType::T_COMMA;
-		// 存储字符,
-        tokenValue = ",";
-    } else if (isLetterUnderLine(c)) {
-        // 识别标识符，包含关键字/保留字或自定义标识符
-
-        // 最长匹配标识符
-        std::string name;
-
-        do {
-            // 记录字符
-            name.push_back(c);
-            c = fgetc(rd_filein);
-        } while (isLetterDigitalUnderLine(c));
-
-        // 存储标识符
-        tokenValue = name;
-
-        // 多读的字符恢复，下次可继续读到该字符
-        ungetc(c, rd_filein);
-
-        // 检查是否是关键字，若是则返回对应的Token，否则返回T_ID
-        tokenKind = getKeywordToken(name);
-        if (tokenKind == RDTokenType::T_ID) {
-            // 自定义标识符
-
-            // 设置ID的值
-            rd_lval.var_id.id = strdup(name.c_str());
-
-            // 设置行号
-            rd_lval.var_id.lineno = rd_line_no;
-        } else if (tokenKind == RDTokenType::T_INT) {
-            // int关键字
-
-            // 设置类型与行号
-            rd_lval.type.type = BasicType::TYPE_INT;
-            rd_lval.type.lineno = rd_line_no;
+        p += SimdWidth;
+    }
+#endif
+
+    // 剩余不足一次比较的部分查表处理
+    while (p < limit) {
+        uint8_t cls = scanTables.charClass[(uint8_t) *p];
+        if (cls != CC_IDSTART && cls != CC_DIGIT) {
+            break;
         }
-    } else {
-        printf("Line(%lld): Invalid char %s\n", (long long) rd_line_no, tokenValue.c_str());
-        tokenKind = RDTokenType::T_ERR;
+        p++;
     }
 
-    // Token的类别
-    return tokenKind;
+    return p;
+}
+
+/// @brief 词法文法，获取下一个Token
+/// @param ctx 词法分析上下文，Token的位置保存在ctx.token中
+/// @param lval Token的值
+/// @return Token的类别
+int rd_flex(RDFlexContext & ctx, RDSType & lval)
+{
+    const char * p = ctx.cursor;
+    int tokenKind = -1; // Token的值
+
+    // 初始状态：按字符类别转移，空白符回到初始状态，其余进入对应Token的识别
+    for (;;) {
+
+        if (p >= ctx.limit) {
+            // 文件结束符
+            ctx.cursor = p;
+            ctx.token = {(uint32_t) (p - ctx.base), 0};
+            return RDTokenType::T_EOF;
+        }
+
+        uint8_t cls = scanTables.charClass[(uint8_t) *p];
+
+        if (cls == CC_SPACE || cls == CC_LF) {
+            if (cls == CC_SPACE && *p != ' ' && *p != '\t') {
+                // \v与\f较少出现，不参与批量跳过
+                p++;
+            } else {
+                p = skipBlanks(ctx, p);
+            }
+            continue;
+        }
+
+        if (cls == CC_CR) {
+            // 支持Linux/Windows/Mac系统的行号分析
+            // Windows：\r\n
+            // Mac: \r
+            // Unix(Linux): \n
+            ctx.lineNo++;
+            p++;
+            if (p < ctx.limit && *p == '\n') {
+                p++;
+            }
+            continue;
+        }
+
+        // TODO 请自行实现删除源文件中的注释，含单行注释和多行注释等
+
+        const char * start = p;
+
+        switch (cls) {
+            case CC_DIGIT: {
+                // 识别无符号数，这里只处理正整数或者0
+                // FIXME 0开头的整数这里也识别成了10进制整数，在C语言中0开头的数字串是8进制数字
+                uint32_t val = 0;
+                do {
+                    val = val * 10 + (uint32_t) (*p - '0');
+                    p++;
+                } while (p < ctx.limit && scanTables.charClass[(uint8_t) *p] == CC_DIGIT);
+
+                lval.integer_num.lineno = ctx.lineNo;
+                lval.integer_num.val = val;
+
+                tokenKind = RDTokenType::T_DIGIT;
+                break;
+            }
+
+            case CC_IDSTART: {
+                // 识别标识符，包含关键字/保留字或自定义标识符，最长匹配
+                p = skipIdChars(ctx.limit, p + 1);
+
+                size_t len = (size_t) (p - start);
+
+                // 检查是否是关键字，若是则返回对应的Token，否则返回T_ID
+                tokenKind = getKeywordToken(start, len);
+                if (tokenKind == RDTokenType::T_ID) {
+                    // 自定义标识符
+
+                    // 设置ID的值，驻留到全局字符串驻留表中
+                    lval.var_id.id = internSymbol(std::string_view(start, len));
+
+                    // 设置行号
+                    lval.var_id.lineno = ctx.lineNo;
+                } else if (tokenKind == RDTokenType::T_INT) {
+                    // int关键字
+
+                    // 设置类型与行号
+                    lval.type.type = BasicType::TYPE_INT;
+                    lval.type.lineno = ctx.lineNo;
+                }
+                break;
+            }
+
+            case CC_PUNCT:
+                // 单字符的运算符或界符直接查表
+                tokenKind = scanTables.punctToken[(uint8_t) *p];
+                p++;
+                break;
+
+            default:
+                p++;
+                minic_diag("Line(%lld): Invalid char %c\n", (long long) ctx.lineNo, *start);
+                tokenKind = RDTokenType::T_ERR;
+                break;
+        }
+
+        ctx.cursor = p;
+        ctx.token = {(uint32_t) (start - ctx.base), (uint32_t) (p - start)};
+
+        // Token的类别
+        return tokenKind;
+    }
 }
@@ -2,8 +2,8 @@
 /// @file RecursiveDescentFlex.h
 /// @brief 词法分析的头文件，不借助工具实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.1
+/// @date 2026-10-15
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,17 +11,58 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>扫描状态放入上下文，可多线程同时分析
 /// </table>
 ///
 #pragma once
 
-#include <stdio.h>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
 
-// 行号信息
-extern int rd_line_no;
+/// @brief Token在输入缓冲区中的位置，Token的文本不再拷贝
+struct RDTokenSpan {
+    /// @brief 相对缓冲区首地址的偏移
+    uint32_t offset;
 
-// 输入文件指针
-extern FILE * rd_filein;
+    /// @brief 字节数
+    uint32_t length;
+};
 
-/// 识别词法
-int rd_flex();
+/// @brief 词法与语法分析数据交互的Token的值类型，定义见RecursiveDescentParser.h
+union RDSType;
+
+/// @brief 词法分析的上下文，保存全部扫描状态。每次分析使用独立的上下文，多个线程可同时分析
+struct RDFlexContext {
+    /// @brief 输入缓冲区的首地址
+    const char * base = nullptr;
+
+    /// @brief 输入缓冲区的当前扫描位置
+    const char * cursor = nullptr;
+
+    /// @brief 输入缓冲区的结束位置
+    const char * limit = nullptr;
+
+    /// @brief 行号信息
+    int64_t lineNo = 1;
+
+    /// @brief 当前Token在输入缓冲区中的位置与长度
+    RDTokenSpan token{0, 0};
+};
+
+/// @brief 获取当前Token的原始文本
+/// @param ctx 词法分析上下文
+/// @return 文本视图，指向输入缓冲区
+std::string_view rd_token_text(const RDFlexContext & ctx);
+
+/// @brief 设置词法分析的输入缓冲区，并复位行号
+/// @param ctx 词法分析上下文
+/// @param buf 源文件内容首地址
+/// @param len 源文件内容的字节数
+void rd_flex_init(RDFlexContext & ctx, const char * buf, size_t len);
+
+/// @brief 识别词法，获取下一个Token
+/// @param ctx 词法分析上下文
+/// @param lval Token的值
+/// @return Token的类别
+int rd_flex(RDFlexContext & ctx, RDSType & lval);
@@ -2,8 +2,8 @@
 /// @file RecursiveDescentParser.cpp
 /// @brief 递归下降分析法实现的语法分析后产生抽象语法树的实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.2
+/// @date 2026-10-15
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,7 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>分析状态放入上下文，可多线程同时分析
 /// </table>
 ///
 #include <stdarg.h>
@@ -20,39 +21,45 @@
 #include "AttrType.h"
 #include "RecursiveDescentFlex.h"
 #include "RecursiveDescentParser.h"
+#include "Common.h"
 
-// 定义全局变量给词法分析使用，用于填充值
-RDSType rd_lval;
+///
+/// @brief 语法分析的上下文，保存全部分析状态，每次分析独立一份，不再使用全局变量
+///
+struct RDParseContext {
+    /// @brief 词法分析的上下文
+    RDFlexContext flex;
 
-// 词法识别的记号值，原始文本字符串
-extern std::string tokenValue;
+    /// @brief 词法分析填充的Token的值
+    RDSType lval;
 
-// 语法分析过程中的错误数目
-static int errno_num = 0;
+    /// @brief 语法分析过程中的LookAhead，指向下一个Token
+    RDTokenType lookaheadTag = RDTokenType::T_EMPTY;
 
-// 语法分析过程中的LookAhead，指向下一个Token
-static RDTokenType lookaheadTag = RDTokenType::T_EMPTY;
+    /// @brief 语法分析过程中的错误数目
+    int errno_num = 0;
+};
 
-static ast_node * Block();
-static ast_node * expr();
+static ast_node * Block(RDParseContext & ctx);
+static ast_node * expr(RDParseContext & ctx);
 
 ///
 /// @brief 继续检查LookAhead指向的记号是否是T，用于符号的FIRST集合或Follow集合判断
 ///
-#define _(T) || (lookaheadTag == T)
+#define _(T) || (ctx.lookaheadTag == T)
 
 ///
 /// @brief 第一个检查LookAhead指向的记号是否属于C，用于符号的FIRST集合或Follow集合判断
 /// 如判断是否是T_ID，或者T_INT，可结合F和_两个宏来实现，即F(T_ID) _(T_INT)
 ///
-#define F(C) (lookaheadTag == C)
+#define F(C) (ctx.lookaheadTag == C)
 
 ///
 /// @brief lookahead指向下一个Token
 ///
-static void advance()
+static void advance(RDParseContext & ctx)
 {
-    lookaheadTag = (RDTokenType) rd_flex();
+    ctx.lookaheadTag = (RDTokenType) rd_flex(ctx.flex, ctx.lval);
 }
 
 ///
@@ -60,7 +67,7 @@ static void advance()
 /// @param tag 是否匹配指定的Tag
 /// @return true：匹配，false：未匹配
 ///
-static bool match(RDTokenType tag)
+static bool match(RDParseContext & ctx, RDTokenType tag)
 {
     bool result = false;
 
@@ -69,7 +76,7 @@ static bool match(RDTokenType tag)
         result = true;
 
         // 匹配，则向前获取下一个Token
-        advance();
+        advance(ctx);
     }
 
     return result;
@@ -79,7 +86,7 @@ static bool match(RDTokenType tag)
 /// @brief 语法错误输出
 /// @param format 格式化字符串，和printf的格式化字符串一样
 ///
-static void semerror(const char * format, ...)
+static void semerror(RDParseContext & ctx, const char * format, ...)
 {
     char logStr[1024];
 
@@ -91,19 +98,19 @@ static void semerror(const char * format, ...)
 
     va_end(ap);
 
-    printf("Line(%d): %s\n", rd_line_no, logStr);
+    minic_diag("Line(%lld): %s\n", (long long) ctx.flex.lineNo, logStr);
 
-    errno_num++;
+    ctx.errno_num++;
 }
 
 ///
 /// @brief 实参列表语法分析，文法: realParamList: expr (T_COMMA expr)*;
 /// @return ast_node* 实参列表节点
 ///
-static void realParamList(ast_node * realParamsNode)
+static void realParamList(RDParseContext & ctx, ast_node * realParamsNode)
 {
     // 实参表达式expr识别
-    ast_node * param_node = expr();
+    ast_node * param_node = expr(ctx);
     if (!param_node) {
 
         // 不是合法的实参
@@ -117,10 +124,10 @@ static void realParamList(ast_node * realParamsNode)
     for (;;) {
 
         // 识别逗号
-        if (match(T_COMMA)) {
+        if (match(ctx, T_COMMA)) {
 
             // 识别实参
-            param_node = expr();
+            param_node = expr(ctx);
 
             (void) realParamsNode->insert_son_node(param_node);
         } else {
@@ -137,35 +144,28 @@ static void realParamList(ast_node * realParamsNode)
 /// 其文法为 idTail: T_L_PAREN realParamList? T_R_PAREN | ε
 /// @return ast_node*
 ///
-static ast_node * idTail(var_id_attr & id)
+static ast_node * idTail(RDParseContext & ctx, var_id_attr & id)
 {
     // 标识符节点
     ast_node * node = ast_node::New(id);
 
-    // 对于字符型字面量的字符串空间需要释放，因词法用到了strdup进行了字符串空间的分配
-    free(id.id);
-    id.id = nullptr;
-
-    if (match(T_L_PAREN)) {
+    if (match(ctx, T_L_PAREN)) {
 
         // 函数调用，idTail: T_L_PAREN realParamList? T_R_PAREN
 
         ast_node * realParamsNode = create_contain_node(ast_operator_type::AST_OP_FUNC_REAL_PARAMS);
 
-        if (match(T_R_PAREN)) {
+        if (!match(ctx, T_R_PAREN)) {
 
-            // 被调用函数没有实参，返回一个空的实参清单节点
-            return realParamsNode;
-        }
+            // 识别实参列表
+            realParamList(ctx, realParamsNode);
 
-        // 识别实参列表
-        realParamList(realParamsNode);
-
-        if (!match(T_R_PAREN)) {
-            semerror("函数调用缺少右括号");
+            if (!match(ctx, T_R_PAREN)) {
+                semerror(ctx, "函数调用缺少右括号");
+            }
         }
 
-        // 创建函数调用节点
+        // 创建函数调用节点，被调用函数没有实参时实参清单节点为空
         node = create_func_call(node, realParamsNode);
     } else {
         // 变量ID，idTail -> ε
@@ -190,7 +190,7 @@ static ast_node * idTail(var_id_attr & id)
 /// 可以是空串，代表简单变量。
 /// @return ast_node*
 ///
-static ast_node * unaryExp()
+static ast_node * unaryExp(RDParseContext & ctx)
 {
     ast_node * node = nullptr;
 
@@ -198,32 +198,32 @@ static ast_node * unaryExp()
 
         // 无符号整数，primaryExp: T_DIGIT
 
-        node = ast_node::New(rd_lval.integer_num);
+        node = ast_node::New(ctx.lval.integer_num);
 
         // 跳过当前记号，指向下一个记号
-        advance();
+        advance(ctx);
 
-    } else if (match(T_L_PAREN)) {
+    } else if (match(ctx, T_L_PAREN)) {
 
         // 括号表达式，primaryExp: T_L_PAREN expr T_R_PAREN
 
         // 括号内表达式识别
-        node = expr();
+        node = expr(ctx);
 
-        if (!match(T_R_PAREN)) {
-            semerror("缺少右括号");
+        if (!match(ctx, T_R_PAREN)) {
+            semerror(ctx, "缺少右括号");
         }
     } else if (F(T_ID)) {
 
         // ID开头的表达式，可以是函数调用，也可以是数组(目前不支持)，或者简单变量，primaryExp: T_ID idTail
 
-        var_id_attr & id = rd_lval.var_id;
+        var_id_attr & id = ctx.lval.var_id;
 
         // 跳过当前记号，指向下一个记号
-        advance();
+        advance(ctx);
 
         // 识别ID尾部符号
-        node = idTail(id);
+        node = idTail(ctx, id);
     }
 
     return node;
@@ -233,7 +233,7 @@ static ast_node * unaryExp()
 /// @brief 加减运算符, 其文法为addOp : T_ADD | T_SUB;
 /// @return ast_operator_type AST中节点的运算符
 ///
-ast_operator_type addOp()
+ast_operator_type addOp(RDParseContext & ctx)
 {
     ast_operator_type type = ast_operator_type::AST_OP_MAX;
 
@@ -242,13 +242,13 @@ ast_operator_type addOp()
         type = ast_operator_type::AST_OP_ADD;
 
         // 跳过当前的记号，指向下一个记号
-        advance();
+        advance(ctx);
     } else if (F(T_SUB)) {
 
         type = ast_operator_type::AST_OP_SUB;
 
         // 跳过当前的记号，指向下一个记号
-        advance();
+        advance(ctx);
     }
 
     return type;
@@ -260,10 +260,10 @@ ast_operator_type addOp()
 ///
 /// @return ast_node*
 ///
-static ast_node * addExp()
+static ast_node * addExp(RDParseContext & ctx)
 {
     // 识别第一个unaryExp
-    ast_node * left_node = unaryExp();
+    ast_node * left_node = unaryExp(ctx);
     if (!left_node) {
         // 非法的一元表达式
         return nullptr;
@@ -274,7 +274,7 @@ static ast_node * addExp()
     for (;;) {
 
         // 获取加减运算符
-        ast_operator_type op = addOp();
+        ast_operator_type op = addOp(ctx);
         if (ast_operator_type::AST_OP_MAX == op) {
 
             // 不是加减运算符则正常结束
@@ -282,7 +282,7 @@ static ast_node * addExp()
         }
 
         // 获取右侧表达式
-        ast_node * right_node = unaryExp();
+        ast_node * right_node = unaryExp(ctx);
         if (!right_node) {
 
             // 二元加减运算没有合法的右侧表达式
@@ -298,27 +298,27 @@ static ast_node * addExp()
 
 /// @brief 表达式文法 expr : addExp, 表达式目前只支持加法与减法运算
 /// @return AST的节点
-static ast_node * expr()
+static ast_node * expr(RDParseContext & ctx)
 {
-    return addExp();
+    return addExp(ctx);
 }
 
 /// @brief returnStatement -> T_RETURN expr T_SEMICOLON
 /// @return AST的节点
-static ast_node * returnStatement()
+static ast_node * returnStatement(RDParseContext & ctx)
 {
 
-    if (match(T_RETURN)) {
+    if (match(ctx, T_RETURN)) {
 
         // return语句的First集合元素为T_RETURN
         // 若匹配，则说明是return语句
 
-        ast_node * expr_node = expr();
+        ast_node * expr_node = expr(ctx);
 
-        if (!match(T_SEMICOLON)) {
+        if (!match(ctx, T_SEMICOLON)) {
 
             // 返回语句后没有分号
-            semerror("返回语句后没有分号");
+            semerror(ctx, "返回语句后没有分号");
         }
 
         return create_contain_node(ast_operator_type::AST_OP_RETURN, expr_node);
@@ -328,9 +328,9 @@ static ast_node * returnStatement()
 }
 
 /// 识别表达式尾部符号，文法： assignExprStmtTail : T_ASSIGN expr | ε
-static ast_node * assignExprStmtTail(ast_node * left_node)
+static ast_node * assignExprStmtTail(RDParseContext & ctx, ast_node * left_node)
 {
-    if (match(T_ASSIGN)) {
+    if (match(ctx, T_ASSIGN)) {
 
         // 赋值运算符，说明含有赋值运算
 
@@ -338,13 +338,13 @@ static ast_node * assignExprStmtTail(ast_node * left_node)
         if (!left_node) {
 
             // 没有左侧节点，则语法错误
-            semerror("赋值语句的左侧表达式不能为空");
+            semerror(ctx, "赋值语句的左侧表达式不能为空");
 
             return nullptr;
         }
 
         // 赋值运算符右侧表达式分析识别
-        ast_node * right_node = expr();
+        ast_node * right_node = expr(ctx);
 
         return create_contain_node(ast_operator_type::AST_OP_ASSIGN, left_node, right_node);
     } else if (F(T_SEMICOLON)) {
@@ -359,12 +359,12 @@ static ast_node * assignExprStmtTail(ast_node * left_node)
 /// @brief 赋值语句或表达式语句识别，文法：assignExprStmt : expr assignExprStmtTail
 /// @return ast_node*
 ///
-static ast_node * assignExprStmt()
+static ast_node * assignExprStmt(RDParseContext & ctx)
 {
     // 识别表达式，目前还不知道是否是表达式语句或赋值语句
-    ast_node * expr_node = expr();
+    ast_node * expr_node = expr(ctx);
 
-    return assignExprStmtTail(expr_node);
+    return assignExprStmtTail(ctx, expr_node);
 }
 
 ///
@@ -383,21 +383,21 @@ static ast_node * assignExprStmt()
 ///
 /// @return AST的节点
 ///
-static ast_node * statement()
+static ast_node * statement(RDParseContext & ctx)
 {
     ast_node * node = nullptr;
     if (F(T_RETURN)) {
 
         // Return语句，识别产生式statement: returnStatement
-        node = returnStatement();
+        node = returnStatement(ctx);
     } else if (F(T_L_BRACE)) {
 
         // 语句块，识别产生式statement: block
-        node = Block();
+        node = Block(ctx);
     } else if (F(T_SEMICOLON)) {
 
         // 空语句，识别产生式statement: T_SEMICOLON
-        advance();
+        advance(ctx);
     } else if (F(T_ID) _(T_L_PAREN) _(T_DIGIT)) {
 
         // 赋值语句，statement -> assignExprStmt T_SEMICOLON
@@ -407,10 +407,10 @@ static ast_node * statement()
         // 赋值语句以T_ID开头，并且左值要具有左值属性
         // 表达式语句可以以T_ID开头，也可以左小括号T_L_PAREN，甚至一元运算符等开头
         // 目前文法下表达式语句在不支持一元运算符的情况下只能以T_ID或T_L_PAREN开头
-        node = assignExprStmt();
+        node = assignExprStmt(ctx);
 
-        if (!match(T_SEMICOLON)) {
-            semerror("语句后缺少分号");
+        if (!match(ctx, T_SEMICOLON)) {
+            semerror(ctx, "语句后缺少分号");
         }
     }
 
@@ -421,9 +421,9 @@ static ast_node * statement()
 /// @brief 变量定义列表语法识别 其文法：varDeclList : T_COMMA T_ID varDeclList | T_SEMICOLON
 /// @param vardeclstmt_node 变量声明语句节点，所有的变量节点应该加到该节点中
 ///
-static void varDeclList(ast_node * vardeclstmt_node)
+static void varDeclList(RDParseContext & ctx, ast_node * vardeclstmt_node)
 {
-    if (match(T_COMMA)) {
+    if (match(ctx, T_COMMA)) {
 
         // 匹配成功，定义列表中有逗号
 
@@ -433,26 +433,26 @@ static void varDeclList(ast_node * vardeclstmt_node)
             // 定义列表中定义的变量
 
             // 新建变量声明节点并加入变量声明语句中
-            (void) add_var_decl_node(vardeclstmt_node, rd_lval.var_id);
+            (void) add_var_decl_node(vardeclstmt_node, ctx.lval.var_id);
 
             // 填过当前的Token，指向下一个Token
-            advance();
+            advance(ctx);
 
             // 递归调用，不断追加变量定义
-            varDeclList(vardeclstmt_node);
+            varDeclList(ctx, vardeclstmt_node);
         } else {
-            semerror("逗号后必须是标识符");
+            semerror(ctx, "逗号后必须是标识符");
         }
-    } else if (match(T_SEMICOLON)) {
+    } else if (match(ctx, T_SEMICOLON)) {
         // 匹配成功，则说明只有前面的一个变量或者变量定义，正常结束
     } else {
-        semerror("非法记号: %d", (int) lookaheadTag);
+        semerror(ctx, "非法记号: %d", (int) ctx.lookaheadTag);
 
         // 忽略该记号，继续检查
-        advance();
+        advance(ctx);
 
         // 继续检查后续的变量
-        varDeclList(vardeclstmt_node);
+        varDeclList(ctx, vardeclstmt_node);
     }
 }
 
@@ -462,31 +462,31 @@ static void varDeclList(ast_node * vardeclstmt_node)
 ///
 /// @return ast_node* 局部变量声明节点
 ///
-static ast_node * varDecl()
+static ast_node * varDecl(RDParseContext & ctx)
 {
     if (F(T_INT)) {
 
-        // 这里必须复制，而不能引用，因为rd_lval为全局，下一个记号识别后要被覆盖
-        type_attr type = rd_lval.type;
+        // 这里必须复制，而不能引用，因为ctx.lval在下一个记号识别后要被覆盖
+        type_attr type = ctx.lval.type;
 
         // 跳过int类型的记号，指向下一个Token
-        advance();
+        advance(ctx);
 
         // 检测是否是标识符
         if (F(T_ID)) {
 
             // 创建变量声明语句，并加入第一个变量
-            ast_node * stmt_node = create_var_decl_stmt_node(type, rd_lval.var_id);
+            ast_node * stmt_node = create_var_decl_stmt_node(type, ctx.lval.var_id);
 
             // 跳过标识符记号，指向下一个Token
-            advance();
+            advance(ctx);
 
-            varDeclList(stmt_node);
+            varDeclList(ctx, stmt_node);
 
             return stmt_node;
 
         } else {
-            semerror("类型后要求的记号为标识符");
+            semerror(ctx, "类型后要求的记号为标识符");
             // 这里忽略继续检查下一个记号，为便于一次可检查出多个错误
             // 当然可以直接退出循环，一旦有错就不再检查语法错误。
         }
@@ -509,12 +509,12 @@ static ast_node * varDecl()
 /// statement:T_RETURN expr T_SEMICOLON | lVal T_ASSIGN expr T_SEMICOLON | block | expr? T_SEMICOLON
 /// @return 返回AST的节点
 ///
-static ast_node * BlockItem()
+static ast_node * BlockItem(RDParseContext & ctx)
 {
     if (F(T_INT)) {
-        return varDecl();
+        return varDecl(ctx);
     } else {
-        return statement();
+        return statement(ctx);
     }
 }
 
@@ -522,7 +522,7 @@ static ast_node * BlockItem()
 /// @brief 块内语句列表识别，文法为BlockItemList : BlockItem+
 /// @return AST的节点
 ///
-static void BlockItemList(ast_node * blockNode)
+static void BlockItemList(RDParseContext & ctx, ast_node * blockNode)
 {
     for (;;) {
 
@@ -532,7 +532,7 @@ static void BlockItemList(ast_node * blockNode)
         }
 
         // 遍历BlockItem
-        ast_node * itemNode = BlockItem();
+        ast_node * itemNode = BlockItem(ctx);
         if (itemNode) {
             blockNode->insert_son_node(itemNode);
         } else {
@@ -546,24 +546,24 @@ static void BlockItemList(ast_node * blockNode)
 /// @brief 语句块识别，文法：Block -> T_L_BRACE BlockItemList? T_R_BRACE
 /// @return AST的节点
 ///
-static ast_node * Block()
+static ast_node * Block(RDParseContext & ctx)
 {
-    if (match(T_L_BRACE)) {
+    if (match(ctx, T_L_BRACE)) {
 
         // 创建语句块节点
         ast_node * blockNode = create_contain_node(ast_operator_type::AST_OP_BLOCK);
 
         // 空的语句块
-        if (match(T_R_BRACE)) {
+        if (match(ctx, T_R_BRACE)) {
             return blockNode;
         }
 
         // 块内语句列表识别
-        BlockItemList(blockNode);
+        BlockItemList(ctx, blockNode);
 
         // 没有匹配左大括号，则语法错误
-        if (!match(T_R_BRACE)) {
-            semerror("缺少右大括号");
+        if (!match(ctx, T_R_BRACE)) {
+            semerror(ctx, "缺少右大括号");
         }
 
         // 正常
@@ -579,25 +579,24 @@ static ast_node * Block()
 /// @param type 类型 变量类型或函数返回值类型
 /// @param id 标识符 变量名或者函数名
 ///
-static ast_node * idtail(type_attr & type, var_id_attr & id)
+static ast_node * idtail(RDParseContext & ctx, type_attr & type, var_id_attr & id)
 {
-    if (match(T_L_PAREN)) {
+    if (match(ctx, T_L_PAREN)) {
         // 函数定义
 
         // 目前函数定义没有形参，因此必须是右小括号
-        if (match(T_R_PAREN)) {
+        if (match(ctx, T_R_PAREN)) {
 
             // 识别block
-            ast_node * blockNode = Block();
+            ast_node * blockNode = Block(ctx);
 
             // 形参结点没有，设置为空指针
             ast_node * formalParamsNode = nullptr;
 
             // 创建函数定义的节点，孩子有类型，函数名，语句块和形参(实际上无)
-            // create_func_def函数内会释放id中指向的标识符空间，切记，之后不要再释放，之前一定要是通过strdup函数或者malloc分配的空间
             return create_func_def(type, id, blockNode, formalParamsNode);
         } else {
-            semerror("函数定义缺少右小括号");
+            semerror(ctx, "函数定义缺少右小括号");
         }
 
         return nullptr;
@@ -608,7 +607,7 @@ static ast_node * idtail(type_attr & type, var_id_attr & id)
     // 根据第一个变量声明创建变量声明语句节点并加入其中
     ast_node * stmt_node = create_var_decl_stmt_node(type, id);
 
-    varDeclList(stmt_node);
+    varDeclList(ctx, stmt_node);
 
     return stmt_node;
 }
@@ -631,37 +630,37 @@ static ast_node * idtail(type_attr & type, var_id_attr & id)
 // idtail : varDeclList | T_L_PAREN T_R_PAREN block
 // varDeclList : T_COMMA T_ID varDeclList | T_SEMICOLON
 // 闭包代表一个循环，可以0以上的循环，最后一个为EOF
-static ast_node * compileUnit()
+static ast_node * compileUnit(RDParseContext & ctx)
 {
     // 创建AST的根节点，编译单元运算符
-    ast_node * cu_node = create_contain_node(ast_operator_type::AST_OP_COMPILE_UNIT);
+    ast_node * cu_node = create_compile_unit();
 
     for (;;) {
 
         // match匹配并LookAhead往前挪动
         if (F(T_INT)) {
 
-            type_attr type = rd_lval.type;
+            type_attr type = ctx.lval.type;
 
             // 跳过当前的记号，指向下一个记号
-            advance();
+            advance(ctx);
 
             // 检测是否是标识符
             if (F(T_ID)) {
 
                 // 获取标识符的值和定位信息
-                var_id_attr id = rd_lval.var_id;
+                var_id_attr id = ctx.lval.var_id;
 
                 // 跳过当前的记号，指向下一个记号
-                advance();
+                advance(ctx);
 
                 // 函数定义的开头为int
-                ast_node * node = idtail(type, id);
+                ast_node * node = idtail(ctx, type, id);
 
-                // 加入到父节点中，node为空时insert_son_node内部进行了忽略
-                (void) cu_node->insert_son_node(node);
+                // 加入到父节点中，node为空时内部进行了忽略；流式编译时直接交给后续处理
+                (void) add_compile_unit_item(cu_node, node);
             } else {
-                semerror("类型后要求的记号为标识符");
+                semerror(ctx, "类型后要求的记号为标识符");
                 // 这里忽略继续检查下一个记号，为便于一次可检查出多个错误
                 // 当然可以直接退出循环，一旦有错就不再检查语法错误。
             }
@@ -680,20 +679,24 @@ static ast_node * compileUnit()
 
 ///
 /// @brief 采用递归下降分析法实现词法与语法分析生成抽象语法树
+/// @param buf 源文件内容首地址
+/// @param len 源文件内容的字节数
 /// @return ast_node* 空指针失败，否则成功
 ///
-ast_node * rd_parse()
+ast_node * rd_parse(const char * buf, size_t len)
 {
-    // 没有错误信息
-    errno_num = 0;
+    // 分析状态都在本次分析的上下文中，没有错误信息
+    RDParseContext ctx;
+
+    rd_flex_init(ctx.flex, buf, len);
 
     // lookahead指向第一个Token
-    advance();
+    advance(ctx);
 
-    ast_node * astRoot = compileUnit();
+    ast_node * astRoot = compileUnit(ctx);
 
     // 如果有错误信息，则返回-1，否则返回0
-    if (errno_num != 0) {
+    if (ctx.errno_num != 0) {
         return nullptr;
     }
 
@@ -2,8 +2,8 @@
 /// @file RecursiveDescentParser.h
 /// @brief 递归下降分析法实现的语法分析后产生抽象语法树的头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.2
+/// @date 2026-10-15
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,7 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>分析状态放入上下文，可多线程同时分析
 /// </table>
 ///
 #pragma once
@@ -51,11 +52,10 @@ union RDSType {
     type_attr type;             // 类型
 };
 
-/// @brief 词法与语法分析数据交互的Token的值
-extern RDSType rd_lval;
-
 ///
-/// @brief 采用递归下降分析法实现词法与语法分析生成抽象语法树
+/// @brief 采用递归下降分析法实现词法与语法分析生成抽象语法树，分析状态不共享，可多线程同时调用
+/// @param buf 源文件内容首地址
+/// @param len 源文件内容的字节数
 /// @return ast_node* 空指针失败，否则成功
 ///
-ast_node * rd_parse();
+ast_node * rd_parse(const char * buf, size_t len);
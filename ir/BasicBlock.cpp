@@ -0,0 +1,109 @@
+///
+/// @file BasicBlock.cpp
+/// @brief 基本块的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>增加块内指令的插入删除与支配信息
+/// </table>
+///
+#include <algorithm>
+#include <cassert>
+
+#include "BasicBlock.h"
+#include "Casting.h"
+#include "LabelInstruction.h"
+
+/// @brief 构造函数
+/// @param _code 指令所在的线性IR指令序列
+/// @param _first 块内的第一条指令
+/// @param _last 块内的最后一条指令
+BasicBlock::BasicBlock(InterCode * _code, Instruction * _first, Instruction * _last)
+    : code(_code), first(_first), last(_last)
+{}
+
+/// @brief 获取块开头的Label指令
+/// @return LabelInstruction* Label指令，块不以Label指令开头时为nullptr
+LabelInstruction * BasicBlock::getLabel() const
+{
+    return dyn_cast<LabelInstruction>(first);
+}
+
+/// @brief 在块内指令pos之后插入指令
+/// @param pos 块内的指令
+/// @param inst 要插入的指令
+void BasicBlock::insertAfter(Instruction * pos, Instruction * inst)
+{
+    code->insertAfter(pos, inst);
+    inst->block = this;
+
+    if (pos == last) {
+        last = inst;
+    }
+}
+
+/// @brief 在块末插入指令，块以goto或exit指令结束时插入到该指令之前
+/// @param inst 要插入的指令
+void BasicBlock::insertBeforeTerminator(Instruction * inst)
+{
+    IRInstOperator op = last->getOp();
+    if ((op != IRInstOperator::IRINST_OP_GOTO) && (op != IRInstOperator::IRINST_OP_EXIT)) {
+        insertAfter(last, inst);
+        return;
+    }
+
+    code->insertBefore(last, inst);
+    inst->block = this;
+
+    if (first == last) {
+        first = inst;
+    }
+}
+
+/// @brief 删除块内的指令，块的首条指令（Label或Entry指令）不能删除
+/// @param inst 块内的指令，其值不能再有使用者
+/// @return Instruction* 原来的下一条指令
+Instruction * BasicBlock::erase(Instruction * inst)
+{
+    assert((inst != first) && "the leading instruction of a block can not be erased");
+
+    if (inst == last) {
+        last = inst->getPrevInst();
+    }
+
+    return code->erase(inst);
+}
+
+/// @brief 本块是否支配other，沿other的立即支配块向上查找
+/// @param other 基本块
+/// @return true 支配 false 不支配
+bool BasicBlock::dominates(const BasicBlock * other) const
+{
+    while (other) {
+        if (other == this) {
+            return true;
+        }
+        other = other->idom;
+    }
+
+    return false;
+}
+
+/// @brief 增加一条到succ的边，重复的边只保留一条
+/// @param succ 后继基本块
+void BasicBlock::addSuccessor(BasicBlock * succ)
+{
+    if (std::find(succs.begin(), succs.end(), succ) != succs.end()) {
+        return;
+    }
+
+    succs.push_back(succ);
+    succ->preds.push_back(this);
+}
@@ -0,0 +1,233 @@
+///
+/// @file BasicBlock.h
+/// @brief 基本块，由函数线性IR指令序列中连续的一段指令构成
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>增加块内指令的插入删除与支配信息
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "IRCode.h"
+
+class LabelInstruction;
+
+///
+/// @brief 基本块。指令仍保存在函数的线性IR指令序列中，基本块只记录其首尾指令，
+/// 块内指令顺序执行，只有最后一条指令（goto或exit）能够转移控制流。
+/// 块内插入删除指令要通过基本块进行，以便维护首尾指令
+///
+class BasicBlock {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _code 指令所在的线性IR指令序列
+    /// @param _first 块内的第一条指令
+    /// @param _last 块内的最后一条指令
+    ///
+    BasicBlock(InterCode * _code, Instruction * _first, Instruction * _last);
+
+    ///
+    /// @brief 获取块内的第一条指令
+    /// @return Instruction* 第一条指令
+    ///
+    [[nodiscard]] Instruction * getFirstInst() const
+    {
+        return first;
+    }
+
+    ///
+    /// @brief 获取块内的最后一条指令，即转移控制流的指令或落空到下一块前的指令
+    /// @return Instruction* 最后一条指令
+    ///
+    [[nodiscard]] Instruction * getLastInst() const
+    {
+        return last;
+    }
+
+    ///
+    /// @brief 获取块开头的Label指令
+    /// @return LabelInstruction* Label指令，块不以Label指令开头时为nullptr
+    ///
+    [[nodiscard]] LabelInstruction * getLabel() const;
+
+    ///
+    /// @brief 块内指令的开始迭代器
+    /// @return InterCode::iterator
+    ///
+    [[nodiscard]] InterCode::iterator begin() const
+    {
+        return InterCode::iterator(first, code);
+    }
+
+    ///
+    /// @brief 块内指令的尾后迭代器
+    /// @return InterCode::iterator
+    ///
+    [[nodiscard]] InterCode::iterator end() const
+    {
+        return InterCode::iterator(last->getNextInst(), code);
+    }
+
+    ///
+    /// @brief 获取前驱基本块
+    /// @return std::vector<BasicBlock *>& 前驱基本块列表
+    ///
+    [[nodiscard]] const std::vector<BasicBlock *> & getPredecessors() const
+    {
+        return preds;
+    }
+
+    ///
+    /// @brief 获取后继基本块
+    /// @return std::vector<BasicBlock *>& 后继基本块列表
+    ///
+    [[nodiscard]] const std::vector<BasicBlock *> & getSuccessors() const
+    {
+        return succs;
+    }
+
+    ///
+    /// @brief 在块内指令pos之后插入指令
+    /// @param pos 块内的指令
+    /// @param inst 要插入的指令
+    ///
+    void insertAfter(Instruction * pos, Instruction * inst);
+
+    ///
+    /// @brief 在块末插入指令，块以goto或exit指令结束时插入到该指令之前
+    /// @param inst 要插入的指令
+    ///
+    void insertBeforeTerminator(Instruction * inst);
+
+    ///
+    /// @brief 删除块内的指令，块的首条指令（Label或Entry指令）不能删除
+    /// @param inst 块内的指令，其值不能再有使用者
+    /// @return Instruction* 原来的下一条指令
+    ///
+    Instruction * erase(Instruction * inst);
+
+    ///
+    /// @brief 获取立即支配块
+    /// @return BasicBlock* 立即支配块，入口块与不可达的块为nullptr
+    ///
+    [[nodiscard]] BasicBlock * getIDom() const
+    {
+        return idom;
+    }
+
+    ///
+    /// @brief 获取支配树上的孩子，即立即支配块为本块的块
+    /// @return const std::vector<BasicBlock *>& 孩子列表
+    ///
+    [[nodiscard]] const std::vector<BasicBlock *> & getDomChildren() const
+    {
+        return domChildren;
+    }
+
+    ///
+    /// @brief 获取支配边界，即本块支配其某个前驱但不严格支配其自身的块
+    /// @return const std::vector<BasicBlock *>& 支配边界
+    ///
+    [[nodiscard]] const std::vector<BasicBlock *> & getDomFrontier() const
+    {
+        return domFrontier;
+    }
+
+    ///
+    /// @brief 本块是否支配other，块支配其自身
+    /// @param other 基本块
+    /// @return true 支配 false 不支配
+    ///
+    [[nodiscard]] bool dominates(const BasicBlock * other) const;
+
+    ///
+    /// @brief 获取块在控制流图中按指令顺序的编号
+    /// @return int32_t 编号
+    ///
+    [[nodiscard]] int32_t getIndex() const
+    {
+        return index;
+    }
+
+    ///
+    /// @brief 获取块在逆后序中的编号
+    /// @return int32_t 编号，不可达的块为-1
+    ///
+    [[nodiscard]] int32_t getRPOIndex() const
+    {
+        return rpoIndex;
+    }
+
+private:
+    /// 控制流图负责块的划分与连边
+    friend class ControlFlowGraph;
+
+    ///
+    /// @brief 增加一条到succ的边
+    /// @param succ 后继基本块
+    ///
+    void addSuccessor(BasicBlock * succ);
+
+    ///
+    /// @brief 指令所在的线性IR指令序列
+    ///
+    InterCode * code;
+
+    ///
+    /// @brief 块内的第一条指令
+    ///
+    Instruction * first;
+
+    ///
+    /// @brief 块内的最后一条指令
+    ///
+    Instruction * last;
+
+    ///
+    /// @brief 前驱基本块
+    ///
+    std::vector<BasicBlock *> preds;
+
+    ///
+    /// @brief 后继基本块
+    ///
+    std::vector<BasicBlock *> succs;
+
+    ///
+    /// @brief 按指令顺序的编号
+    ///
+    int32_t index = -1;
+
+    ///
+    /// @brief 逆后序中的编号，-1表示从入口不可达
+    ///
+    int32_t rpoIndex = -1;
+
+    ///
+    /// @brief 立即支配块
+    ///
+    BasicBlock * idom = nullptr;
+
+    ///
+    /// @brief 支配树上的孩子
+    ///
+    std::vector<BasicBlock *> domChildren;
+
+    ///
+    /// @brief 支配边界
+    ///
+    std::vector<BasicBlock *> domFrontier;
+};
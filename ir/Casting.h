@@ -0,0 +1,82 @@
+///
+/// @file Casting.h
+/// @brief 按Value的种类标记进行类型判断与转换的isa/cast/dyn_cast，不依赖RTTI
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <cassert>
+
+///
+/// 用法与LLVM相同，目标类需提供静态函数 static bool classof(const Value *)，
+/// 根据种类标记（指令还要根据操作码）判断一个Value是否属于该类，判断只是整数比较
+///
+
+///
+/// @brief 判断value是否属于To类
+/// @param value 非空的值
+/// @return true 属于
+/// @return false 不属于
+///
+template <typename To, typename From>
+[[nodiscard]] inline bool isa(const From * value)
+{
+    assert(value && "isa<> used on a null pointer");
+    return To::classof(value);
+}
+
+///
+/// @brief 转换为To类，调用者需确保value属于To类
+/// @param value 非空的值
+/// @return To* 转换后的指针
+///
+template <typename To, typename From>
+[[nodiscard]] inline To * cast(From * value)
+{
+    assert(isa<To>(value) && "cast<Ty>() argument of incompatible type!");
+    return static_cast<To *>(value);
+}
+
+///
+/// @brief 转换为To类，常量指针的版本
+/// @param value 非空的值
+/// @return const To* 转换后的指针
+///
+template <typename To, typename From>
+[[nodiscard]] inline const To * cast(const From * value)
+{
+    assert(isa<To>(value) && "cast<Ty>() argument of incompatible type!");
+    return static_cast<const To *>(value);
+}
+
+///
+/// @brief 属于To类时转换为To类，否则返回nullptr
+/// @param value 非空的值
+/// @return To* 转换后的指针，不属于时为nullptr
+///
+template <typename To, typename From>
+[[nodiscard]] inline To * dyn_cast(From * value)
+{
+    return isa<To>(value) ? static_cast<To *>(value) : nullptr;
+}
+
+///
+/// @brief 属于To类时转换为To类，否则返回nullptr，常量指针的版本
+/// @param value 非空的值
+/// @return const To* 转换后的指针，不属于时为nullptr
+///
+template <typename To, typename From>
+[[nodiscard]] inline const To * dyn_cast(const From * value)
+{
+    return isa<To>(value) ? static_cast<const To *>(value) : nullptr;
+}
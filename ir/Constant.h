@@ -34,11 +34,26 @@
 ///
 class Constant : public User {
 
+public:
+    ///
+    /// @brief 是否是常量，供isa/cast/dyn_cast使用
+    /// @param value 值
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * value)
+    {
+        return (value->getValueKind() >= ValueKind::VK_CONST_INT) && (value->getValueKind() <= ValueKind::VK_FUNCTION);
+    }
+
 protected:
     ///
     /// @brief 构造函数
+    /// @param _kind  具体的种类
     /// @param _type  类型
     ///
-    Constant(Type * _type) : User(_type)
-    {}
+    Constant(ValueKind _kind, Type * _type) : User(_kind, _type)
+    {
+        // 常量、全局变量与函数在模块内共享
+        shared = true;
+    }
 };
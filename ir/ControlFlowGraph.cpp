@@ -0,0 +1,287 @@
+///
+/// @file ControlFlowGraph.cpp
+/// @brief 函数的控制流图的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.2
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>增加支配树与支配边界的计算
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>支配信息改为单独计算，由分析管理器按需计算与缓存
+/// </table>
+///
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#include "ControlFlowGraph.h"
+#include "Casting.h"
+#include "Function.h"
+#include "GotoInstruction.h"
+#include "LabelInstruction.h"
+
+/// @brief 析构函数，释放基本块
+ControlFlowGraph::~ControlFlowGraph()
+{
+    clear();
+}
+
+/// @brief 对函数的线性IR划分基本块，建立控制流的边并计算逆后序
+/// @param _func 函数
+void ControlFlowGraph::build(Function * _func)
+{
+    clear();
+
+    func = _func;
+
+    InterCode & code = func->getInterCode();
+
+    // 划分基本块：Label指令开始一个新块，goto与exit指令结束当前块
+    Instruction * first = nullptr;
+    for (Instruction * inst: code) {
+
+        if (first && isa<LabelInstruction>(inst)) {
+            blocks.push_back(new BasicBlock(&code, first, inst->getPrevInst()));
+            first = nullptr;
+        }
+
+        if (!first) {
+            first = inst;
+        }
+
+        IRInstOperator op = inst->getOp();
+        if ((op == IRInstOperator::IRINST_OP_GOTO) || (op == IRInstOperator::IRINST_OP_EXIT)) {
+            blocks.push_back(new BasicBlock(&code, first, inst));
+            first = nullptr;
+        }
+    }
+
+    if (first) {
+        blocks.push_back(new BasicBlock(&code, first, code.back()));
+    }
+
+    // 设置块的编号与指令所在的块，goto指令通过目标Label指令所在的块找到后继
+    for (size_t k = 0; k < blocks.size(); ++k) {
+        BasicBlock * bb = blocks[k];
+        bb->index = (int32_t) k;
+        for (Instruction * inst: *bb) {
+            inst->block = bb;
+        }
+    }
+
+    // 建立控制流的边，块末的goto跳转到目标块，exit没有后继，其它的落空到下一块
+    for (size_t k = 0; k < blocks.size(); ++k) {
+        BasicBlock * bb = blocks[k];
+        Instruction * last = bb->getLastInst();
+
+        if (auto * gotoInst = dyn_cast<GotoInstruction>(last)) {
+            BasicBlock * target = gotoInst->getTarget()->getBasicBlock();
+            assert(target && "goto target label is not in the function");
+            bb->addSuccessor(target);
+        } else if (last->getOp() == IRInstOperator::IRINST_OP_EXIT) {
+            exitBlock = bb;
+        } else if (k + 1 < blocks.size()) {
+            bb->addSuccessor(blocks[k + 1]);
+        }
+    }
+
+    computeReversePostOrder();
+}
+
+/// @brief 释放所有的基本块，指令不再属于任何块
+void ControlFlowGraph::clear()
+{
+    if (func) {
+        for (Instruction * inst: func->getInterCode()) {
+            inst->block = nullptr;
+        }
+    }
+
+    for (BasicBlock * bb: blocks) {
+        delete bb;
+    }
+
+    blocks.clear();
+    rpo.clear();
+    exitBlock = nullptr;
+}
+
+/// @brief 从入口块深度优先遍历，按后序的逆序排列可达的块
+void ControlFlowGraph::computeReversePostOrder()
+{
+    rpo.clear();
+
+    for (BasicBlock * bb: blocks) {
+        bb->rpoIndex = -1;
+    }
+
+    if (blocks.empty()) {
+        return;
+    }
+
+    // 显式栈避免递归过深，栈元素为基本块与下一个要访问的后继的下标
+    std::vector<std::pair<BasicBlock *, size_t>> stack;
+    std::vector<bool> visited(blocks.size(), false);
+
+    visited[0] = true;
+    stack.emplace_back(blocks[0], 0);
+
+    while (!stack.empty()) {
+        auto & [bb, next] = stack.back();
+
+        if (next < bb->succs.size()) {
+            BasicBlock * succ = bb->succs[next++];
+            if (!visited[succ->index]) {
+                visited[succ->index] = true;
+                stack.emplace_back(succ, 0);
+            }
+        } else {
+            rpo.push_back(bb);
+            stack.pop_back();
+        }
+    }
+
+    std::reverse(rpo.begin(), rpo.end());
+
+    for (size_t k = 0; k < rpo.size(); ++k) {
+        rpo[k]->rpoIndex = (int32_t) k;
+    }
+}
+
+/// @brief 按Cooper、Harvey与Kennedy的迭代算法计算立即支配块，只考虑从入口可达的块。
+/// 逆后序中前驱先于后继处理，无回边时一遍即可收敛
+void ControlFlowGraph::computeDominators()
+{
+    for (BasicBlock * bb: blocks) {
+        bb->idom = nullptr;
+        bb->domChildren.clear();
+        bb->domFrontier.clear();
+    }
+
+    if (rpo.empty()) {
+        return;
+    }
+
+    // 求两个块在支配树上的最近公共祖先，逆后序编号越小越靠近入口
+    auto intersect = [](BasicBlock * a, BasicBlock * b) {
+        while (a != b) {
+            while (a->rpoIndex > b->rpoIndex) {
+                a = a->idom;
+            }
+            while (b->rpoIndex > a->rpoIndex) {
+                b = b->idom;
+            }
+        }
+        return a;
+    };
+
+    // 迭代时入口块的立即支配块暂设为自身
+    BasicBlock * entry = rpo.front();
+    entry->idom = entry;
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        for (size_t k = 1; k < rpo.size(); ++k) {
+            BasicBlock * bb = rpo[k];
+
+            BasicBlock * newIDom = nullptr;
+            for (BasicBlock * pred: bb->preds) {
+                if (pred->idom == nullptr) {
+                    // 不可达或者还没有处理的前驱
+                    continue;
+                }
+                newIDom = newIDom ? intersect(pred, newIDom) : pred;
+            }
+
+            if (bb->idom != newIDom) {
+                bb->idom = newIDom;
+                changed = true;
+            }
+        }
+    }
+
+    entry->idom = nullptr;
+
+    for (size_t k = 1; k < rpo.size(); ++k) {
+        rpo[k]->idom->domChildren.push_back(rpo[k]);
+    }
+
+    // 支配边界：汇合点的每个可达前驱沿支配树向上，直到汇合点的立即支配块为止，途经的块的支配边界含汇合点
+    for (BasicBlock * bb: rpo) {
+        if (bb->preds.size() < 2) {
+            continue;
+        }
+
+        for (BasicBlock * pred: bb->preds) {
+            if (pred->rpoIndex < 0) {
+                continue;
+            }
+
+            for (BasicBlock * runner = pred; runner != bb->idom; runner = runner->idom) {
+                auto & frontier = runner->domFrontier;
+                if (std::find(frontier.begin(), frontier.end(), bb) == frontier.end()) {
+                    frontier.push_back(bb);
+                }
+            }
+        }
+    }
+}
+
+/// @brief 删除从入口块不可达的基本块及其中的指令，出口块始终保留
+/// @return int32_t 删除的基本块个数
+int32_t ControlFlowGraph::removeUnreachableBlocks()
+{
+    InterCode & code = func->getInterCode();
+
+    std::vector<BasicBlock *> live;
+    std::vector<BasicBlock *> dead;
+    for (BasicBlock * bb: blocks) {
+        if ((bb->rpoIndex >= 0) || (bb == exitBlock)) {
+            live.push_back(bb);
+        } else {
+            dead.push_back(bb);
+        }
+    }
+
+    if (dead.empty()) {
+        return 0;
+    }
+
+    // 先清除不可达指令的操作数，不可达块之间的使用先解除，再删除指令
+    for (BasicBlock * bb: dead) {
+        for (Instruction * inst: *bb) {
+            inst->clearOperands();
+        }
+
+        // 前驱也都不可达，只需从后继的前驱中去掉
+        for (BasicBlock * succ: bb->succs) {
+            auto & preds = succ->preds;
+            preds.erase(std::remove(preds.begin(), preds.end(), bb), preds.end());
+        }
+    }
+
+    for (BasicBlock * bb: dead) {
+        Instruction * inst = bb->getFirstInst();
+        Instruction * end = bb->getLastInst()->getNextInst();
+        while (inst != end) {
+            assert(!inst->hasUses() && "unreachable instruction is used by reachable code");
+            inst = code.erase(inst);
+        }
+        delete bb;
+    }
+
+    blocks = std::move(live);
+
+    for (size_t k = 0; k < blocks.size(); ++k) {
+        blocks[k]->index = (int32_t) k;
+    }
+
+    return (int32_t) dead.size();
+}
@@ -0,0 +1,137 @@
+///
+/// @file ControlFlowGraph.h
+/// @brief 函数的控制流图，按Label与goto/exit指令把线性IR划分为基本块并建立前驱后继关系
+/// @author zenglj (zenglj@live.com)
+/// @version 1.2
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>增加支配树与支配边界的计算
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>支配信息改为单独计算，由分析管理器按需计算与缓存
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "BasicBlock.h"
+
+class Function;
+
+///
+/// @brief 控制流图。基本块按指令顺序编号，第一个块为入口块，含exit指令的块为出口块。
+/// 线性IR修改后需重新build，基本块只是指令序列上的划分，删除基本块时其指令也一并删除
+///
+class ControlFlowGraph {
+
+public:
+    ControlFlowGraph() = default;
+
+    ///
+    /// @brief 析构函数，释放基本块，指令归函数所有不释放
+    ///
+    ~ControlFlowGraph();
+
+    ControlFlowGraph(const ControlFlowGraph &) = delete;
+    ControlFlowGraph & operator=(const ControlFlowGraph &) = delete;
+
+    ///
+    /// @brief 对函数的线性IR划分基本块，建立控制流的边并计算逆后序
+    /// @param func 函数
+    ///
+    void build(Function * func);
+
+    ///
+    /// @brief 按逆后序迭代计算立即支配块，再建立支配树与支配边界。
+    /// 只依赖于控制流图的形状，控制流图不变时不需要重新计算
+    ///
+    void computeDominators();
+
+    ///
+    /// @brief 释放所有的基本块
+    ///
+    void clear();
+
+    ///
+    /// @brief 删除从入口块不可达的基本块及其中的指令，出口块始终保留
+    /// @return int32_t 删除的基本块个数
+    ///
+    int32_t removeUnreachableBlocks();
+
+    ///
+    /// @brief 是否还没有划分基本块
+    /// @return true 没有基本块 false 有基本块
+    ///
+    [[nodiscard]] bool empty() const
+    {
+        return blocks.empty();
+    }
+
+    ///
+    /// @brief 获取入口基本块
+    /// @return BasicBlock* 入口块，没有划分基本块时为nullptr
+    ///
+    [[nodiscard]] BasicBlock * getEntry() const
+    {
+        return blocks.empty() ? nullptr : blocks.front();
+    }
+
+    ///
+    /// @brief 获取出口基本块，即含有exit指令的块
+    /// @return BasicBlock* 出口块，没有时为nullptr
+    ///
+    [[nodiscard]] BasicBlock * getExit() const
+    {
+        return exitBlock;
+    }
+
+    ///
+    /// @brief 获取按指令顺序排列的所有基本块
+    /// @return const std::vector<BasicBlock *>& 基本块列表
+    ///
+    [[nodiscard]] const std::vector<BasicBlock *> & getBlocks() const
+    {
+        return blocks;
+    }
+
+    ///
+    /// @brief 获取从入口可达的基本块的逆后序，前驱（回边除外）总排在后继之前
+    /// @return const std::vector<BasicBlock *>& 逆后序的基本块列表
+    ///
+    [[nodiscard]] const std::vector<BasicBlock *> & getReversePostOrder() const
+    {
+        return rpo;
+    }
+
+private:
+    ///
+    /// @brief 从入口块深度优先遍历，计算逆后序
+    ///
+    void computeReversePostOrder();
+
+    ///
+    /// @brief 所属的函数
+    ///
+    Function * func = nullptr;
+
+    ///
+    /// @brief 按指令顺序排列的基本块
+    ///
+    std::vector<BasicBlock *> blocks;
+
+    ///
+    /// @brief 从入口可达的基本块的逆后序
+    ///
+    std::vector<BasicBlock *> rpo;
+
+    ///
+    /// @brief 出口块
+    ///
+    BasicBlock * exitBlock = nullptr;
+};
@@ -2,7 +2,7 @@
 /// @file Function.cpp
 /// @brief 函数实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.2
 /// @date 2024-11-21
 ///
 /// @copyright Copyright (c) 2024
@@ -11,6 +11,8 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>函数内的指令与变量在函数的内存池中创建，Delete时整体释放
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>释放函数时先释放控制流图
 /// </table>
 ///
 
@@ -25,7 +27,7 @@
 /// @param _type 函数类型
 /// @param _builtin 是否是内置函数
 Function::Function(std::string _name, FunctionType * _type, bool _builtin)
-    : GlobalValue(_type, _name), builtIn(_builtin)
+    : GlobalValue(ValueKind::VK_FUNCTION, _type, _name), builtIn(_builtin)
 {
     returnType = _type->getReturnType();
 
@@ -40,6 +42,11 @@ Function::Function(std::string _name, FunctionType * _type, bool _builtin)
 Function::~Function()
 {
     Delete();
+
+    // 形参在函数的整个生命期内有效，流式编译释放函数体时保留
+    for (auto param: params) {
+        delete param;
+    }
 }
 
 /// @brief 获取函数返回类型
@@ -117,7 +124,7 @@ void Function::toString(std::string & str)
 
     // 输出临时变量的declare形式
     // 遍历所有的线性IR指令，文本输出
-    for (auto & inst: code.getInsts()) {
+    for (auto inst: code) {
 
         if (inst->hasResultValue()) {
 
@@ -127,7 +134,7 @@ void Function::toString(std::string & str)
     }
 
     // 遍历所有的线性IR指令，文本输出
-    for (auto & inst: code.getInsts()) {
+    for (auto inst: code) {
 
         std::string instStr;
         inst->toString(instStr);
@@ -238,10 +245,10 @@ void Function::setExistFuncCall(bool exist)
 /// @param name 变量ID
 /// @param type 变量类型
 /// @param scope_level 局部变量的作用域层级
-LocalVariable * Function::newLocalVarValue(Type * type, std::string name, int32_t scope_level)
+LocalVariable * Function::newLocalVarValue(Type * type, SymbolId name, int32_t scope_level)
 {
     // 创建变量并加入符号表
-    LocalVariable * varValue = new LocalVariable(type, name, scope_level);
+    LocalVariable * varValue = new (arena) LocalVariable(type, name, scope_level);
 
     // varsVector表中可能存在变量重名的信息
     varsVector.push_back(varValue);
@@ -255,7 +262,7 @@ LocalVariable * Function::newLocalVarValue(Type * type, std::string name, int32_
 MemVariable * Function::newMemVariable(Type * type)
 {
     // 肯定唯一存在，直接插入即可
-    MemVariable * memValue = new MemVariable(type);
+    MemVariable * memValue = new (arena) MemVariable(type);
 
     memVector.push_back(memValue);
 
@@ -265,6 +272,9 @@ MemVariable * Function::newMemVariable(Type * type)
 /// @brief 清理函数内申请的资源
 void Function::Delete()
 {
+    // 基本块引用着指令，先于指令释放
+    cfg.clear();
+
     // 清理IR指令
     code.Delete();
 
@@ -274,6 +284,19 @@ void Function::Delete()
     }
 
     varsVector.clear();
+
+    for (auto & var: memVector) {
+        delete var;
+    }
+
+    memVector.clear();
+
+    // 函数内的对象都已析构，内存整体归还，不再逐个释放
+    arena.release();
+
+    // 出口Label指令和返回值变量已随指令和局部变量一起释放，流式编译时函数体释放后函数本身仍保留
+    exitLabel = nullptr;
+    returnValue = nullptr;
 }
 
 ///
@@ -300,7 +323,7 @@ void Function::renameIR()
     }
 
     // 遍历所有的指令进行命名
-    for (auto inst: this->getInterCode().getInsts()) {
+    for (auto inst: this->getInterCode()) {
         if (inst->getOp() == IRInstOperator::IRINST_OP_LABEL) {
             inst->setIRName(IR_LABEL_PREFIX + std::to_string(nameIndex++));
         } else if (inst->hasResultValue()) {
@@ -2,7 +2,7 @@
 /// @file Function.cpp
 /// @brief 函数头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.2
 /// @date 2024-11-21
 ///
 /// @copyright Copyright (c) 2024
@@ -11,6 +11,8 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>函数内的指令与变量在函数的内存池中创建
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>增加函数的控制流图
 /// </table>
 ///
 #pragma once
@@ -24,6 +26,7 @@
 #include "LocalVariable.h"
 #include "MemVariable.h"
 #include "IRCode.h"
+#include "ControlFlowGraph.h"
 
 ///
 /// @brief 描述函数信息的类，是全局静态存储，其Value的类型为FunctionType
@@ -31,6 +34,16 @@
 class Function : public GlobalValue {
 
 public:
+    ///
+    /// @brief 是否是函数，供isa/cast/dyn_cast使用
+    /// @param value 值
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * value)
+    {
+        return value->getValueKind() == ValueKind::VK_FUNCTION;
+    }
+
     /// @brief 指定函数名字、函数返回类型以及函数形式参数的构造函数
     /// @param _name
     /// @param _type
@@ -55,6 +68,20 @@ public:
     /// @return IR指令代码
     InterCode & getInterCode();
 
+    /// @brief 获取函数的控制流图，线性IR修改后需重新build
+    /// @return 控制流图
+    ControlFlowGraph & getCFG()
+    {
+        return cfg;
+    }
+
+    /// @brief 获取函数的内存池，函数内的指令与变量都在其中创建，Delete时整体释放
+    /// @return 内存池
+    Arena & getArena()
+    {
+        return arena;
+    }
+
     /// @brief 判断该函数是否是内置函数
     /// @return true: 内置函数，false：用户自定义
     bool isBuiltin();
@@ -139,14 +166,14 @@ public:
     /// @param name 变量ID
     /// @param type 变量类型
     /// @param existInit 缺省为true。若真，则已存在需要进行初始化，否则什么都不做
-    LocalVariable * newLocalVarValue(Type * type, std::string name = "", int32_t scope_level = 1);
+    LocalVariable * newLocalVarValue(Type * type, SymbolId name = EmptySymbol, int32_t scope_level = 1);
 
     /// @brief 新建一个内存型的Value，并加入到符号表，用于后续释放空间
     /// \param type 变量类型
     /// \return 临时变量Value
     MemVariable * newMemVariable(Type * type);
 
-    /// @brief 清理函数内申请的资源
+    /// @brief 清理函数内申请的资源，函数内的指令与变量析构后，内存池整体释放
     void Delete();
 
     ///
@@ -171,6 +198,11 @@ public:
     void realArgCountReset();
 
 private:
+    ///
+    /// @brief 函数的内存池，最先构造、最后析构，其中的对象都析构后才释放
+    ///
+    Arena arena{8 * 1024};
+
     ///
     /// @brief 函数的返回值类型，有点冗余，可删除，直接从type中取得即可
     ///
@@ -191,6 +223,11 @@ private:
     ///
     InterCode code;
 
+    ///
+    /// @brief 线性IR指令上划分出的基本块及控制流图
+    ///
+    ControlFlowGraph cfg;
+
     ///
     /// @brief 函数内变量的向量表，可能重名，请注意
     ///
@@ -2,8 +2,8 @@
 /// @file IRGenerator.cpp
 /// @brief AST遍历产生线性IR的源文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.5
+/// @date 2026-10-15
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,11 +12,16 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>节点的值与指令块改为按节点编号保存
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>函数体并行翻译
+/// <tr><td>2026-10-15 <td>1.4     <td>zenglj  <td>指令直接追加到当前函数，不再经由节点的指令块
+/// <tr><td>2026-10-15 <td>1.5     <td>zenglj  <td>节点的动作函数表改为按运算符索引的编译期数组
 /// </table>
 ///
+#include <atomic>
 #include <cstdint>
 #include <cstdio>
-#include <unordered_map>
+#include <array>
 #include <vector>
 #include <iostream>
 
@@ -33,46 +38,55 @@
 #include "BinaryInstruction.h"
 #include "MoveInstruction.h"
 #include "GotoInstruction.h"
+#include "ThreadPool.h"
 
 /// @brief 构造函数
 /// @param _root AST的根
 /// @param _module 符号表
 IRGenerator::IRGenerator(ast_node * _root, Module * _module) : root(_root), module(_module)
-{
-    /* 叶子节点 */
-    ast2ir_handlers[ast_operator_type::AST_OP_LEAF_LITERAL_UINT] = &IRGenerator::ir_leaf_node_uint;
-    ast2ir_handlers[ast_operator_type::AST_OP_LEAF_VAR_ID] = &IRGenerator::ir_leaf_node_var_id;
-    ast2ir_handlers[ast_operator_type::AST_OP_LEAF_TYPE] = &IRGenerator::ir_leaf_node_type;
+{}
 
-    /* 表达式运算， 加减乘除模 */
-    ast2ir_handlers[ast_operator_type::AST_OP_ADD] = &IRGenerator::ir_add;
-    ast2ir_handlers[ast_operator_type::AST_OP_SUB] = &IRGenerator::ir_sub;
-    ast2ir_handlers[ast_operator_type::AST_OP_MUL] = &IRGenerator::ir_mul;
-    ast2ir_handlers[ast_operator_type::AST_OP_DIV] = &IRGenerator::ir_div;
-    ast2ir_handlers[ast_operator_type::AST_OP_MOD] = &IRGenerator::ir_mod;
-    ast2ir_handlers[ast_operator_type::AST_OP_NEG] = &IRGenerator::ir_neg;
+/// @brief AST节点运算符与动作函数关联的表，按运算符直接索引，编译期生成
+constexpr std::array<IRGenerator::ast2ir_handler_t, (size_t) ast_operator_type::AST_OP_MAX>
+    IRGenerator::ast2ir_handlers = [] {
+        std::array<ast2ir_handler_t, (size_t) ast_operator_type::AST_OP_MAX> handlers{};
 
-    /* 语句 */
-    ast2ir_handlers[ast_operator_type::AST_OP_ASSIGN] = &IRGenerator::ir_assign;
-    ast2ir_handlers[ast_operator_type::AST_OP_RETURN] = &IRGenerator::ir_return;
+        /* 叶子节点 */
+        handlers[(size_t) ast_operator_type::AST_OP_LEAF_LITERAL_UINT] = &IRGenerator::ir_leaf_node_uint;
+        handlers[(size_t) ast_operator_type::AST_OP_LEAF_VAR_ID] = &IRGenerator::ir_leaf_node_var_id;
+        handlers[(size_t) ast_operator_type::AST_OP_LEAF_TYPE] = &IRGenerator::ir_leaf_node_type;
 
-    /* 函数调用 */
-    ast2ir_handlers[ast_operator_type::AST_OP_FUNC_CALL] = &IRGenerator::ir_function_call;
+        /* 表达式运算， 加减乘除模 */
+        handlers[(size_t) ast_operator_type::AST_OP_ADD] = &IRGenerator::ir_add;
+        handlers[(size_t) ast_operator_type::AST_OP_SUB] = &IRGenerator::ir_sub;
+        handlers[(size_t) ast_operator_type::AST_OP_MUL] = &IRGenerator::ir_mul;
+        handlers[(size_t) ast_operator_type::AST_OP_DIV] = &IRGenerator::ir_div;
+        handlers[(size_t) ast_operator_type::AST_OP_MOD] = &IRGenerator::ir_mod;
+        handlers[(size_t) ast_operator_type::AST_OP_NEG] = &IRGenerator::ir_neg;
 
-    /* 函数定义 */
-    ast2ir_handlers[ast_operator_type::AST_OP_FUNC_DEF] = &IRGenerator::ir_function_define;
-    ast2ir_handlers[ast_operator_type::AST_OP_FUNC_FORMAL_PARAMS] = &IRGenerator::ir_function_formal_params;
+        /* 语句 */
+        handlers[(size_t) ast_operator_type::AST_OP_ASSIGN] = &IRGenerator::ir_assign;
+        handlers[(size_t) ast_operator_type::AST_OP_RETURN] = &IRGenerator::ir_return;
 
-    /* 变量定义语句 */
-    ast2ir_handlers[ast_operator_type::AST_OP_DECL_STMT] = &IRGenerator::ir_declare_statment;
-    ast2ir_handlers[ast_operator_type::AST_OP_VAR_DECL] = &IRGenerator::ir_variable_declare;
+        /* 函数调用 */
+        handlers[(size_t) ast_operator_type::AST_OP_FUNC_CALL] = &IRGenerator::ir_function_call;
 
-    /* 语句块 */
-    ast2ir_handlers[ast_operator_type::AST_OP_BLOCK] = &IRGenerator::ir_block;
+        /* 函数定义 */
+        handlers[(size_t) ast_operator_type::AST_OP_FUNC_DEF] = &IRGenerator::ir_function_define;
+        handlers[(size_t) ast_operator_type::AST_OP_FUNC_FORMAL_PARAMS] = &IRGenerator::ir_function_formal_params;
 
-    /* 编译单元 */
-    ast2ir_handlers[ast_operator_type::AST_OP_COMPILE_UNIT] = &IRGenerator::ir_compile_unit;
-}
+        /* 变量定义语句 */
+        handlers[(size_t) ast_operator_type::AST_OP_DECL_STMT] = &IRGenerator::ir_declare_statment;
+        handlers[(size_t) ast_operator_type::AST_OP_VAR_DECL] = &IRGenerator::ir_variable_declare;
+
+        /* 语句块 */
+        handlers[(size_t) ast_operator_type::AST_OP_BLOCK] = &IRGenerator::ir_block;
+
+        /* 编译单元 */
+        handlers[(size_t) ast_operator_type::AST_OP_COMPILE_UNIT] = &IRGenerator::ir_compile_unit;
+
+        return handlers;
+    }();
 
 /// @brief 遍历抽象语法树产生线性IR，保存到IRCode中
 /// @param root 抽象语法树
@@ -80,14 +94,257 @@ IRGenerator::IRGenerator(ast_node * _root, Module * _module) : root(_root), modu
 /// @return true: 成功 false: 失败
 bool IRGenerator::run()
 {
-    ast_node * node;
+    unsigned count = threadCount ? threadCount : ThreadPool::hardwareThreads();
+
+    if ((count <= 1) || (root->node_type != ast_operator_type::AST_OP_COMPILE_UNIT)) {
+        // 串行翻译
+        return translate(root);
+    }
+
+    // 先串行声明全部函数与全局变量，函数体再并行翻译
+    std::vector<FunctionJob> jobs;
+    if (!declareCompileUnit(root, jobs)) {
+        return false;
+    }
+
+    return translateFunctions(jobs);
+}
+
+/// @brief 流式编译时翻译编译单元中的一个顶层定义（函数定义或者变量声明语句），结果保存到符号表中
+/// @param item 顶层定义的AST节点
+/// @return true: 成功 false: 失败
+bool IRGenerator::runUnitItem(ast_node * item)
+{
+    // 顶层定义都在函数外
+    currentFunc = nullptr;
 
-    // 从根节点进行遍历
-    node = ir_visit_ast_node(root);
+    return translate(item);
+}
+
+/// @brief 从指定节点开始遍历产生线性IR，节点的翻译结果只在遍历期间保存
+/// @param node AST节点
+/// @return true: 成功 false: 失败
+bool IRGenerator::translate(ast_node * node)
+{
+    prepareNodeTables(node);
+
+    // 从指定节点进行遍历
+    node = ir_visit_ast_node(node);
+
+    releaseNodeTables();
 
     return node != nullptr;
 }
 
+/// @brief 串行阶段：按次序声明编译单元中的函数，翻译全局变量，函数体留作任务
+/// @param node 编译单元节点
+/// @param jobs 函数体翻译任务
+/// @return true: 成功 false: 失败
+bool IRGenerator::declareCompileUnit(ast_node * node, std::vector<FunctionJob> & jobs)
+{
+    currentFunc = nullptr;
+
+    for (auto son: node->sons()) {
+
+        if (son->node_type != ast_operator_type::AST_OP_FUNC_DEF) {
+
+            // 全局变量的声明等直接翻译
+            if (!translate(son)) {
+                return false;
+            }
+
+            continue;
+        }
+
+        Function * func = ir_function_declare(son);
+        if (!func) {
+            return false;
+        }
+
+        // 函数体中只能看到定义在前面的函数（含自身）以及声明在前面的全局变量
+        jobs.push_back({son,
+                        func,
+                        (uint32_t) module->getFunctionList().size(),
+                        (uint32_t) module->getGlobalVariables().size()});
+    }
+
+    return true;
+}
+
+/// @brief 并行阶段：在线程池上翻译全部函数体，每个工作线程有自己的生成器
+/// @param jobs 函数体翻译任务
+/// @return true: 成功 false: 失败
+bool IRGenerator::translateFunctions(std::vector<FunctionJob> & jobs)
+{
+    unsigned count = threadCount ? threadCount : ThreadPool::hardwareThreads();
+    if (count > jobs.size()) {
+        count = (unsigned) jobs.size();
+    }
+
+    if (count <= 1) {
+        // 函数太少，直接在当前线程翻译
+        for (auto & job: jobs) {
+            if (!translateFunction(job)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // 下一个要翻译的任务，工作线程翻译完一个函数后再取下一个，函数大小不一时负载也能均衡
+    std::atomic<size_t> nextJob{0};
+    std::atomic<bool> result{true};
+
+    ThreadPool pool(count);
+
+    // AST由当前线程构造，存储在当前线程的AST存储中
+    ASTContext * context = ast_context;
+
+    for (unsigned k = 0; k < count; ++k) {
+
+        pool.submit([this, &jobs, &nextJob, &result, context]() {
+            // 工作线程遍历的AST在当前线程的AST存储中
+            ast_context = context;
+
+            // 每个工作线程一个生成器，有自己的当前函数、作用域栈与节点翻译结果表
+            IRGenerator generator(nullptr, module);
+
+            for (size_t index = nextJob++; index < jobs.size(); index = nextJob++) {
+
+                // 出错后不再翻译剩余的函数
+                if (!result) {
+                    break;
+                }
+
+                if (!generator.translateFunction(jobs[index])) {
+                    result = false;
+                }
+            }
+        });
+    }
+
+    pool.wait();
+
+    return result;
+}
+
+/// @brief 翻译一个函数体
+/// @param job 函数体翻译任务
+/// @return true: 成功 false: 失败
+bool IRGenerator::translateFunction(const FunctionJob & job)
+{
+    visibleFunctions = job.visibleFunctions;
+    visibleGlobals = job.visibleGlobals;
+
+    prepareNodeTables(job.node);
+
+    bool result = ir_function_body(job.node, job.func);
+
+    releaseNodeTables();
+
+    return result;
+}
+
+/// @brief 为子树准备节点翻译结果表，按子树中节点编号的范围分配
+/// @param node 子树的根
+void IRGenerator::prepareNodeTables(ast_node * node)
+{
+    uint32_t minId = node->id;
+    uint32_t maxId = node->id;
+
+    // 子树的节点一般是连续创建的，编号范围与子树大小相当
+    std::vector<ast_node *> stack{node};
+    while (!stack.empty()) {
+
+        ast_node * temp = stack.back();
+        stack.pop_back();
+
+        minId = std::min(minId, temp->id);
+        maxId = std::max(maxId, temp->id);
+
+        for (auto son: temp->sons()) {
+            stack.push_back(son);
+        }
+    }
+
+    nodeIdBase = minId;
+
+    // 节点的翻译结果按节点编号保存
+    nodeValues.assign(maxId - minId + 1, nullptr);
+}
+
+/// @brief 释放节点翻译结果表
+void IRGenerator::releaseNodeTables()
+{
+    // 翻译结果只在遍历时使用
+    std::vector<Value *>().swap(nodeValues);
+}
+
+/// @brief 新建变量，函数内为局部变量，否则为全局变量
+/// @param type 变量类型
+/// @param name 变量名，局部变量可为空
+/// @return 变量，同一作用域内重名时返回nullptr
+Value * IRGenerator::newVarValue(Type * type, SymbolId name)
+{
+    if (!currentFunc) {
+        // 全局变量由符号表管理
+        return module->newVarValue(type, name);
+    }
+
+    // 若变量名有效，检查当前作用域中是否存在变量，如存在则语义错误
+    if ((name != EmptySymbol) && scopeStack.findCurrentScope(name)) {
+        minic_log(LOG_ERROR, "变量(%s)已经存在", symbolName(name).c_str());
+        return nullptr;
+    }
+
+    // 变量作用域的层级，全局作用域为0层，函数的作用域从1开始
+    int32_t scope_level = (name == EmptySymbol) ? 1 : scopeStack.getCurrentScopeLevel() + 1;
+
+    Value * retVal = currentFunc->newLocalVarValue(type, name, scope_level);
+
+    // 增加到作用域中
+    scopeStack.insertValue(retVal);
+
+    return retVal;
+}
+
+/// @brief 从内到外逐层作用域查找变量，最后查找可见的全局变量
+/// @param name 变量名
+/// @return 变量，未找到返回nullptr
+Value * IRGenerator::findVarValue(SymbolId name)
+{
+    if (currentFunc) {
+        Value * tempValue = scopeStack.findAllScope(name);
+        if (tempValue) {
+            return tempValue;
+        }
+    }
+
+    // 全局作用域只在串行阶段修改，并行翻译函数体时只读
+    Value * tempValue = module->findVarValue(name);
+    if (tempValue && (static_cast<GlobalValue *>(tempValue)->getDeclareOrder() >= visibleGlobals)) {
+        // 声明在函数的后面，不可见
+        tempValue = nullptr;
+    }
+
+    return tempValue;
+}
+
+/// @brief 查找可见的函数
+/// @param name 函数名
+/// @return 函数，未找到返回nullptr
+Function * IRGenerator::findFunction(SymbolId name)
+{
+    Function * func = module->findFunction(name);
+    if (func && (func->getDeclareOrder() >= visibleFunctions)) {
+        // 定义在当前函数的后面，不可见
+        func = nullptr;
+    }
+
+    return func;
+}
+
 /// @brief 根据AST的节点运算符查找对应的翻译函数并执行翻译动作
 /// @param node AST节点
 /// @return 成功返回node节点，否则返回nullptr
@@ -100,13 +357,16 @@ ast_node * IRGenerator::ir_visit_ast_node(ast_node * node)
 
     bool result;
 
-    std::unordered_map<ast_operator_type, ast2ir_handler_t>::const_iterator pIter;
-    pIter = ast2ir_handlers.find(node->node_type);
-    if (pIter == ast2ir_handlers.end()) {
+    ast2ir_handler_t handler = nullptr;
+    if ((size_t) node->node_type < ast2ir_handlers.size()) {
+        handler = ast2ir_handlers[(size_t) node->node_type];
+    }
+
+    if (handler == nullptr) {
         // 没有找到，则说明当前不支持
         result = (this->ir_default)(node);
     } else {
-        result = (this->*(pIter->second))(node);
+        result = (this->*handler)(node);
     }
 
     if (!result) {
@@ -123,7 +383,7 @@ ast_node * IRGenerator::ir_visit_ast_node(ast_node * node)
 bool IRGenerator::ir_default(ast_node * node)
 {
     // 未知的节点
-    printf("Unkown node(%d)\n", (int) node->node_type);
+    minic_diag("Unkown node(%d)\n", (int) node->node_type);
     return true;
 }
 
@@ -132,9 +392,9 @@ bool IRGenerator::ir_default(ast_node * node)
 /// @return 翻译是否成功，true：成功，false：失败
 bool IRGenerator::ir_compile_unit(ast_node * node)
 {
-    module->setCurrentFunction(nullptr);
+    currentFunc = nullptr;
 
-    for (auto son: node->sons) {
+    for (auto son: node->sons()) {
 
         // 遍历编译单元，要么是函数定义，要么是语句
         ast_node * son_node = ir_visit_ast_node(son);
@@ -152,38 +412,62 @@ bool IRGenerator::ir_compile_unit(ast_node * node)
 /// @return 翻译是否成功，true：成功，false：失败
 bool IRGenerator::ir_function_define(ast_node * node)
 {
-    bool result;
-
     // 创建一个函数，用于当前函数处理
-    if (module->getCurrentFunction()) {
+    if (currentFunc) {
         // 函数中嵌套定义函数，这是不允许的，错误退出
         // TODO 自行追加语义错误处理
         return false;
     }
 
+    Function * newFunc = ir_function_declare(node);
+    if (!newFunc) {
+        return false;
+    }
+
+    return ir_function_body(node, newFunc);
+}
+
+/// @brief 函数定义AST节点的声明部分，创建函数并加入符号表
+/// @param node AST节点
+/// @return 新建的函数，函数已存在时返回nullptr
+Function * IRGenerator::ir_function_declare(ast_node * node)
+{
     // 函数定义的AST包含四个孩子
     // 第一个孩子：函数返回类型
     // 第二个孩子：函数名字
     // 第三个孩子：形参列表
     // 第四个孩子：函数体即block
-    ast_node * type_node = node->sons[0];
-    ast_node * name_node = node->sons[1];
-    ast_node * param_node = node->sons[2];
-    ast_node * block_node = node->sons[3];
+    ast_node * type_node = node->sons()[0];
+    ast_node * name_node = node->sons()[1];
 
     // 创建一个新的函数定义
-    Function * newFunc = module->newFunction(name_node->name, type_node->type);
+    Function * newFunc = module->newFunction(symbolName(name_node->getName()), type_node->type);
     if (!newFunc) {
         // 新定义的函数已经存在，则失败返回。
         // TODO 自行追加语义错误处理
-        return false;
+        return nullptr;
     }
 
+    return newFunc;
+}
+
+/// @brief 函数定义AST节点的函数体部分翻译成线性中间IR，可在工作线程中执行
+/// @param node AST节点
+/// @param newFunc 已声明的函数
+/// @return 翻译是否成功，true：成功，false：失败
+bool IRGenerator::ir_function_body(ast_node * node, Function * newFunc)
+{
+    bool result;
+
+    ast_node * type_node = node->sons()[0];
+    ast_node * param_node = node->sons()[2];
+    ast_node * block_node = node->sons()[3];
+
     // 当前函数设置有效，变更为当前的函数
-    module->setCurrentFunction(newFunc);
+    currentFunc = newFunc;
 
     // 进入函数的作用域
-    module->enterScope();
+    scopeStack.enterScope();
 
     // 获取函数的IR代码列表，用于后面追加指令用，注意这里用的是引用传值
     InterCode & irCode = newFunc->getInterCode();
@@ -191,10 +475,10 @@ bool IRGenerator::ir_function_define(ast_node * node)
     // 这里也可增加一个函数入口Label指令，便于后续基本块划分
 
     // 创建并加入Entry入口指令
-    irCode.addInst(new EntryInstruction(newFunc));
+    irCode.addInst(new (newFunc->getArena()) EntryInstruction(newFunc));
 
     // 创建出口指令并不加入出口指令，等函数内的指令处理完毕后加入出口指令
-    LabelInstruction * exitLabelInst = new LabelInstruction(newFunc);
+    LabelInstruction * exitLabelInst = new (newFunc->getArena()) LabelInstruction(newFunc);
 
     // 函数出口指令保存到函数信息中，因为在语义分析函数体时return语句需要跳转到函数尾部，需要这个label指令
     newFunc->setExitLabel(exitLabelInst);
@@ -206,14 +490,13 @@ bool IRGenerator::ir_function_define(ast_node * node)
         // TODO 自行追加语义错误处理
         return false;
     }
-    node->blockInsts.addInst(param_node->blockInsts);
 
     // 新建一个Value，用于保存函数的返回值，如果没有返回值可不用申请
     LocalVariable * retValue = nullptr;
     if (!type_node->type->isVoidType()) {
 
         // 保存函数返回值变量到函数信息中，在return语句翻译时需要设置值到这个变量中
-        retValue = static_cast<LocalVariable *>(module->newVarValue(type_node->type));
+        retValue = static_cast<LocalVariable *>(newVarValue(type_node->type));
     }
     newFunc->setReturnValue(retValue);
 
@@ -230,25 +513,19 @@ bool IRGenerator::ir_function_define(ast_node * node)
         return false;
     }
 
-    // IR指令追加到当前的节点中
-    node->blockInsts.addInst(block_node->blockInsts);
-
-    // 此时，所有指令都加入到当前函数中，也就是node->blockInsts
-
-    // node节点的指令移动到函数的IR指令列表中
-    irCode.addInst(node->blockInsts);
+    // 此时，函数体的指令都已按翻译的先后追加到函数的IR指令列表中
 
     // 添加函数出口Label指令，主要用于return语句跳转到这里进行函数的退出
     irCode.addInst(exitLabelInst);
 
     // 函数出口指令
-    irCode.addInst(new ExitInstruction(newFunc, retValue));
+    irCode.addInst(new (newFunc->getArena()) ExitInstruction(newFunc, retValue));
 
     // 恢复成外部函数
-    module->setCurrentFunction(nullptr);
+    currentFunc = nullptr;
 
     // 退出函数的作用域
-    module->leaveScope();
+    scopeStack.leaveScope();
 
     return true;
 }
@@ -275,23 +552,20 @@ bool IRGenerator::ir_function_call(ast_node * node)
 {
     std::vector<Value *> realParams;
 
-    // 获取当前正在处理的函数
-    Function * currentFunc = module->getCurrentFunction();
-
     // 函数调用的节点包含两个节点：
     // 第一个节点：函数名节点
     // 第二个节点：实参列表节点
 
-    std::string funcName = node->sons[0]->name;
-    int64_t lineno = node->sons[0]->line_no;
+    SymbolId funcName = node->sons()[0]->getName();
+    int64_t lineno = node->sons()[0]->getLineNo();
 
-    ast_node * paramsNode = node->sons[1];
+    ast_node * paramsNode = node->sons()[1];
 
     // 根据函数名查找函数，看是否存在。若不存在则出错
     // 这里约定函数必须先定义后使用
-    auto calledFunction = module->findFunction(funcName);
+    auto calledFunction = findFunction(funcName);
     if (nullptr == calledFunction) {
-        minic_log(LOG_ERROR, "函数(%s)未定义或声明", funcName.c_str());
+        minic_log(LOG_ERROR, "函数(%s)未定义或声明", symbolName(funcName).c_str());
         return false;
     }
 
@@ -299,9 +573,9 @@ bool IRGenerator::ir_function_call(ast_node * node)
     currentFunc->setExistFuncCall(true);
 
     // 如果没有孩子，也认为是没有参数
-    if (!paramsNode->sons.empty()) {
+    if (!paramsNode->sons().empty()) {
 
-        int32_t argsCount = (int32_t) paramsNode->sons.size();
+        int32_t argsCount = (int32_t) paramsNode->sons().size();
 
         // 当前函数中调用函数实参个数最大值统计，实际上是统计实参传参需在栈中分配的大小
         // 因为目前的语言支持的int和float都是四字节的，只统计个数即可
@@ -311,7 +585,7 @@ bool IRGenerator::ir_function_call(ast_node * node)
 
         // 遍历参数列表，孩子是表达式
         // 这里自左往右计算表达式
-        for (auto son: paramsNode->sons) {
+        for (auto son: paramsNode->sons()) {
 
             // 遍历Block的每个语句，进行显示或者运算
             ast_node * temp = ir_visit_ast_node(son);
@@ -319,28 +593,31 @@ bool IRGenerator::ir_function_call(ast_node * node)
                 return false;
             }
 
-            realParams.push_back(temp->val);
-            node->blockInsts.addInst(temp->blockInsts);
+            realParams.push_back(val(temp));
         }
     }
 
     // TODO 这里请追加函数调用的语义错误检查，这里只进行了函数参数的个数检查等，其它请自行追加。
     if (realParams.size() != calledFunction->getParams().size()) {
         // 函数参数的个数不一致，语义错误
-        minic_log(LOG_ERROR, "第%lld行的被调用函数(%s)未定义或声明", (long long) lineno, funcName.c_str());
+        minic_log(LOG_ERROR,
+                  "第%lld行的被调用函数(%s)未定义或声明",
+                  (long long) lineno,
+                  symbolName(funcName).c_str());
         return false;
     }
 
     // 返回调用有返回值，则需要分配临时变量，用于保存函数调用的返回值
     Type * type = calledFunction->getReturnType();
 
-    FuncCallInstruction * funcCallInst = new FuncCallInstruction(currentFunc, calledFunction, realParams, type);
+    FuncCallInstruction * funcCallInst =
+        new (currentFunc->getArena()) FuncCallInstruction(currentFunc, calledFunction, realParams, type);
 
     // 创建函数调用指令
-    node->blockInsts.addInst(funcCallInst);
+    emitInst(funcCallInst);
 
-    // 函数调用结果Value保存到node中，可能为空，上层节点可利用这个值
-    node->val = funcCallInst;
+    // 函数调用结果Value保存为node的值，可能为空，上层节点可利用这个值
+    val(node) = funcCallInst;
 
     return true;
 }
@@ -352,24 +629,21 @@ bool IRGenerator::ir_block(ast_node * node)
 {
     // 进入作用域
     if (node->needScope) {
-        module->enterScope();
+        scopeStack.enterScope();
     }
 
-    std::vector<ast_node *>::iterator pIter;
-    for (pIter = node->sons.begin(); pIter != node->sons.end(); ++pIter) {
+    for (auto pIter = node->sons().begin(); pIter != node->sons().end(); ++pIter) {
 
         // 遍历Block的每个语句，进行显示或者运算
         ast_node * temp = ir_visit_ast_node(*pIter);
         if (!temp) {
             return false;
         }
-
-        node->blockInsts.addInst(temp->blockInsts);
     }
 
     // 离开作用域
     if (node->needScope) {
-        module->leaveScope();
+        scopeStack.leaveScope();
     }
 
     return true;
@@ -380,8 +654,8 @@ bool IRGenerator::ir_block(ast_node * node)
 /// @return 翻译是否成功，true：成功，false：失败
 bool IRGenerator::ir_add(ast_node * node)
 {
-    ast_node * src1_node = node->sons[0];
-    ast_node * src2_node = node->sons[1];
+    ast_node * src1_node = node->sons()[0];
+    ast_node * src2_node = node->sons()[1];
 
     // 加法节点，左结合，先计算左节点，后计算右节点
 
@@ -401,18 +675,16 @@ bool IRGenerator::ir_add(ast_node * node)
 
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
 
-    BinaryInstruction * addInst = new BinaryInstruction(module->getCurrentFunction(),
+    BinaryInstruction * addInst = new (currentFunc->getArena()) BinaryInstruction(currentFunc,
                                                         IRInstOperator::IRINST_OP_ADD_I,
-                                                        left->val,
-                                                        right->val,
+                                                        val(left),
+                                                        val(right),
                                                         IntegerType::getTypeInt());
 
     // 创建临时变量保存IR的值，以及线性IR指令
-    node->blockInsts.addInst(left->blockInsts);
-    node->blockInsts.addInst(right->blockInsts);
-    node->blockInsts.addInst(addInst);
+    emitInst(addInst);
 
-    node->val = addInst;
+    val(node) = addInst;
 
     return true;
 }
@@ -422,8 +694,8 @@ bool IRGenerator::ir_add(ast_node * node)
 /// @return 翻译是否成功，true：成功，false：失败
 bool IRGenerator::ir_sub(ast_node * node)
 {
-    ast_node * src1_node = node->sons[0];
-    ast_node * src2_node = node->sons[1];
+    ast_node * src1_node = node->sons()[0];
+    ast_node * src2_node = node->sons()[1];
 
     // 加法节点，左结合，先计算左节点，后计算右节点
 
@@ -443,18 +715,16 @@ bool IRGenerator::ir_sub(ast_node * node)
 
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
 
-    BinaryInstruction * subInst = new BinaryInstruction(module->getCurrentFunction(),
+    BinaryInstruction * subInst = new (currentFunc->getArena()) BinaryInstruction(currentFunc,
                                                         IRInstOperator::IRINST_OP_SUB_I,
-                                                        left->val,
-                                                        right->val,
+                                                        val(left),
+                                                        val(right),
                                                         IntegerType::getTypeInt());
 
     // 创建临时变量保存IR的值，以及线性IR指令
-    node->blockInsts.addInst(left->blockInsts);
-    node->blockInsts.addInst(right->blockInsts);
-    node->blockInsts.addInst(subInst);
+    emitInst(subInst);
 
-    node->val = subInst;
+    val(node) = subInst;
 
     return true;
 }
@@ -464,8 +734,8 @@ bool IRGenerator::ir_sub(ast_node * node)
 /// @return 翻译是否成功，true：成功，false：失败
 bool IRGenerator::ir_mul(ast_node * node)
 {
-    ast_node * src1_node = node->sons[0];
-    ast_node * src2_node = node->sons[1];
+    ast_node * src1_node = node->sons()[0];
+    ast_node * src2_node = node->sons()[1];
 
     // 乘法节点，左结合，先计算左节点，后计算右节点
 
@@ -485,18 +755,16 @@ bool IRGenerator::ir_mul(ast_node * node)
 
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
 
-    BinaryInstruction * mulInst = new BinaryInstruction(module->getCurrentFunction(),
+    BinaryInstruction * mulInst = new (currentFunc->getArena()) BinaryInstruction(currentFunc,
                                                         IRInstOperator::IRINST_OP_MUL_I,
-                                                        left->val,
-                                                        right->val,
+                                                        val(left),
+                                                        val(right),
                                                         IntegerType::getTypeInt());
 
     // 创建临时变量保存IR的值，以及线性IR指令
-    node->blockInsts.addInst(left->blockInsts);
-    node->blockInsts.addInst(right->blockInsts);
-    node->blockInsts.addInst(mulInst);
+    emitInst(mulInst);
 
-    node->val = mulInst;
+    val(node) = mulInst;
 
     return true;
 }
@@ -506,8 +774,8 @@ bool IRGenerator::ir_mul(ast_node * node)
 /// @return 翻译是否成功，true：成功，false：失败
 bool IRGenerator::ir_div(ast_node * node)
 {
-    ast_node * src1_node = node->sons[0];
-    ast_node * src2_node = node->sons[1];
+    ast_node * src1_node = node->sons()[0];
+    ast_node * src2_node = node->sons()[1];
 
     // 除法节点，左结合，先计算左节点，后计算右节点
 
@@ -527,18 +795,16 @@ bool IRGenerator::ir_div(ast_node * node)
 
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
 
-    BinaryInstruction * divInst = new BinaryInstruction(module->getCurrentFunction(),
+    BinaryInstruction * divInst = new (currentFunc->getArena()) BinaryInstruction(currentFunc,
                                                         IRInstOperator::IRINST_OP_DIV_I,
-                                                        left->val,
-                                                        right->val,
+                                                        val(left),
+                                                        val(right),
                                                         IntegerType::getTypeInt());
 
     // 创建临时变量保存IR的值，以及线性IR指令
-    node->blockInsts.addInst(left->blockInsts);
-    node->blockInsts.addInst(right->blockInsts);
-    node->blockInsts.addInst(divInst);
+    emitInst(divInst);
 
-    node->val = divInst;
+    val(node) = divInst;
 
     return true;
 }
@@ -548,8 +814,8 @@ bool IRGenerator::ir_div(ast_node * node)
 /// @return 翻译是否成功，true：成功，false：失败
 bool IRGenerator::ir_mod(ast_node * node)
 {
-    ast_node * src1_node = node->sons[0];
-    ast_node * src2_node = node->sons[1];
+    ast_node * src1_node = node->sons()[0];
+    ast_node * src2_node = node->sons()[1];
 
     // 取模节点，左结合，先计算左节点，后计算右节点
 
@@ -569,18 +835,16 @@ bool IRGenerator::ir_mod(ast_node * node)
 
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
 
-    BinaryInstruction * modInst = new BinaryInstruction(module->getCurrentFunction(),
+    BinaryInstruction * modInst = new (currentFunc->getArena()) BinaryInstruction(currentFunc,
                                                         IRInstOperator::IRINST_OP_MOD_I,
-                                                        left->val,
-                                                        right->val,
+                                                        val(left),
+                                                        val(right),
                                                         IntegerType::getTypeInt());
 
     // 创建临时变量保存IR的值，以及线性IR指令
-    node->blockInsts.addInst(left->blockInsts);
-    node->blockInsts.addInst(right->blockInsts);
-    node->blockInsts.addInst(modInst);
+    emitInst(modInst);
 
-    node->val = modInst;
+    val(node) = modInst;
 
     return true;
 }
@@ -590,7 +854,7 @@ bool IRGenerator::ir_mod(ast_node * node)
 /// @return 翻译是否成功，true：成功，false：失败
 bool IRGenerator::ir_neg(ast_node * node)
 {
-    ast_node * src_node = node->sons[0];
+    ast_node * src_node = node->sons()[0];
 
     // 取负节点，先计算操作数
 
@@ -607,17 +871,16 @@ bool IRGenerator::ir_neg(ast_node * node)
     ConstInt * zero = module->newConstInt(0);
 
     // 创建减法指令：0 - 操作数
-    BinaryInstruction * negInst = new BinaryInstruction(module->getCurrentFunction(),
+    BinaryInstruction * negInst = new (currentFunc->getArena()) BinaryInstruction(currentFunc,
                                                         IRInstOperator::IRINST_OP_SUB_I,
                                                         zero,
-                                                        operand->val,
+                                                        val(operand),
                                                         IntegerType::getTypeInt());
 
     // 创建临时变量保存IR的值，以及线性IR指令
-    node->blockInsts.addInst(operand->blockInsts);
-    node->blockInsts.addInst(negInst);
+    emitInst(negInst);
 
-    node->val = negInst;
+    val(node) = negInst;
 
     return true;
 }
@@ -627,8 +890,8 @@ bool IRGenerator::ir_neg(ast_node * node)
 /// @return 翻译是否成功，true：成功，false：失败
 bool IRGenerator::ir_assign(ast_node * node)
 {
-    ast_node * son1_node = node->sons[0];
-    ast_node * son2_node = node->sons[1];
+    ast_node * son1_node = node->sons()[0];
+    ast_node * son2_node = node->sons()[1];
 
     // 赋值节点，自右往左运算
 
@@ -649,15 +912,14 @@ bool IRGenerator::ir_assign(ast_node * node)
 
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
 
-    MoveInstruction * movInst = new MoveInstruction(module->getCurrentFunction(), left->val, right->val);
+    MoveInstruction * movInst = new (currentFunc->getArena()) MoveInstruction(currentFunc, val(left), val(right));
 
     // 创建临时变量保存IR的值，以及线性IR指令
-    node->blockInsts.addInst(right->blockInsts);
-    node->blockInsts.addInst(left->blockInsts);
-    node->blockInsts.addInst(movInst);
+    // 左侧是变量，不产生指令，因此右侧表达式的指令已在赋值指令之前
+    emitInst(movInst);
 
     // 这里假定赋值的类型是一致的
-    node->val = movInst;
+    val(node) = movInst;
 
     return true;
 }
@@ -670,9 +932,9 @@ bool IRGenerator::ir_return(ast_node * node)
     ast_node * right = nullptr;
 
     // return语句可能没有没有表达式，也可能有，因此这里必须进行区分判断
-    if (!node->sons.empty()) {
+    if (!node->sons().empty()) {
 
-        ast_node * son_node = node->sons[0];
+        ast_node * son_node = node->sons()[0];
 
         // 返回的表达式的指令保存在right节点中
         right = ir_visit_ast_node(son_node);
@@ -684,25 +946,20 @@ bool IRGenerator::ir_return(ast_node * node)
     }
 
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
-    Function * currentFunc = module->getCurrentFunction();
-
     // 返回值存在时则移动指令到node中
     if (right) {
 
-        // 创建临时变量保存IR的值，以及线性IR指令
-        node->blockInsts.addInst(right->blockInsts);
-
         // 返回值赋值到函数返回值变量上，然后跳转到函数的尾部
-        node->blockInsts.addInst(new MoveInstruction(currentFunc, currentFunc->getReturnValue(), right->val));
+        emitInst(new (currentFunc->getArena()) MoveInstruction(currentFunc, currentFunc->getReturnValue(), val(right)));
 
-        node->val = right->val;
+        val(node) = val(right);
     } else {
         // 没有返回值
-        node->val = nullptr;
+        val(node) = nullptr;
     }
 
     // 跳转到函数的尾部出口指令上
-    node->blockInsts.addInst(new GotoInstruction(currentFunc, currentFunc->getExitLabel()));
+    emitInst(new (currentFunc->getArena()) GotoInstruction(currentFunc, currentFunc->getExitLabel()));
 
     return true;
 }
@@ -722,14 +979,14 @@ bool IRGenerator::ir_leaf_node_type(ast_node * node)
 /// @return 翻译是否成功，true：成功，false：失败
 bool IRGenerator::ir_leaf_node_var_id(ast_node * node)
 {
-    Value * val;
+    Value * varValue;
 
     // 查找ID型Value
     // 变量，则需要在符号表中查找对应的值
 
-    val = module->findVarValue(node->name);
+    varValue = findVarValue(node->getName());
 
-    node->val = val;
+    val(node) = varValue;
 
     return true;
 }
@@ -739,12 +996,12 @@ bool IRGenerator::ir_leaf_node_var_id(ast_node * node)
 /// @return 翻译是否成功，true：成功，false：失败
 bool IRGenerator::ir_leaf_node_uint(ast_node * node)
 {
-    ConstInt * val;
+    ConstInt * constValue;
 
     // 新建一个整数常量Value
-    val = module->newConstInt((int32_t) node->integer_val);
+    constValue = module->newConstInt((int32_t) node->integer_val);
 
-    node->val = val;
+    val(node) = constValue;
 
     return true;
 }
@@ -756,7 +1013,7 @@ bool IRGenerator::ir_declare_statment(ast_node * node)
 {
     bool result = false;
 
-    for (auto & child: node->sons) {
+    for (auto & child: node->sons()) {
 
         // 遍历每个变量声明
         result = ir_variable_declare(child);
@@ -777,7 +1034,7 @@ bool IRGenerator::ir_variable_declare(ast_node * node)
 
     // TODO 这里可强化类型等检查
 
-    node->val = module->newVarValue(node->sons[0]->type, node->sons[1]->name);
+    val(node) = newVarValue(node->sons()[0]->type, node->sons()[1]->getName());
 
     return true;
 }
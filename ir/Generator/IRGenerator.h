@@ -2,8 +2,8 @@
 /// @file IRGenerator.h
 /// @brief AST遍历产生线性IR的头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.5
+/// @date 2026-10-15
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,16 +12,27 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>节点的值与指令块改为按节点编号保存
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>函数体并行翻译
+/// <tr><td>2026-10-15 <td>1.4     <td>zenglj  <td>指令直接追加到当前函数，不再经由节点的指令块
+/// <tr><td>2026-10-15 <td>1.5     <td>zenglj  <td>节点的动作函数表改为按运算符索引的编译期数组
 /// </table>
 ///
 #pragma once
 
-#include <unordered_map>
+#include <cstdint>
+#include <array>
+#include <vector>
 
 #include "AST.h"
+#include "IRCode.h"
 #include "Module.h"
+#include "ScopeStack.h"
+#include "Value.h"
 
-/// @brief AST遍历产生线性IR类
+/// @brief AST遍历产生线性IR类。
+/// 编译单元先串行声明全部函数与全局变量，然后函数体在线程池上并行翻译。
+/// 当前函数与作用域栈属于生成器，每个工作线程一个生成器，符号表中只保存全局的内容。
 class IRGenerator {
 
 public:
@@ -39,6 +50,18 @@ public:
     /// @return true: 成功 false: 失败
     bool run();
 
+    /// @brief 流式编译时翻译编译单元中的一个顶层定义（函数定义或者变量声明语句），结果保存到符号表中
+    /// @param item 顶层定义的AST节点
+    /// @return true: 成功 false: 失败
+    bool runUnitItem(ast_node * item);
+
+    /// @brief 设置函数体并行翻译的线程数
+    /// @param count 线程数，为0时取硬件支持的并发线程数，为1时串行翻译
+    void setThreadCount(unsigned count)
+    {
+        threadCount = count;
+    }
+
 protected:
     /// @brief 编译单元AST节点翻译成线性中间IR
     /// @param node AST节点
@@ -50,6 +73,17 @@ protected:
     /// @return 翻译是否成功，true：成功，false：失败
     bool ir_function_define(ast_node * node);
 
+    /// @brief 函数定义AST节点的声明部分，创建函数并加入符号表
+    /// @param node AST节点
+    /// @return 新建的函数，函数已存在时返回nullptr
+    Function * ir_function_declare(ast_node * node);
+
+    /// @brief 函数定义AST节点的函数体部分翻译成线性中间IR，可在工作线程中执行
+    /// @param node AST节点
+    /// @param func 已声明的函数
+    /// @return 翻译是否成功，true：成功，false：失败
+    bool ir_function_body(ast_node * node, Function * func);
+
     /// @brief 形式参数AST节点翻译成线性中间IR
     /// @param node AST节点
     /// @return 翻译是否成功，true：成功，false：失败
@@ -140,6 +174,65 @@ protected:
     /// @return 翻译是否成功，true：成功，false：失败
     bool ir_default(ast_node * node);
 
+    /// @brief 从指定节点开始遍历产生线性IR，节点的翻译结果只在遍历期间保存
+    /// @param node AST节点
+    /// @return true: 成功 false: 失败
+    bool translate(ast_node * node);
+
+    /// @brief 函数体并行翻译的任务
+    struct FunctionJob {
+        /// @brief 函数定义节点
+        ast_node * node;
+
+        /// @brief 串行阶段已声明的函数
+        Function * func;
+
+        /// @brief 函数体中可见的函数个数，即定义在其前面的函数（含自身）
+        uint32_t visibleFunctions;
+
+        /// @brief 函数体中可见的全局变量个数，即声明在其前面的全局变量
+        uint32_t visibleGlobals;
+    };
+
+    /// @brief 串行阶段：按次序声明编译单元中的函数，翻译全局变量，函数体留作任务
+    /// @param node 编译单元节点
+    /// @param jobs 函数体翻译任务
+    /// @return true: 成功 false: 失败
+    bool declareCompileUnit(ast_node * node, std::vector<FunctionJob> & jobs);
+
+    /// @brief 并行阶段：在线程池上翻译全部函数体，每个工作线程有自己的生成器
+    /// @param jobs 函数体翻译任务
+    /// @return true: 成功 false: 失败
+    bool translateFunctions(std::vector<FunctionJob> & jobs);
+
+    /// @brief 翻译一个函数体
+    /// @param job 函数体翻译任务
+    /// @return true: 成功 false: 失败
+    bool translateFunction(const FunctionJob & job);
+
+    /// @brief 为子树准备节点翻译结果表，按子树中节点编号的范围分配
+    /// @param node 子树的根
+    void prepareNodeTables(ast_node * node);
+
+    /// @brief 释放节点翻译结果表
+    void releaseNodeTables();
+
+    /// @brief 新建变量，函数内为局部变量，否则为全局变量
+    /// @param type 变量类型
+    /// @param name 变量名，局部变量可为空
+    /// @return 变量，同一作用域内重名时返回nullptr
+    Value * newVarValue(Type * type, SymbolId name = EmptySymbol);
+
+    /// @brief 从内到外逐层作用域查找变量，最后查找可见的全局变量
+    /// @param name 变量名
+    /// @return 变量，未找到返回nullptr
+    Value * findVarValue(SymbolId name);
+
+    /// @brief 查找可见的函数
+    /// @param name 函数名
+    /// @return 函数，未找到返回nullptr
+    Function * findFunction(SymbolId name);
+
     /// @brief 根据AST的节点运算符查找对应的翻译函数并执行翻译动作
     /// @param node AST节点
     /// @return 成功返回node节点，否则返回nullptr
@@ -148,8 +241,24 @@ protected:
     /// @brief AST的节点操作函数
     typedef bool (IRGenerator::*ast2ir_handler_t)(ast_node *);
 
-    /// @brief AST节点运算符与动作函数关联的映射表
-    std::unordered_map<ast_operator_type, ast2ir_handler_t> ast2ir_handlers;
+    /// @brief AST节点运算符与动作函数关联的表，按运算符直接索引，编译期生成，没有动作函数的为nullptr
+    static const std::array<ast2ir_handler_t, (size_t) ast_operator_type::AST_OP_MAX> ast2ir_handlers;
+
+    /// @brief 指令追加到当前函数的指令序列尾部。
+    /// 子节点总是先于父节点翻译，按翻译的先后追加即是求值的先后，不必在节点间传递指令块
+    /// @param inst IR指令
+    void emitInst(Instruction * inst)
+    {
+        currentFunc->getInterCode().addInst(inst);
+    }
+
+    /// @brief 获取节点翻译后的值
+    /// @param node AST节点
+    /// @return 值的引用，可赋值
+    Value *& val(ast_node * node)
+    {
+        return nodeValues[node->id - nodeIdBase];
+    }
 
 private:
     /// @brief 抽象语法树的根
@@ -157,4 +266,25 @@ private:
 
     /// @brief 符号表:模块
     Module * module;
+
+    /// @brief 当前正在翻译的函数，函数外为nullptr
+    Function * currentFunc = nullptr;
+
+    /// @brief 函数内的作用域栈，全局作用域在符号表中
+    ScopeStack scopeStack;
+
+    /// @brief 函数体中可见的函数个数，串行翻译时全部可见
+    uint32_t visibleFunctions = UINT32_MAX;
+
+    /// @brief 函数体中可见的全局变量个数，串行翻译时全部可见
+    uint32_t visibleGlobals = UINT32_MAX;
+
+    /// @brief 函数体并行翻译的线程数
+    unsigned threadCount = 1;
+
+    /// @brief 节点翻译结果表中第一项对应的节点编号
+    uint32_t nodeIdBase = 0;
+
+    /// @brief 节点翻译后的值，按节点编号索引
+    std::vector<Value *> nodeValues;
 };
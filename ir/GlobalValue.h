@@ -58,15 +58,27 @@ class GlobalValue : public Constant {
     };
 
 public:
+    ///
+    /// @brief 是否是全局值（全局变量或函数），供isa/cast/dyn_cast使用
+    /// @param value 值
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * value)
+    {
+        return (value->getValueKind() >= ValueKind::VK_GLOBAL_VARIABLE) &&
+               (value->getValueKind() <= ValueKind::VK_FUNCTION);
+    }
+
     ///
     /// @brief 构造函数
+    /// @param _kind  具体的种类
     /// @param _type  类型
     /// @param _name  全局符号名
     ///
-    GlobalValue(Type * _type, std::string _name) : Constant(_type)
+    GlobalValue(ValueKind _kind, Type * _type, std::string _name) : Constant(_kind, _type)
     {
-        this->name = _name;
-        this->IRName = IR_GLOBAL_VARNAME_PREFIX + this->name;
+        setName(_name);
+        this->IRName = IR_GLOBAL_VARNAME_PREFIX + _name;
     }
 
     /// @brief 获取名字
@@ -132,6 +144,24 @@ public:
         this->alignment = _alignment;
     }
 
+    ///
+    /// @brief 获取在模块中的声明次序，函数与全局变量分别编号
+    /// @return uint32_t 声明次序
+    ///
+    [[nodiscard]] uint32_t getDeclareOrder() const
+    {
+        return declareOrder;
+    }
+
+    ///
+    /// @brief 设置在模块中的声明次序
+    /// @param order 声明次序
+    ///
+    void setDeclareOrder(uint32_t order)
+    {
+        this->declareOrder = order;
+    }
+
 protected:
     ///
     /// @brief The linkage of this global
@@ -147,4 +177,9 @@ protected:
     /// @brief 默认对齐大小为4字节
     ///
     int32_t alignment = 4;
+
+    ///
+    /// @brief 在模块中的声明次序，函数体并行翻译时用于检查先声明后使用
+    ///
+    uint32_t declareOrder = 0;
 };
\ No newline at end of file
@@ -2,8 +2,8 @@
 /// @file IRCode.cpp
 /// @brief IR指令序列类实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.1
+/// @date 2026-10-15
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>指令序列改为侵入式双向链表，支持O(1)插入、删除与拼接
 /// </table>
 ///
 #include "IRCode.h"
@@ -21,45 +22,161 @@ InterCode::~InterCode()
     Delete();
 }
 
+/// @brief 移动构造，指令转给新对象，原对象变为空
+/// @param other 原指令序列
+InterCode::InterCode(InterCode && other) noexcept : head(other.head), tail(other.tail), count(other.count)
+{
+    other.head = other.tail = nullptr;
+    other.count = 0;
+}
+
+/// @brief 移动赋值，先删除自身的指令，再接管other的指令
+/// @param other 原指令序列
+/// @return 自身
+InterCode & InterCode::operator=(InterCode && other) noexcept
+{
+    if (this != &other) {
+        Delete();
+        splice(nullptr, other);
+    }
+
+    return *this;
+}
+
 /// @brief 添加一个指令块，添加到尾部，并清除原来指令块的内容
 /// @param block 指令块，请注意加入后会自动清空block的指令
 void InterCode::addInst(InterCode & block)
 {
-    std::vector<Instruction *> & insert = block.getInsts();
-
-    code.insert(code.end(), insert.begin(), insert.end());
-
-    // InterCode析构会清理资源，因此移动指令到code中后必须清理，否则会释放多次导致程序例外
-    // 当然，这里也可不清理，但InterCode的析构函数不能清理，需专门的函数清理即可。
-    insert.clear();
+    splice(nullptr, block);
 }
 
 /// @brief 添加一条中间指令
 /// @param inst IR指令
 void InterCode::addInst(Instruction * inst)
 {
-    code.push_back(inst);
+    insertBefore(nullptr, inst);
 }
 
-/// @brief 获取指令序列
-/// @return 指令序列
-std::vector<Instruction *> & InterCode::getInsts()
+/// @brief 在指定指令之前插入一条指令
+/// @param pos 位置，nullptr表示插入到尾部
+/// @param inst 要插入的指令，不能已在某个序列中
+void InterCode::insertBefore(Instruction * pos, Instruction * inst)
 {
-    return code;
+    Instruction * prev = pos ? pos->prevInst : tail;
+
+    inst->prevInst = prev;
+    inst->nextInst = pos;
+
+    if (prev) {
+        prev->nextInst = inst;
+    } else {
+        head = inst;
+    }
+
+    if (pos) {
+        pos->prevInst = inst;
+    } else {
+        tail = inst;
+    }
+
+    count++;
+}
+
+/// @brief 在指定指令之后插入一条指令
+/// @param pos 位置，nullptr表示插入到头部
+/// @param inst 要插入的指令，不能已在某个序列中
+void InterCode::insertAfter(Instruction * pos, Instruction * inst)
+{
+    insertBefore(pos ? pos->nextInst : head, inst);
+}
+
+/// @brief 把指令块整体插入到指定指令之前，并清空原来指令块
+/// @param pos 位置，nullptr表示插入到尾部
+/// @param block 指令块
+void InterCode::splice(Instruction * pos, InterCode & block)
+{
+    if (block.empty() || &block == this) {
+        return;
+    }
+
+    Instruction * prev = pos ? pos->prevInst : tail;
+
+    // 只需改动两处衔接的指针，与指令块的长度无关
+    block.head->prevInst = prev;
+    block.tail->nextInst = pos;
+
+    if (prev) {
+        prev->nextInst = block.head;
+    } else {
+        head = block.head;
+    }
+
+    if (pos) {
+        pos->prevInst = block.tail;
+    } else {
+        tail = block.tail;
+    }
+
+    count += block.count;
+
+    // 指令已归本序列所有，原指令块必须清空，否则会释放多次导致程序例外
+    block.head = block.tail = nullptr;
+    block.count = 0;
+}
+
+/// @brief 把指令从序列中摘下，不释放指令
+/// @param inst 序列中的指令
+/// @return 原来的下一条指令，没有时为nullptr
+Instruction * InterCode::remove(Instruction * inst)
+{
+    Instruction * next = inst->nextInst;
+
+    if (inst->prevInst) {
+        inst->prevInst->nextInst = next;
+    } else {
+        head = next;
+    }
+
+    if (next) {
+        next->prevInst = inst->prevInst;
+    } else {
+        tail = inst->prevInst;
+    }
+
+    inst->prevInst = inst->nextInst = nullptr;
+    count--;
+
+    return next;
+}
+
+/// @brief 把指令从序列中摘下并释放，指令的值不能再有使用者
+/// @param inst 序列中的指令
+/// @return 原来的下一条指令，没有时为nullptr
+Instruction * InterCode::erase(Instruction * inst)
+{
+    Instruction * next = remove(inst);
+
+    delete inst;
+
+    return next;
 }
 
 /// @brief 删除所有指令
 void InterCode::Delete()
 {
     // 不能直接删除指令，需要先清除操作数
-    for (auto inst: code) {
+    for (Instruction * inst = head; inst; inst = inst->nextInst) {
         inst->clearOperands();
     }
 
     // 资源清理
-    for (auto inst: code) {
+    Instruction * inst = head;
+    while (inst) {
+        Instruction * next = inst->nextInst;
         delete inst;
+        inst = next;
     }
 
-    code.clear();
+    head = tail = nullptr;
+    count = 0;
 }
@@ -2,8 +2,8 @@
 /// @file IRCode.cpp
 /// @brief IR指令序列类头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.1
+/// @date 2026-10-15
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,29 +11,112 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>指令序列改为侵入式双向链表，支持O(1)插入、删除与拼接
 /// </table>
 ///
 
 #pragma once
 
-#include <vector>
+#include <cstddef>
+#include <iterator>
 
 #include "Instruction.h"
 
-/// @brief 中间IR指令序列管理类
+///
+/// @brief 中间IR指令序列管理类。指令通过自身的前后指针串成侵入式双向链表，
+/// 在任意位置插入、删除指令以及整段拼接都是O(1)，增删指令不会使其它指令的迭代器失效
+///
 class InterCode {
 
-protected:
-    /// @brief 指令块的指令序列
-    std::vector<Instruction *> code;
-
 public:
+    ///
+    /// @brief 指令序列的双向迭代器，解引用得到指令指针
+    ///
+    class iterator {
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Instruction *;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Instruction * const *;
+        using reference = Instruction *;
+
+        iterator() = default;
+
+        /// @brief 构造函数
+        /// @param _inst 指向的指令，nullptr表示尾后
+        /// @param _code 所属的指令序列，尾后迭代器回退时使用
+        iterator(Instruction * _inst, const InterCode * _code) : inst(_inst), code(_code)
+        {}
+
+        Instruction * operator*() const
+        {
+            return inst;
+        }
+
+        iterator & operator++()
+        {
+            inst = inst->getNextInst();
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        iterator & operator--()
+        {
+            inst = inst ? inst->getPrevInst() : code->tail;
+            return *this;
+        }
+
+        iterator operator--(int)
+        {
+            iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const iterator & other) const
+        {
+            return inst == other.inst;
+        }
+
+        bool operator!=(const iterator & other) const
+        {
+            return inst != other.inst;
+        }
+
+    private:
+        /// @brief 指向的指令，nullptr表示尾后
+        Instruction * inst = nullptr;
+
+        /// @brief 所属的指令序列
+        const InterCode * code = nullptr;
+    };
+
     /// @brief 构造函数
     InterCode() = default;
 
     /// @brief 析构函数
     ~InterCode();
 
+    /// @brief 移动构造，指令转给新对象，原对象变为空
+    /// @param other 原指令序列
+    InterCode(InterCode && other) noexcept;
+
+    /// @brief 移动赋值，先删除自身的指令，再接管other的指令
+    /// @param other 原指令序列
+    /// @return 自身
+    InterCode & operator=(InterCode && other) noexcept;
+
+    /// 指令只能属于一个序列，禁止拷贝
+    InterCode(const InterCode &) = delete;
+    InterCode & operator=(const InterCode &) = delete;
+
     /// @brief 添加一个指令块，添加到尾部，并清除原来指令块的内容
     /// @param block 指令块，请注意加入后会自动清空block的指令
     void addInst(InterCode & block);
@@ -42,10 +125,77 @@ public:
     /// @param inst IR指令
     void addInst(Instruction * inst);
 
-    /// @brief 获取指令序列
-    /// @return 指令序列
-    std::vector<Instruction *> & getInsts();
+    /// @brief 在指定指令之前插入一条指令
+    /// @param pos 位置，nullptr表示插入到尾部
+    /// @param inst 要插入的指令，不能已在某个序列中
+    void insertBefore(Instruction * pos, Instruction * inst);
+
+    /// @brief 在指定指令之后插入一条指令
+    /// @param pos 位置，nullptr表示插入到头部
+    /// @param inst 要插入的指令，不能已在某个序列中
+    void insertAfter(Instruction * pos, Instruction * inst);
+
+    /// @brief 把指令块整体插入到指定指令之前，并清空原来指令块
+    /// @param pos 位置，nullptr表示插入到尾部
+    /// @param block 指令块
+    void splice(Instruction * pos, InterCode & block);
+
+    /// @brief 把指令从序列中摘下，不释放指令
+    /// @param inst 序列中的指令
+    /// @return 原来的下一条指令，没有时为nullptr
+    Instruction * remove(Instruction * inst);
+
+    /// @brief 把指令从序列中摘下并释放，指令的值不能再有使用者
+    /// @param inst 序列中的指令
+    /// @return 原来的下一条指令，没有时为nullptr
+    Instruction * erase(Instruction * inst);
+
+    /// @brief 第一条指令的迭代器
+    iterator begin() const
+    {
+        return iterator(head, this);
+    }
+
+    /// @brief 尾后迭代器
+    iterator end() const
+    {
+        return iterator(nullptr, this);
+    }
+
+    /// @brief 第一条指令，为空时返回nullptr
+    Instruction * front() const
+    {
+        return head;
+    }
+
+    /// @brief 最后一条指令，为空时返回nullptr
+    Instruction * back() const
+    {
+        return tail;
+    }
+
+    /// @brief 是否没有指令
+    bool empty() const
+    {
+        return head == nullptr;
+    }
+
+    /// @brief 指令条数
+    size_t size() const
+    {
+        return count;
+    }
 
     /// @brief 删除所有指令
     void Delete();
+
+protected:
+    /// @brief 第一条指令
+    Instruction * head = nullptr;
+
+    /// @brief 最后一条指令
+    Instruction * tail = nullptr;
+
+    /// @brief 指令条数
+    size_t count = 0;
 };
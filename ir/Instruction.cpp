@@ -23,16 +23,9 @@
 /// @param result
 /// @param srcVal1
 /// @param srcVal2
-Instruction::Instruction(Function * _func, IRInstOperator _op, Type * _type) : User(_type), op(_op), func(_func)
+Instruction::Instruction(Function * _func, IRInstOperator _op, Type * _type) : User(ValueKind::VK_INSTRUCTION, _type), op(_op), func(_func)
 {}
 
-/// @brief 获取指令操作码
-/// @return 指令操作码
-IRInstOperator Instruction::getOp()
-{
-    return op;
-}
-
 /// @brief 转换成字符串
 /// @param str 转换后的字符串
 void Instruction::toString(std::string & str)
@@ -2,8 +2,8 @@
 /// @file Instruction.h
 /// @brief IR指令头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.4
+/// @date 2026-10-15
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,10 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>增加指令序列的前后指针
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>增加classof，操作码的获取改为内联
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>增加指令所在的基本块
+/// <tr><td>2026-10-15 <td>1.4     <td>zenglj  <td>增加phi指令
 /// </table>
 ///
 #pragma once
@@ -18,6 +22,7 @@
 #include "User.h"
 
 class Function;
+class BasicBlock;
 
 /// @brief IR指令操作码
 enum class IRInstOperator : std::int8_t {
@@ -58,6 +63,9 @@ enum class IRInstOperator : std::int8_t {
     /// @brief 实参ARG指令，单目运算
     IRINST_OP_ARG,
 
+    /// @brief SSA的phi指令，按前驱基本块选择值，进入后端前消除
+    IRINST_OP_PHI,
+
     /* 后续可追加其他的IR指令 */
 
     /// @brief 最大指令码，也是无效指令
@@ -69,6 +77,15 @@ enum class IRInstOperator : std::int8_t {
 ///
 class Instruction : public User {
 
+    /// 指令序列维护前后指针
+    friend class InterCode;
+
+    /// 控制流图划分基本块时设置指令所在的块
+    friend class ControlFlowGraph;
+
+    /// 基本块内插入指令时设置指令所在的块
+    friend class BasicBlock;
+
 public:
     /// @brief 构造函数
     /// @param op
@@ -78,9 +95,22 @@ public:
     /// @brief 析构函数
     virtual ~Instruction() = default;
 
+    ///
+    /// @brief 是否是指令，供isa/cast/dyn_cast使用
+    /// @param value 值
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * value)
+    {
+        return value->getValueKind() == ValueKind::VK_INSTRUCTION;
+    }
+
     /// @brief 获取指令操作码
     /// @return 指令操作码
-    IRInstOperator getOp();
+    IRInstOperator getOp() const
+    {
+        return op;
+    }
 
     ///
     /// @brief 转换成IR指令文本形式
@@ -101,6 +131,33 @@ public:
     ///
     Function * getFunction();
 
+    ///
+    /// @brief 获取指令序列中的前一条指令
+    /// @return Instruction* 前一条指令，是第一条或不在序列中时为nullptr
+    ///
+    Instruction * getPrevInst() const
+    {
+        return prevInst;
+    }
+
+    ///
+    /// @brief 获取指令序列中的后一条指令
+    /// @return Instruction* 后一条指令，是最后一条或不在序列中时为nullptr
+    ///
+    Instruction * getNextInst() const
+    {
+        return nextInst;
+    }
+
+    ///
+    /// @brief 获取指令所在的基本块
+    /// @return BasicBlock* 基本块，没有划分基本块时为nullptr
+    ///
+    BasicBlock * getBasicBlock() const
+    {
+        return block;
+    }
+
     ///
     /// @brief 检查指令是否有值
     /// @return true
@@ -191,6 +248,11 @@ protected:
     ///
     Function * func = nullptr;
 
+    ///
+    /// @brief 指令所在的基本块，由控制流图划分基本块时设置
+    ///
+    BasicBlock * block = nullptr;
+
     ///
     /// @brief 寄存器编号，-1表示没有分配寄存器，大于等于0代表是寄存器型Value
     ///
@@ -215,4 +277,14 @@ protected:
     /// @brief 变量加载到寄存器中时对应的寄存器编号
     ///
     int32_t loadRegNo = -1;
+
+    ///
+    /// @brief 指令序列中的前一条指令
+    ///
+    Instruction * prevInst = nullptr;
+
+    ///
+    /// @brief 指令序列中的后一条指令
+    ///
+    Instruction * nextInst = nullptr;
 };
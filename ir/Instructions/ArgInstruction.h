@@ -24,6 +24,17 @@
 class ArgInstruction : public Instruction {
 
 public:
+    ///
+    /// @brief 是否是实参指令，供isa/cast/dyn_cast使用
+    /// @param value 值
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * value)
+    {
+        return Instruction::classof(value) &&
+               (static_cast<const Instruction *>(value)->getOp() == IRInstOperator::IRINST_OP_ARG);
+    }
+
     /// @brief 函数实参指令
     /// @param src 实参结果变量
     ArgInstruction(Function * _func, Value * src);
@@ -24,6 +24,18 @@
 class BinaryInstruction : public Instruction {
 
 public:
+    ///
+    /// @brief 是否是二元运算指令，供isa/cast/dyn_cast使用
+    /// @param value 值
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * value)
+    {
+        return Instruction::classof(value) &&
+               (static_cast<const Instruction *>(value)->getOp() >= IRInstOperator::IRINST_OP_ADD_I) &&
+               (static_cast<const Instruction *>(value)->getOp() <= IRInstOperator::IRINST_OP_MOD_I);
+    }
+
     /// @brief 构造函数
     /// @param _op 操作符
     /// @param _result 结果操作数
@@ -27,9 +27,10 @@ FuncCallInstruction::FuncCallInstruction(Function * _func,
                                          Type * _type)
     : Instruction(_func, IRInstOperator::IRINST_OP_FUNC_CALL, _type), calledFunction(calledFunc)
 {
-    name = calledFunc->getName();
+    name = calledFunc->getNameId();
 
-    // 实参拷贝
+    // 实参拷贝，操作数数组一次分配好
+    reserveOperands((int32_t) _srcVal.size());
     for (auto & val: _srcVal) {
         addOperand(val);
     }
@@ -3,7 +3,7 @@
 /// @brief 函数调用指令
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.1
 /// @date 2024-09-29
 ///
 /// @copyright Copyright (c) 2024
@@ -12,6 +12,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>增加获取被调用函数的接口
 /// </table>
 ///
 #pragma once
@@ -29,6 +30,17 @@ class Function;
 class FuncCallInstruction : public Instruction {
 
 public:
+    ///
+    /// @brief 是否是函数调用指令，供isa/cast/dyn_cast使用
+    /// @param value 值
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * value)
+    {
+        return Instruction::classof(value) &&
+               (static_cast<const Instruction *>(value)->getOp() == IRInstOperator::IRINST_OP_FUNC_CALL);
+    }
+
     ///
     /// @brief 函数调用时的被调用函数
     ///
@@ -51,4 +63,13 @@ public:
     /// @return std::string 被调用函数名字
     ///
     [[nodiscard]] std::string getCalledName() const;
+
+    ///
+    /// @brief 获取被调用函数
+    /// @return Function* 被调用函数
+    ///
+    [[nodiscard]] Function * getCalledFunction() const
+    {
+        return calledFunction;
+    }
 };
@@ -28,6 +28,17 @@
 class GotoInstruction final : public Instruction {
 
 public:
+    ///
+    /// @brief 是否是无条件跳转指令，供isa/cast/dyn_cast使用
+    /// @param value 值
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * value)
+    {
+        return Instruction::classof(value) &&
+               (static_cast<const Instruction *>(value)->getOp() == IRInstOperator::IRINST_OP_GOTO);
+    }
+
     ///
     /// @brief 无条件跳转指令的构造函数
     /// @param target 跳转目标
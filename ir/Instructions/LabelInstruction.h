@@ -28,6 +28,17 @@ class Function;
 class LabelInstruction : public Instruction {
 
 public:
+    ///
+    /// @brief 是否是Label指令，供isa/cast/dyn_cast使用
+    /// @param value 值
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * value)
+    {
+        return Instruction::classof(value) &&
+               (static_cast<const Instruction *>(value)->getOp() == IRInstOperator::IRINST_OP_LABEL);
+    }
+
     ///
     /// @brief 构造函数
     /// @param _func 所属函数
@@ -29,6 +29,17 @@ class Function;
 class MoveInstruction : public Instruction {
 
 public:
+    ///
+    /// @brief 是否是赋值指令，供isa/cast/dyn_cast使用
+    /// @param value 值
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * value)
+    {
+        return Instruction::classof(value) &&
+               (static_cast<const Instruction *>(value)->getOp() == IRInstOperator::IRINST_OP_ASSIGN);
+    }
+
     ///
     /// @brief 构造函数
     /// @param _func 所属的函数
@@ -0,0 +1,57 @@
+///
+/// @file PhiInstruction.cpp
+/// @brief SSA形式的phi指令
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include "BasicBlock.h"
+#include "Casting.h"
+#include "LabelInstruction.h"
+
+#include "PhiInstruction.h"
+
+///
+/// @brief 构造函数
+/// @param _func 所属函数
+/// @param _type 值的类型
+///
+PhiInstruction::PhiInstruction(Function * _func, Type * _type)
+    : Instruction(_func, IRInstOperator::IRINST_OP_PHI, _type)
+{}
+
+///
+/// @brief 增加一个来源
+/// @param val 从来源块到达时的值
+/// @param block 来源块
+///
+void PhiInstruction::addIncoming(Value * val, BasicBlock * block)
+{
+    addOperand(val);
+    incomingLeaders.push_back(block->getFirstInst());
+}
+
+/// @brief 转换成IR指令文本，来源块用其Label表示，入口块没有Label用entry表示
+/// @param str 转换后的字符串
+void PhiInstruction::toString(std::string & str)
+{
+    str = getIRName() + " = phi " + getType()->toString();
+
+    int32_t incomingNum = getIncomingNum();
+    for (int32_t k = 0; k < incomingNum; ++k) {
+
+        auto * label = dyn_cast<LabelInstruction>(incomingLeaders[k]);
+
+        str += (k == 0) ? " [" : ", [";
+        str += getIncomingValue(k)->getIRName() + ", " + (label ? label->getIRName() : std::string("entry")) + "]";
+    }
+}
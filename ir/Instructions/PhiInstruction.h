@@ -0,0 +1,99 @@
+///
+/// @file PhiInstruction.h
+/// @brief SSA形式的phi指令
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Instruction.h"
+
+class BasicBlock;
+
+///
+/// @brief phi指令，位于基本块开头，按控制流从哪个前驱块到达选择对应的值。
+/// 第k个操作数是从第k个来源块到达时的值。来源块记录为其首条指令（Label或Entry指令），
+/// 控制流图重建后仍然有效
+///
+class PhiInstruction final : public Instruction {
+
+public:
+    ///
+    /// @brief 是否是phi指令，供isa/cast/dyn_cast使用
+    /// @param value 值
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * value)
+    {
+        return Instruction::classof(value) &&
+               (static_cast<const Instruction *>(value)->getOp() == IRInstOperator::IRINST_OP_PHI);
+    }
+
+    ///
+    /// @brief 构造函数
+    /// @param _func 所属函数
+    /// @param _type 值的类型
+    ///
+    PhiInstruction(Function * _func, Type * _type);
+
+    ///
+    /// @brief 增加一个来源
+    /// @param val 从来源块到达时的值
+    /// @param block 来源块，即所在块的前驱
+    ///
+    void addIncoming(Value * val, BasicBlock * block);
+
+    ///
+    /// @brief 获取来源的个数
+    /// @return int32_t 个数
+    ///
+    int32_t getIncomingNum()
+    {
+        return getOperandsNum();
+    }
+
+    ///
+    /// @brief 获取第k个来源的值
+    /// @param k 下标
+    /// @return Value* 值
+    ///
+    Value * getIncomingValue(int32_t k)
+    {
+        return getOperand(k);
+    }
+
+    ///
+    /// @brief 获取第k个来源块
+    /// @param k 下标
+    /// @return BasicBlock* 来源块
+    ///
+    BasicBlock * getIncomingBlock(int32_t k)
+    {
+        return incomingLeaders[k]->getBasicBlock();
+    }
+
+    ///
+    /// @brief 转换成字符串
+    /// @param str 返回指令字符串
+    ///
+    void toString(std::string & str) override;
+
+private:
+    ///
+    /// @brief 各来源块的首条指令，与操作数一一对应
+    ///
+    std::vector<Instruction *> incomingLeaders;
+};
@@ -17,22 +17,15 @@
 
 #include "IntegerType.h"
 
-///
-/// @brief 唯一的VOID类型实例
-///
-IntegerType * IntegerType::oneInstanceBool;
-IntegerType * IntegerType::oneInstanceInt;
-
 ///
 /// @brief 获取类型bool
 /// @return VoidType*
 ///
 IntegerType * IntegerType::getTypeBool()
 {
-    // 只维持一份
-    if (!oneInstanceBool) {
-        oneInstanceBool = new IntegerType(1);
-    }
+    // 只维持一份，局部静态变量的初始化是线程安全的，多个线程同时编译时也只创建一次
+    static IntegerType * oneInstanceBool = new IntegerType(1);
+
     return oneInstanceBool;
 }
 
@@ -42,10 +35,8 @@ IntegerType * IntegerType::getTypeBool()
 ///
 IntegerType * IntegerType::getTypeInt()
 {
-    // 只维持一份
-    if (!oneInstanceInt) {
-        oneInstanceInt = new IntegerType(32);
-    }
+    // 只维持一份，局部静态变量的初始化是线程安全的，多个线程同时编译时也只创建一次
+    static IntegerType * oneInstanceInt = new IntegerType(32);
 
     return oneInstanceInt;
 }
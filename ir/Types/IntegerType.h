@@ -90,16 +90,6 @@ private:
     explicit IntegerType(int32_t _bitWidth) : Type(Type::IntegerTyID), bitWidth(_bitWidth)
     {}
 
-    ///
-    /// @brief 唯一的VOID类型实例
-    ///
-    static IntegerType * oneInstanceBool;
-
-    ///
-    /// @brief 唯一的VOID类型实例
-    ///
-    static IntegerType * oneInstanceInt;
-
     ///
     /// @brief 位宽
     ///
@@ -15,6 +15,8 @@
 ///
 #pragma once
 
+#include <mutex>
+
 #include "Type.h"
 #include "StorageSet.h"
 
@@ -69,7 +71,8 @@ public:
 
         if (pointeeType->isPointerType()) {
 
-            Instanceof(pType, const PointerType *, pointeeType);
+            // 已按类型ID判断是指针类型，不需要dynamic_cast
+            auto pType = static_cast<const PointerType *>(pointeeType);
             this->rootType = pType->getRootType();
             this->depth = pType->getDepth() + 1;
         } else {
@@ -112,7 +115,11 @@ public:
     ///
     static const PointerType * get(Type * pointee)
     {
+        // 指针类型全局唯一，多个线程同时编译时查找或插入需互斥
+        static std::mutex storageMutex;
         static StorageSet<PointerType, PointerTypeHasher, PointerTypeEqual> storageSet;
+
+        std::lock_guard<std::mutex> lock(storageMutex);
         return storageSet.get(pointee);
     }
 
@@ -3,7 +3,7 @@
 /// @brief Use类定义了一条Define-Use边，usee为定义的Value，user代表使用该Value的User
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.1
 /// @date 2024-09-29
 ///
 /// @copyright Copyright (c) 2024
@@ -12,6 +12,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>Use内嵌在User的操作数数组中，并链入usee的侵入式双向链表
 /// </table>
 ///
 
@@ -24,17 +25,21 @@
 ///
 void Use::setUsee(Value * newVal)
 {
-    this->usee->removeUse(this);
-    this->usee = newVal;
-    this->usee->addUse(this);
+    if (usee) {
+        usee->removeUse(this);
+    }
+
+    usee = newVal;
+
+    if (usee) {
+        usee->addUse(this);
+    }
 }
 
 ///
-/// @brief 移除def-use边，需要两头分别清理
-/// ! 请注意该函数并没有删除Use，需要自行清理资源
+/// @brief 移除def-use边，需要两头分别清理。Use存放在User的操作数数组中，随之被后面的操作数覆盖
 ///
 void Use::remove()
 {
-    usee->removeUse(this);
     user->removeOperandRaw(this);
-}
\ No newline at end of file
+}
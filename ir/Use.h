@@ -3,7 +3,7 @@
 /// @brief Use类定义了一条Define-Use边，usee为定义的Value，user代表使用该Value的User
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.1
 /// @date 2024-09-29
 ///
 /// @copyright Copyright (c) 2024
@@ -12,12 +12,12 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>Use内嵌在User的操作数数组中，并链入usee的侵入式双向链表
 /// </table>
 ///
 #pragma once
 
 #include <cstdint>
-#include <vector>
 
 class User;
 class Value;
@@ -29,11 +29,15 @@ class Value;
 /// Use可以跟踪每个Value的所有使用情况，并且当Value被修改或删除时，可以更新所有引用它的地方
 ///
 /// User和Use之间存在一个双向关系：
-/// User持有一个Use链表(成员uses)，每个Use指向一个Value
-/// Value持有一个User链表(成员uses)，每个User指向一个使用该Value的User对象
+/// User持有一个Use数组(成员operands)，Use对象直接存放在其中，每个Use指向一个Value
+/// Value持有一个Use的侵入式双向链表(成员useList)，链表的节点就是User中的Use，不再另外分配内存，
+/// 加入与移出链表都是O(1)
 ///
 class Use {
 
+    friend class Value;
+    friend class User;
+
 protected:
     ///
     /// @brief 指向要使用的value
@@ -45,17 +49,25 @@ protected:
     ///
     User * user = nullptr;
 
+    ///
+    /// @brief usee的use链中的下一个Use
+    ///
+    Use * next = nullptr;
+
+    ///
+    /// @brief usee的use链中指向本Use的指针的地址，即前一个Use的next或者链表头，移出链表时不需要查找
+    ///
+    Use ** prev = nullptr;
+
 public:
-    /**
-     * 构建函数，构建一条define-use的边
-     * <br>
-     * The constructor DOES NOT automatically insert the Use link constructed to neither usee's [uses]
-     * field nor the user's [operands] field, which are left for the caller to manually handle.
-     * @param value The value being used.
-     * @param user  The user value.
-     */
-    Use(Value * _value, User * _user) : usee(_value), user(_user)
-    {}
+    ///
+    /// @brief 构造函数，构建一条空的边，由User在加入操作数时设置
+    ///
+    Use() = default;
+
+    // Use的地址在usee的链表中，不能拷贝
+    Use(const Use &) = delete;
+    Use & operator=(const Use &) = delete;
 
     ///
     /// @brief 获取值
@@ -84,6 +96,15 @@ public:
         return usee;
     }
 
+    ///
+    /// @brief 获取usee的use链中的下一个Use
+    /// @return Use* 下一个Use，没有时为空
+    ///
+    [[nodiscard]] Use * getNext() const
+    {
+        return next;
+    }
+
     ///
     /// @brief 不再使用Use原来的Value，更新为新的Value
     /// @param newVal 新的Value
@@ -91,7 +112,7 @@ public:
     void setUsee(Value * newVal);
 
     ///
-    /// @brief def-use边取消，但不会删除该Use
+    /// @brief def-use边取消，同时从User的操作数中移除
     ///
     void remove();
-};
\ No newline at end of file
+};
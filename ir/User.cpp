@@ -3,7 +3,7 @@
 /// @brief 使用Value的User，该User也是Value。函数、指令都是User
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.1
 /// @date 2024-09-29
 ///
 /// @copyright Copyright (c) 2024
@@ -12,20 +12,52 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>Use直接存放在操作数数组中，不再单独分配
 /// </table>
 ///
 
-#include <algorithm>
-
 #include "User.h"
 
+///
+/// @brief 把Use移动到操作数数组的另一个位置，usee链表中的节点随之替换
+/// @param from 原来的位置
+/// @param to 新的位置，必须是空的Use
+///
+void User::moveOperand(Use & from, Use & to)
+{
+    Value * usee = from.getUsee();
+
+    to.usee = usee;
+    to.user = from.user;
+
+    if (usee) {
+        usee->moveUse(&from, &to);
+    }
+
+    from.usee = nullptr;
+    from.user = nullptr;
+}
+
 ///
 /// @brief 构造函数
+/// @param _kind  具体的种类
 /// @param _type  类型
 ///
-User::User(Type * _type) : Value(_type)
+User::User(ValueKind _kind, Type * _type) : Value(_kind, _type)
 {}
 
+///
+/// @brief 析构函数，清除所有的操作数，操作数的use链中不能留下已释放的Use
+///
+User::~User()
+{
+    clearOperands();
+
+    if (operands != inlineOperands) {
+        delete[] operands;
+    }
+}
+
 ///
 /// @brief 更新指定Pos的Value
 /// @param pos 位置
@@ -33,11 +65,36 @@ User::User(Type * _type) : Value(_type)
 ///
 void User::setOperand(int32_t pos, Value * val)
 {
-    if (pos < (int32_t) operands.size()) {
-        operands[pos]->setUsee(val);
+    if (pos < operandCount) {
+        operands[pos].setUsee(val);
     }
 }
 
+///
+/// @brief 预留操作数数组的容量，已知操作数个数时避免多次扩大
+/// @param count 操作数个数
+///
+void User::reserveOperands(int32_t count)
+{
+    if (count <= operandCapacity) {
+        return;
+    }
+
+    Use * newOperands = new Use[count];
+
+    // Use的地址在usee的链表中，移动后要更新链表
+    for (int32_t pos = 0; pos < operandCount; ++pos) {
+        moveOperand(operands[pos], newOperands[pos]);
+    }
+
+    if (operands != inlineOperands) {
+        delete[] operands;
+    }
+
+    operands = newOperands;
+    operandCapacity = count;
+}
+
 ///
 /// @brief 增加操作数，或者说本身的值由这些操作数来计算得到
 /// @param pos 索引位置
@@ -45,14 +102,14 @@ void User::setOperand(int32_t pos, Value * val)
 ///
 void User::addOperand(Value * val)
 {
-    // If not, add the given Value as a new use.
-    auto use = new Use(val, this);
-
-    // 增加到操作数中
-    operands.push_back(use);
+    if (operandCount == operandCapacity) {
+        reserveOperands(operandCapacity * 2);
+    }
 
-    // 该val被使用
-    val->addUse(use);
+    // 直接使用数组中的Use，不再单独分配
+    Use & use = operands[operandCount++];
+    use.user = this;
+    use.setUsee(val);
 }
 
 ///
@@ -61,11 +118,10 @@ void User::addOperand(Value * val)
 ///
 void User::removeOperand(Value * val)
 {
-    for (auto & use: operands) {
-        if (use->getUsee() == val) {
+    for (int32_t pos = 0; pos < operandCount; ++pos) {
+        if (operands[pos].getUsee() == val) {
             // 找到了就删除这个Use
-            use->remove();
-            delete use;
+            removeOperand(pos);
             break;
         }
     }
@@ -78,38 +134,30 @@ void User::removeOperand(Value * val)
 void User::removeOperand(int pos)
 {
     // 检索并清除边，使得边的两头都会自动减少
-    if (pos < (int32_t) operands.size()) {
-
-        // 必须先暂存后释放，不能直接delete uses[pos]
-        // 这是因为use->remove会删除operands的元素，使得operands[pos]的对象不再是原来的对象
-        Use * use = operands[pos];
-        use->remove();
-        delete use;
+    if ((pos >= 0) && (pos < operandCount)) {
+        removeOperandRaw(&operands[pos]);
     }
 }
 
 ///
-/// @brief 清除指定的操作数
-/// @param pos 操作数的索引
+/// @brief 直接清除操作数的元素，后面的操作数依次前移
+/// @param use 指定的元素use，必须是本User的操作数
 ///
 void User::removeOperandRaw(Use * use)
 {
-    auto pIter = std::find(operands.begin(), operands.end(), use);
-    if (pIter != operands.end()) {
-        operands.erase(pIter);
+    int32_t pos = (int32_t) (use - operands);
+    if ((pos < 0) || (pos >= operandCount)) {
+        return;
     }
-}
 
-///
-/// @brief 清除指定的Use
-/// @param use define-use边
-///
-void User::removeUse(Use * use)
-{
-    auto pIter = std::find(operands.begin(), operands.end(), use);
-    if (pIter != operands.end()) {
-        use->remove();
+    use->setUsee(nullptr);
+    use->user = nullptr;
+
+    for (int32_t k = pos + 1; k < operandCount; ++k) {
+        moveOperand(operands[k], operands[k - 1]);
     }
+
+    operandCount--;
 }
 
 ///
@@ -117,23 +165,12 @@ void User::removeUse(Use * use)
 ///
 void User::clearOperands()
 {
-    for (int32_t pos = 0; pos < (int32_t) operands.size();) {
-
-        // 必须先暂存后释放，不能直接delete uses[pos]
-        // 这是因为use->remove会删除operands的元素，使得operands[pos]的对象不再是原来的对象
-
-        Use * use = operands[pos];
-        use->remove();
-        delete use;
+    for (int32_t pos = 0; pos < operandCount; ++pos) {
+        operands[pos].setUsee(nullptr);
+        operands[pos].user = nullptr;
     }
-}
-///
-/// @brief Get the Operands object
-/// @return std::vector<Use *>&
-///
-std::vector<Use *> & User::getOperands()
-{
-    return operands;
+
+    operandCount = 0;
 }
 
 ///
@@ -143,8 +180,8 @@ std::vector<Use *> & User::getOperands()
 std::vector<Value *> User::getOperandsValue()
 {
     std::vector<Value *> operandsVec;
-    for (auto & use: operands) {
-        operandsVec.emplace_back(use->getUsee());
+    for (int32_t pos = 0; pos < operandCount; ++pos) {
+        operandsVec.emplace_back(operands[pos].getUsee());
     }
     return operandsVec;
 }
@@ -155,7 +192,7 @@ std::vector<Value *> User::getOperandsValue()
 ///
 int32_t User::getOperandsNum()
 {
-    return (int32_t) operands.size();
+    return operandCount;
 }
 
 ///
@@ -165,8 +202,8 @@ int32_t User::getOperandsNum()
 ///
 Value * User::getOperand(int32_t pos)
 {
-    if (pos < (int32_t) operands.size()) {
-        return operands[pos]->getUsee();
+    if (pos < operandCount) {
+        return operands[pos].getUsee();
     }
 
     return nullptr;
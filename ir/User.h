@@ -3,7 +3,7 @@
 /// @brief 使用Value的User，该User也是Value。函数、指令都是User
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.2
 /// @date 2024-09-29
 ///
 /// @copyright Copyright (c) 2024
@@ -12,12 +12,14 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>Use直接存放在操作数数组中，不再单独分配
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>构造时指定种类标记，增加classof
 /// </table>
 ///
 #pragma once
 
-#include <unordered_map>
-#include <list>
+#include <cstdint>
+#include <vector>
 
 #include "Value.h"
 #include "Use.h"
@@ -29,26 +31,69 @@
 /// User可以是指令(Instruction)、常量表达式(ConstantExpr)、全局变量(GlobalVariable)等。
 /// User持有对Value的引用，并且可以有多个Value作为其操作数(Operands)
 ///
+/// 操作数的Use直接存放在操作数数组中，不超过inlineOperandCount个时就在对象内部，
+/// 超过时才在堆上分配数组。数组扩大或者移除中间的操作数时，Use移动位置后要更新usee链表中的指针
+///
 class User : public Value {
 
     ///
-    /// @brief 操作数列表，指向当前Value的所有操作数
+    /// @brief 对象内部可直接存放的操作数个数，大部分指令不超过两个操作数
+    ///
+    static constexpr int32_t inlineOperandCount = 2;
+
+    ///
+    /// @brief 对象内部的操作数数组
+    ///
+    Use inlineOperands[inlineOperandCount];
+
+    ///
+    /// @brief 操作数数组，指向inlineOperands或者堆上分配的数组
     ///
-    std::vector<Use *> operands;
+    Use * operands = inlineOperands;
+
+    ///
+    /// @brief 操作数的个数
+    ///
+    int32_t operandCount = 0;
+
+    ///
+    /// @brief 操作数数组的容量
+    ///
+    int32_t operandCapacity = inlineOperandCount;
+
+    ///
+    /// @brief 把Use移动到操作数数组的另一个位置，usee链表中的节点随之替换
+    /// @param from 原来的位置
+    /// @param to 新的位置，必须是空的Use
+    ///
+    static void moveOperand(Use & from, Use & to);
 
 public:
     ///
     /// @brief 构造函数
+    /// @param _kind  具体的种类
     /// @param _type  类型
-    /// @param _name  名称
     ///
-    User(Type * _type);
+    User(ValueKind _kind, Type * _type);
 
     ///
-    /// @brief Get the Operands object
-    /// @return std::vector<Use *>&
+    /// @brief 析构函数，清除所有的操作数
     ///
-    std::vector<Use *> & getOperands();
+    ~User() override;
+
+    ///
+    /// @brief 是否是User，供isa/cast/dyn_cast使用
+    /// @param value 值
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * value)
+    {
+        return value->getValueKind() >= ValueKind::VK_CONST_INT;
+    }
+
+    // 操作数的Use链在各个usee的链表中，不能拷贝
+    User(const User &) = delete;
+    User & operator=(const User &) = delete;
 
     ///
     /// @brief 取得操作数
@@ -76,6 +121,12 @@ public:
     ///
     void setOperand(int32_t pos, Value * val);
 
+    ///
+    /// @brief 预留操作数数组的容量，已知操作数个数时避免多次扩大
+    /// @param count 操作数个数
+    ///
+    void reserveOperands(int32_t count);
+
     ///
     /// @brief 增加操作数，或者说本身的值由这些操作数来计算得到
     /// @param pos 索引位置
@@ -101,14 +152,8 @@ public:
     ///
     void removeOperandRaw(Use * use);
 
-    ///
-    /// @brief 清除指定的Use
-    /// @param use define-use边
-    ///
-    void removeUse(Use * use);
-
     ///
     /// @brief 清除所有的操作数
     ///
     void clearOperands();
-};
\ No newline at end of file
+};
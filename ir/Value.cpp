@@ -3,7 +3,7 @@
 /// @brief 值操作类型，所有的变量、函数、常量都是Value
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.3
 /// @date 2024-09-29
 ///
 /// @copyright Copyright (c) 2024
@@ -12,32 +12,50 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>use链改为侵入式双向链表，增加replaceAllUsesWith
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>增加种类标记
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>析构时断言没有使用者
 /// </table>
 ///
 
-#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <mutex>
 
 #include "Value.h"
 #include "Use.h"
 
+///
+/// @brief 共享Value的use链锁，按地址分散到多把锁上，减少并行翻译时的竞争
+/// @param value 共享的Value
+/// @return std::mutex& 锁
+///
+static std::mutex & sharedUseLock(const Value * value)
+{
+    static std::mutex locks[64];
+
+    return locks[((uintptr_t) value >> 4) % 64];
+}
+
 /// @brief 构造函数
-/// @param _type
-Value::Value(Type * _type) : type(_type)
+/// @param _kind 具体的种类
+/// @param _type 类型
+Value::Value(ValueKind _kind, Type * _type) : type(_type), kind(_kind)
 {
     // 不需要增加代码
 }
 
-/// @brief 析构函数
+/// @brief 析构函数，要求使用者都已经解除了对它的使用，否则其use链会指向已释放的值
 Value::~Value()
 {
-    // 如有资源清理，请这里追加代码
+    assert(!useList && "value is destroyed while still used");
 }
 
 /// @brief 获取名字
 /// @return 变量名
 std::string Value::getName() const
 {
-    return name;
+    return symbolName(name);
 }
 
 ///
@@ -46,7 +64,7 @@ std::string Value::getName() const
 ///
 void Value::setName(std::string _name)
 {
-    this->name = _name;
+    this->name = internSymbol(_name);
 }
 
 /// @brief 获取名字
@@ -73,24 +91,101 @@ Type * Value::getType()
 }
 
 ///
-/// @brief 增加一条边，增加Value被使用次数
+/// @brief 增加一条边，增加Value被使用次数。插入到链表头，O(1)
 /// @param use
 ///
 void Value::addUse(Use * use)
 {
-    uses.push_back(use);
+    std::unique_lock<std::mutex> lock;
+    if (shared) {
+        lock = std::unique_lock<std::mutex>(sharedUseLock(this));
+    }
+
+    use->next = useList;
+    use->prev = &useList;
+    if (useList) {
+        useList->prev = &use->next;
+    }
+    useList = use;
 }
 
 ///
-/// @brief 消除一条边，减少Value被使用次数
+/// @brief 消除一条边，减少Value被使用次数。通过prev直接摘除，O(1)
 /// @param use
 ///
 void Value::removeUse(Use * use)
 {
-    auto pIter = std::find(uses.begin(), uses.end(), use);
-    if (pIter != uses.end()) {
-        uses.erase(pIter);
+    std::unique_lock<std::mutex> lock;
+    if (shared) {
+        lock = std::unique_lock<std::mutex>(sharedUseLock(this));
+    }
+
+    if (!use->prev) {
+        // 不在链表中
+        return;
+    }
+
+    *use->prev = use->next;
+    if (use->next) {
+        use->next->prev = use->prev;
+    }
+
+    use->next = nullptr;
+    use->prev = nullptr;
+}
+
+///
+/// @brief Use在User的操作数数组中移动位置时，用新位置的Use替换链表中原来的Use
+/// @param from 原来的Use，替换后不在链表中
+/// @param to 新的Use，替换前不在链表中
+///
+void Value::moveUse(Use * from, Use * to)
+{
+    std::unique_lock<std::mutex> lock;
+    if (shared) {
+        lock = std::unique_lock<std::mutex>(sharedUseLock(this));
     }
+
+    to->next = from->next;
+    to->prev = from->prev;
+    *to->prev = to;
+    if (to->next) {
+        to->next->prev = &to->next;
+    }
+
+    from->next = nullptr;
+    from->prev = nullptr;
+}
+
+///
+/// @brief 把所有使用本Value的地方都改为使用newVal，本Value不再被使用
+/// @param newVal 新的Value
+///
+void Value::replaceAllUsesWith(Value * newVal)
+{
+    if (newVal == this) {
+        return;
+    }
+
+    // 每次setUsee都把表头的Use移到newVal的链表中
+    while (useList) {
+        useList->setUsee(newVal);
+    }
+}
+
+///
+/// @brief 被使用的次数，需要遍历use链
+/// @return int32_t 次数
+///
+int32_t Value::getUseCount() const
+{
+    int32_t count = 0;
+
+    for (Use * use = useList; use; use = use->next) {
+        count++;
+    }
+
+    return count;
 }
 
 ///
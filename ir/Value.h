@@ -3,7 +3,7 @@
 /// @brief 值操作类型，所有的变量、函数、常量都是Value
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.4
 /// @date 2024-09-29
 ///
 /// @copyright Copyright (c) 2024
@@ -12,15 +12,54 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>use链改为侵入式双向链表，增加replaceAllUsesWith
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>增加种类标记，支持isa/cast/dyn_cast
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>只能在内存池中创建
+/// <tr><td>2026-10-15 <td>1.4     <td>zenglj  <td>析构时要求没有使用者
 /// </table>
 ///
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
+#include "Arena.h"
+#include "Casting.h"
 #include "Use.h"
 #include "Type.h"
+#include "StringInterner.h"
+
+///
+/// @brief Value的具体种类，由构造函数设定，isa/cast/dyn_cast据此判断类型而不借助RTTI。
+/// 同一基类的种类连续排列，判断是否属于某个基类只需比较区间
+///
+enum class ValueKind : std::uint8_t {
+
+    /// @brief 局部变量
+    VK_LOCAL_VARIABLE,
+
+    /// @brief 形参
+    VK_FORMAL_PARAM,
+
+    /// @brief 栈内寻址的内存变量
+    VK_MEM_VARIABLE,
+
+    /// @brief 寄存器变量
+    VK_REG_VARIABLE,
+
+    /// @brief 整数常量，User与Constant的第一种
+    VK_CONST_INT,
+
+    /// @brief 全局变量，GlobalValue的第一种
+    VK_GLOBAL_VARIABLE,
+
+    /// @brief 函数，Constant与GlobalValue的最后一种
+    VK_FUNCTION,
+
+    /// @brief 指令，具体是哪种指令由操作码区分
+    VK_INSTRUCTION,
+};
 
 ///
 /// @brief 值类，每个值都要有一个类型，全局变量和局部变量可以有名字，
@@ -32,8 +71,8 @@
 class Value {
 
 protected:
-    /// @brief 变量名，函数名等原始的名字，可能为空串
-    std::string name;
+    /// @brief 变量名，函数名等原始的名字，驻留在全局字符串驻留表中，可能为空串
+    SymbolId name = EmptySymbol;
 
     ///
     /// @brief IR名字，用于文本IR的输出
@@ -44,28 +83,86 @@ protected:
     Type * type;
 
     ///
-    /// @brief define-use链，这个定值被使用的所有边，即所有的User
+    /// @brief define-use链的表头，这个定值被使用的所有边，即所有的User。
+    /// 链表节点是各User操作数数组中的Use，加入与移出都是O(1)
     ///
-    std::vector<Use *> uses;
+    Use * useList = nullptr;
+
+    ///
+    /// @brief 是否被多个函数共享，如常量、全局变量与函数。并行翻译函数时共享Value的use链修改需加锁
+    ///
+    bool shared = false;
+
+    ///
+    /// @brief 具体的种类
+    ///
+    const ValueKind kind;
 
 public:
     /// @brief 构造函数
-    /// @param _type
-    explicit Value(Type * _type);
+    /// @param _kind 具体的种类
+    /// @param _type 类型
+    Value(ValueKind _kind, Type * _type);
 
-    /// @brief 析构函数
+    /// @brief 析构函数，要求已经没有使用者
     virtual ~Value();
 
+    ///
+    /// @brief Value只能在内存池中创建：函数内的指令与变量在函数的内存池中，
+    /// 全局变量、常量与函数在模块的内存池中，用法为 new (arena) X(...)
+    /// @param size 字节数
+    /// @param arena 内存池
+    /// @return void* 内存地址
+    ///
+    static void * operator new(size_t size, Arena & arena)
+    {
+        return arena.allocate(size, alignof(std::max_align_t));
+    }
+
+    /// @brief 构造函数抛出异常时调用，内存随内存池整体释放，这里不做事情
+    static void operator delete(void *, Arena &)
+    {}
+
+    /// @brief delete只执行析构函数，内存随内存池整体释放，这里不做事情
+    static void operator delete(void *)
+    {}
+
+    /// 禁止在堆上逐个创建
+    static void * operator new(size_t size) = delete;
+
+    /// @brief 获取具体的种类
+    /// @return 种类
+    [[nodiscard]] ValueKind getValueKind() const
+    {
+        return kind;
+    }
+
     /// @brief 获取名字
     /// @return 变量名
     [[nodiscard]] virtual std::string getName() const;
 
+    /// @brief 获取名字的符号编号
+    /// @return 符号编号
+    [[nodiscard]] SymbolId getNameId() const
+    {
+        return name;
+    }
+
     ///
     /// @brief 设置名字
     /// @param _name 名字
     ///
     void setName(std::string _name);
 
+    ///
+    /// @brief 设置名字
+    /// @param _name 名字的符号编号
+    ///
+    void setName(SymbolId _name)
+    {
+        name = _name;
+    }
+
     /// @brief 获取名字
     /// @return 变量名
     [[nodiscard]] virtual std::string getIRName() const;
@@ -92,6 +189,43 @@ public:
     ///
     void removeUse(Use * use);
 
+    ///
+    /// @brief Use在User的操作数数组中移动位置时，用新位置的Use替换链表中原来的Use
+    /// @param from 原来的Use，替换后不在链表中
+    /// @param to 新的Use，替换前不在链表中
+    ///
+    void moveUse(Use * from, Use * to);
+
+    ///
+    /// @brief 把所有使用本Value的地方都改为使用newVal，本Value不再被使用
+    /// @param newVal 新的Value
+    ///
+    void replaceAllUsesWith(Value * newVal);
+
+    ///
+    /// @brief 获取use链的第一个Use，通过Use::getNext遍历所有的使用
+    /// @return Use* 第一个Use，没有被使用时为空
+    ///
+    [[nodiscard]] Use * getUseList() const
+    {
+        return useList;
+    }
+
+    ///
+    /// @brief 是否被使用
+    /// @return true 被使用 false 没有被使用
+    ///
+    [[nodiscard]] bool hasUses() const
+    {
+        return useList != nullptr;
+    }
+
+    ///
+    /// @brief 被使用的次数，需要遍历use链
+    /// @return int32_t 次数
+    ///
+    [[nodiscard]] int32_t getUseCount() const;
+
     ///
     /// @brief 取得变量所在的作用域层级
     /// @return int32_t 层级
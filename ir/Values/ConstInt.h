@@ -27,12 +27,23 @@
 class ConstInt : public Constant {
 
 public:
+    ///
+    /// @brief 是否是整数常量，供isa/cast/dyn_cast使用
+    /// @param value 值
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * value)
+    {
+        return value->getValueKind() == ValueKind::VK_CONST_INT;
+    }
+
     ///
     /// @brief 指定值的常量
     /// \param val
-    explicit ConstInt(int32_t val) : Constant(IntegerType::getTypeInt())
+    explicit ConstInt(int32_t val) : Constant(ValueKind::VK_CONST_INT, IntegerType::getTypeInt())
     {
-        name = std::to_string(val);
+        // 常量的名字就是其值，不必驻留到全局字符串驻留表中
+        IRName = std::to_string(val);
         intVal = val;
     }
 
@@ -40,7 +51,7 @@ public:
     /// @return 变量名
     [[nodiscard]] std::string getIRName() const override
     {
-        return name;
+        return IRName;
     }
 
     ///
@@ -23,12 +23,22 @@
 class FormalParam : public Value {
 
 public:
+    ///
+    /// @brief 是否是形参，供isa/cast/dyn_cast使用
+    /// @param value 值
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * value)
+    {
+        return value->getValueKind() == ValueKind::VK_FORMAL_PARAM;
+    }
+
     /// @brief 基本类型的参数
     /// @param _name 形参的名字
     /// @param _type 基本类型
-    FormalParam(Type * _type, std::string _name) : Value(_type)
+    FormalParam(Type * _type, std::string _name) : Value(ValueKind::VK_FORMAL_PARAM, _type)
     {
-        this->name = _name;
+        setName(_name);
     };
 
     // /// @brief 输出字符串
@@ -25,12 +25,22 @@
 class GlobalVariable : public GlobalValue {
 
 public:
+    ///
+    /// @brief 是否是全局变量，供isa/cast/dyn_cast使用
+    /// @param value 值
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * value)
+    {
+        return value->getValueKind() == ValueKind::VK_GLOBAL_VARIABLE;
+    }
+
     ///
     /// @brief 构建全局变量，默认对齐为4字节
     /// @param _type 类型
     /// @param _name 名字
     ///
-    explicit GlobalVariable(Type * _type, std::string _name) : GlobalValue(_type, _name)
+    explicit GlobalVariable(Type * _type, std::string _name) : GlobalValue(ValueKind::VK_GLOBAL_VARIABLE, _type, _name)
     {
         // 设置对齐大小
         setAlignment(4);
@@ -33,13 +33,23 @@ private:
     /// @param _name 名称
     /// @param _scope_level 作用域层级
     ///
-    explicit LocalVariable(Type * _type, std::string _name, int32_t _scope_level)
-        : Value(_type), scope_level(_scope_level)
+    explicit LocalVariable(Type * _type, SymbolId _name, int32_t _scope_level)
+        : Value(ValueKind::VK_LOCAL_VARIABLE, _type), scope_level(_scope_level)
     {
         this->name = _name;
     }
 
 public:
+    ///
+    /// @brief 是否是局部变量，供isa/cast/dyn_cast使用
+    /// @param value 值
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * value)
+    {
+        return value->getValueKind() == ValueKind::VK_LOCAL_VARIABLE;
+    }
+
     ///
     /// @brief 取得变量所在的作用域层级
     /// @return int32_t 层级
@@ -27,10 +27,20 @@ class MemVariable : public Value {
 private:
     /// @brief 创建内存Value
     /// \param val
-    explicit MemVariable(Type * _type) : Value(_type)
+    explicit MemVariable(Type * _type) : Value(ValueKind::VK_MEM_VARIABLE, _type)
     {}
 
 public:
+    ///
+    /// @brief 是否是内存变量，供isa/cast/dyn_cast使用
+    /// @param value 值
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * value)
+    {
+        return value->getValueKind() == ValueKind::VK_MEM_VARIABLE;
+    }
+
     ///
     /// @brief @brief 如是内存变量型Value，则获取基址寄存器和偏移
     /// @param regId 寄存器编号
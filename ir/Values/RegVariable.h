@@ -22,12 +22,25 @@
 class RegVariable : public Value {
 
 public:
+    ///
+    /// @brief 是否是寄存器变量，供isa/cast/dyn_cast使用
+    /// @param value 值
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * value)
+    {
+        return value->getValueKind() == ValueKind::VK_REG_VARIABLE;
+    }
+
     /// @brief 整型寄存器型Value
     /// \param val
-    explicit RegVariable(Type * _type, std::string _name, int32_t _reg_no) : Value(_type)
+    explicit RegVariable(Type * _type, std::string _name, int32_t _reg_no) : Value(ValueKind::VK_REG_VARIABLE, _type)
     {
-        this->name = _name;
+        setName(_name);
         regId = _reg_no;
+
+        // 物理寄存器的Value全局唯一，被所有函数及同时进行的多个编译共享，use链修改需加锁
+        shared = true;
     }
 
     ///
@@ -43,7 +56,7 @@ public:
     /// @return 变量名
     [[nodiscard]] std::string getIRName() const override
     {
-        return name;
+        return getName();
     }
 
 private:
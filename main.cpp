@@ -9,8 +9,12 @@
  *
  */
 
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <set>
 #include <string>
+#include <vector>
 #include <getopt.h>
 
 #ifdef _WIN32
@@ -18,16 +22,9 @@
 #endif
 
 #include "Common.h"
-#include "AST.h"
-#include "Antlr4Executor.h"
-#include "CodeGenerator.h"
-#include "CodeGeneratorArm32.h"
-#include "FlexBisonExecutor.h"
-#include "FrontEndExecutor.h"
-#include "Graph.h"
-#include "IRGenerator.h"
-#include "RecursiveDescentExecutor.h"
-#include "Module.h"
+#include "CompileCache.h"
+#include "Compiler.h"
+#include "CompileServer.h"
 
 ///
 /// @brief 是否显示帮助信息
@@ -74,18 +71,66 @@ static bool gFrontEndRecursiveDescentParsing = false;
 ///
 static bool gAsmAlsoShowIR = false;
 
+///
+/// @brief 以函数为单位流式编译，只在输出汇编时有效
+///
+static bool gStreamCompile = false;
+
+/// @brief 是否输出前端语法分析的统计信息，目前只有antlr4前端支持
+static bool gShowParseStats = false;
+
+/// @brief 并行翻译函数体的线程数，即-j后面的数字，为0表示按硬件支持的并发线程数。
+/// 批量编译时为同时编译的源文件数，编译服务时为同时处理的请求数
+static unsigned gThreadCount = 0;
+
+/// @brief 是否指定了-j。没有指定时函数体串行翻译，批量编译与编译服务按硬件支持的并发线程数
+static bool gThreadCountSet = false;
+
+/// @brief 编译缓存的目录，即-C后面的目录，为空时不使用缓存
+static std::string gCacheDir;
+
 /// @brief 优化的级别，即-O后面的数字，默认为0
 static int gOptLevel = 0;
 
+/// @brief 是否输出各遍的耗时，即--time-passes
+static bool gTimePasses = false;
+
 /// @brief 指定CPU目标架构，这里默认为ARM32
 static std::string gCPUTarget = "ARM32";
 
-/// @brief 输入源文件
-static std::string gInputFile;
+/// @brief 输入源文件，多于一个时为批量编译
+static std::vector<std::string> gInputFiles;
 
-/// @brief 输出文件，不同的选项输出的内容不同
+/// @brief 输出文件，不同的选项输出的内容不同。批量编译时为输出目录
 static std::string gOutputFile;
 
+/// @brief 是否批量编译，多个源文件或者使用了@响应文件时为批量编译
+static bool gBatchMode = false;
+
+/// @brief 编译服务的套接字路径，即--serve后面的路径，非空时作为编译服务运行
+static std::string gServeSocket;
+
+/// @brief 客户端模式时编译服务的套接字路径，即--connect后面的路径，非空时把编译请求交给编译服务
+static std::string gConnectSocket;
+
+/// @brief 编译结束时是否跳过符号表与线性IR的释放，即--fast-exit，只对单个文件的编译有效
+static bool gFastExit = false;
+
+/// @brief 只有长选项的选项
+enum {
+    /// @brief --serve
+    OPTION_SERVE = 256,
+
+    /// @brief --connect
+    OPTION_CONNECT,
+
+    /// @brief --fast-exit
+    OPTION_FAST_EXIT,
+
+    /// @brief --time-passes
+    OPTION_TIME_PASSES,
+};
+
 static struct option long_options[] = {
     {"help", no_argument, 0, 'h'},
     {"output", required_argument, 0, 'o'},
@@ -97,6 +142,14 @@ static struct option long_options[] = {
     {"optimize", required_argument, 0, 'O'},
     {"target", required_argument, 0, 't'},
     {"asmir", no_argument, 0, 'c'},
+    {"stream", no_argument, 0, 'F'},
+    {"jobs", required_argument, 0, 'j'},
+    {"parse-stats", no_argument, 0, 'P'},
+    {"cache", required_argument, 0, 'C'},
+    {"serve", required_argument, 0, OPTION_SERVE},
+    {"connect", required_argument, 0, OPTION_CONNECT},
+    {"fast-exit", no_argument, 0, OPTION_FAST_EXIT},
+    {"time-passes", no_argument, 0, OPTION_TIME_PASSES},
     {0, 0, 0, 0}
 };
 
@@ -104,18 +157,90 @@ static struct option long_options[] = {
 /// @param exeName
 static void showHelp(const std::string & exeName)
 {
-    std::cout << exeName + " -S [--symbol] [-A | --antlr4 | -D | --recursive-descent] [-T | --ast | -I | --ir] [-o output | --output=output] source\n";
+    std::cout << exeName + " -S [--symbol] [-A | --antlr4 | -D | --recursive-descent] [-T | --ast | -I | --ir] [-o output | --output=output] source...\n";
     std::cout << "Options:\n";
     std::cout << "  -h, --help                 Show this help message\n";
-    std::cout << "  -o, --output=FILE          Specify output file\n";
+    std::cout << "  -o, --output=FILE          Specify output file (output directory in batch mode)\n";
     std::cout << "  -S, --symbol               Show symbol information\n";
     std::cout << "  -T, --ast                  Output abstract syntax tree\n";
     std::cout << "  -I, --ir                   Output intermediate representation\n";
     std::cout << "  -A, --antlr4               Use Antlr4 for lexical and syntax analysis\n";
     std::cout << "  -D, --recursive-descent    Use recursive descent parsing\n";
-    std::cout << "  -O, --optimize=LEVEL       Set optimization level\n";
+    std::cout << "  -O, --optimize=LEVEL       Set optimization level: 0 none (default), 1 promote locals to SSA,\n";
+    std::cout << "                             local CSE and dead code removal, 2 also constant propagation\n";
+    std::cout << "                             and dominator-based CSE\n";
     std::cout << "  -t, --target=CPU           Specify target CPU architecture\n";
     std::cout << "  -c, --asmir                Show IR instructions as comments in assembly output\n";
+    std::cout << "  -F, --stream               Compile one function at a time when generating assembly\n";
+    std::cout << "  -P, --parse-stats          Show ANTLR4 parse statistics (SLL parses, LL fallbacks, DFA cache)\n";
+    std::cout << "  -j, --jobs=N               Translate function bodies to IR with N threads (0: all cores;\n";
+    std::cout << "                             default 1), or compile N files at a time in batch mode\n";
+    std::cout << "  -C, --cache=DIR            Reuse IR/assembly of unchanged files and functions cached in DIR\n";
+    std::cout << "      --serve=SOCKET         Run as a compile server on a Unix domain socket, keeping warm state\n";
+    std::cout << "                             between requests (-j N: serve N requests at a time)\n";
+    std::cout << "      --connect=SOCKET       Send the compile request to the server on SOCKET instead of compiling\n";
+    std::cout << "      --fast-exit            Skip freeing the IR and symbol table when a single-file compile ends\n";
+    std::cout << "      --time-passes          Report the time spent in each optimization pass and analysis\n";
+    std::cout << "  @FILE                      Read more arguments (e.g. source files) from FILE\n";
+    std::cout << "Batch mode: with several sources or any @FILE, each source is compiled to its own output,\n";
+    std::cout << "named after the source with the extension replaced (.s, .ir or .png), in the -o directory if given.\n";
+}
+
+/// @brief 展开@响应文件，响应文件中的参数以空白分隔，可以再引用其它响应文件
+/// @param arg 命令行参数
+/// @param args 展开后的参数
+/// @param depth 响应文件的嵌套深度，避免响应文件相互引用时无穷展开
+/// @return true：成功，false：响应文件打不开或者嵌套太深
+static bool expandResponseFile(const std::string & arg, std::vector<std::string> & args, int depth = 0)
+{
+    if ((arg.size() < 2) || (arg[0] != '@')) {
+        args.push_back(arg);
+        return true;
+    }
+
+    if (depth >= 16) {
+        std::cerr << "response file " << arg.substr(1) << " nested too deeply\n";
+        return false;
+    }
+
+    std::ifstream in(arg.substr(1));
+    if (!in) {
+        std::cerr << "can not open response file " << arg.substr(1) << "\n";
+        return false;
+    }
+
+    gBatchMode = true;
+
+    std::string word;
+    while (in >> word) {
+        if (!expandResponseFile(word, args, depth + 1)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// @brief 批量编译时源文件的输出文件，源文件名替换扩展名，指定了输出目录时放在输出目录下
+/// @param inputFile 源文件
+/// @return 输出文件
+static std::string batchOutputFile(const std::string & inputFile)
+{
+    std::filesystem::path path(inputFile);
+
+    if (gShowAST) {
+        path.replace_extension(".png");
+    } else if (gShowLineIR) {
+        path.replace_extension(".ir");
+    } else {
+        path.replace_extension(".s");
+    }
+
+    if (!gOutputFile.empty()) {
+        path = std::filesystem::path(gOutputFile) / path.filename();
+    }
+
+    return path.string();
 }
 
 /// @brief 参数解析与有效性检查
@@ -134,7 +259,11 @@ static int ArgsAnalysis(int argc, char * argv[])
     // -O要求必须带有附加整数，指明优化的级别
     // -t要求必须带有目标CPU，指明目标CPU的汇编
     // -c选项在输出汇编时有效，附带输出IR指令内容
-    const char options[] = "ho:STIADO:t:c";
+    // -F选项在输出汇编时有效，以函数为单位流式编译
+    // -j要求必须带有附加整数，指明并行翻译函数体的线程数
+    // -P选项在antlr4前端时有效，输出SLL与LL两阶段分析的统计信息
+    // -C要求必须带有附加目录，指明编译缓存的目录
+    const char options[] = "ho:STIADO:t:cFj:PC:";
     int option_index = 0;
 
     opterr = 1;
@@ -172,7 +301,7 @@ lb_check:
                 gFrontEndRecursiveDescentParsing = true;
                 break;
             case 'O':
-                // 优化级别分析，暂时没有用，如开启优化时请使用
+                // 优化级别，决定遍管理器中执行的遍
                 gOptLevel = std::stoi(optarg);
                 break;
             case 't':
@@ -181,6 +310,31 @@ lb_check:
             case 'c':
                 gAsmAlsoShowIR = true;
                 break;
+            case 'F':
+                gStreamCompile = true;
+                break;
+            case 'P':
+                gShowParseStats = true;
+                break;
+            case 'j':
+                gThreadCount = (unsigned) std::stoi(optarg);
+                gThreadCountSet = true;
+                break;
+            case 'C':
+                gCacheDir = optarg;
+                break;
+            case OPTION_SERVE:
+                gServeSocket = optarg;
+                break;
+            case OPTION_CONNECT:
+                gConnectSocket = optarg;
+                break;
+            case OPTION_FAST_EXIT:
+                gFastExit = true;
+                break;
+            case OPTION_TIME_PASSES:
+                gTimePasses = true;
+                break;
             default:
                 return -1;
                 break; /* no break */
@@ -192,14 +346,8 @@ lb_check:
 
     if (argc >= 1) {
 
-        // 第一次设置
-        if (gInputFile.empty()) {
-
-            gInputFile = argv[0];
-        } else {
-            // 重复设置则出错
-            return -1;
-        }
+        // 可以有多个源文件，多于一个时批量编译
+        gInputFiles.push_back(argv[0]);
 
         if (argc > 1) {
             // 多余一个参数，则说明输入的源文件后仍然有参数要解析
@@ -208,11 +356,20 @@ lb_check:
         }
     }
 
+    // 编译服务不需要源文件，编译请求中带有源文件与选项
+    if (!gServeSocket.empty()) {
+        return 0;
+    }
+
     // 必须指定要进行编译的输入文件
-    if (gInputFile.empty()) {
+    if (gInputFiles.empty()) {
         return -1;
     }
 
+    if (gInputFiles.size() > 1) {
+        gBatchMode = true;
+    }
+
     // 显示符号信息，必须指定，可选抽象语法树、中间IR(DragonIR)等显示
     if (!gShowSymbol) {
         return -1;
@@ -228,8 +385,8 @@ lb_check:
         return -1;
     }
 
-    // 没有指定输出文件则产生默认文件
-    if (gOutputFile.empty()) {
+    // 没有指定输出文件则产生默认文件，批量编译时由源文件名产生输出文件名
+    if (gOutputFile.empty() && !gBatchMode) {
 
         // 默认文件名
         if (gShowAST) {
@@ -244,151 +401,6 @@ lb_check:
     return 0;
 }
 
-///
-/// @brief 对源文件进行编译处理生成汇编
-/// @return true 成功
-/// @return false 失败
-///
-static int compile(std::string inputFile, std::string outputFile)
-{
-    // 函数返回值，默认-1
-    int result = -1;
-
-    // 内部函数调用返回值保存变量
-    int subResult;
-
-    Module * module = nullptr;
-
-    // 这里采用do {} while(0)架构的目的是如果处理出错可通过break退出循环，出口唯一
-    // 在编译器编译优化时会自动去除，因为while恒假的缘故
-    do {
-
-        // 编译过程主要包括：
-        // 1）词法语法分析生成AST
-        // 2) 遍历AST生成线性IR
-        // 3) 对线性IR进行优化：目前不支持
-        // 4) 把线性IR转换成汇编
-
-        // 创建词法语法分析器
-        FrontEndExecutor * frontEndExecutor;
-        if (gFrontEndAntlr4) {
-            // Antlr4
-            frontEndExecutor = new Antlr4Executor(inputFile);
-        } else if (gFrontEndRecursiveDescentParsing) {
-            // 递归下降分析法
-            frontEndExecutor = new RecursiveDescentExecutor(inputFile);
-        } else {
-            // 默认为Flex+Bison
-            frontEndExecutor = new FlexBisonExecutor(inputFile);
-        }
-
-        // 前端执行：词法分析、语法分析后产生抽象语法树，其root为全局变量ast_root
-        subResult = frontEndExecutor->run();
-        if (!subResult) {
-
-            minic_log(LOG_ERROR, "前端分析错误");
-            // 退出循环
-            break;
-        }
-
-        // 获取抽象语法树的根节点
-        ast_node * astRoot = frontEndExecutor->getASTRoot();
-
-        // 清理前端资源
-        delete frontEndExecutor;
-
-        // 这里可进行非线性AST的优化
-
-        if (gShowAST) {
-
-            // 遍历抽象语法树，生成抽象语法树图片
-            OutputAST(astRoot, outputFile);
-
-            // 清理抽象语法树
-            free_ast(astRoot);
-
-            // 设置返回结果：正常
-            result = 0;
-
-            break;
-        }
-
-        // 输出线性中间IR、计算器模拟解释执行、输出汇编指令
-        // 都需要遍历AST转换成线性IR指令
-
-        // 符号表，保存所有的变量以及函数等信息
-        Module * module = new Module(inputFile);
-
-        // 遍历抽象语法树产生线性IR，相关信息保存到符号表中
-        IRGenerator ast2IR(astRoot, module);
-        subResult = ast2IR.run();
-        if (!subResult) {
-
-            // 输出错误信息
-            minic_log(LOG_ERROR, "中间IR生成错误");
-
-            break;
-        }
-
-        // 清理抽象语法树
-        free_ast(astRoot);
-
-        if (gShowLineIR) {
-
-            // 对IR的名字重命名
-            module->renameIR();
-
-            // 输出IR
-            module->outputIR(outputFile);
-
-            // 设置返回结果：正常
-            result = 0;
-
-            break;
-        }
-
-        // 要使得汇编能输出IR指令作为注释，必须对IR的名字进行命名，否则为空值
-        if (gAsmAlsoShowIR) {
-            // 对IR的名字重命名
-            module->renameIR();
-        }
-
-        // 这里可追加中间代码优化，体系结果无关的优化等
-
-        // 后端处理，体系结果相关的操作
-        // 这里提供一种面向ARM32的汇编产生器CodeGeneratorArm32作为参考
-        // 需要时可根据需要修改或追加新的目标体系架构
-        if (gShowASM) {
-
-            CodeGenerator * generator = nullptr;
-
-            if (gCPUTarget == "ARM32") {
-                // 输出面向ARM32的汇编指令
-                generator = new CodeGeneratorArm32(module);
-                generator->setShowLinearIR(gAsmAlsoShowIR);
-                generator->run(outputFile);
-            } else {
-                // 不支持指定的CPU架构
-                minic_log(LOG_ERROR, "指定的目标CPU架构(%s)不支持", gCPUTarget.c_str());
-                break;
-            }
-
-            delete generator;
-        }
-
-        // 清理符号表
-        module->Delete();
-
-        // 成功执行
-        result = 0;
-
-    } while (false);
-
-    delete module;
-
-    return result;
-}
-
 /// @brief 主程序
 /// @param argc
 /// @param argv
@@ -402,8 +414,23 @@ int main(int argc, char * argv[])
     SetConsoleOutputCP(65001);
 #endif
 
+    // 展开@响应文件，展开后的参数再按命令行的选项解析
+    std::vector<std::string> args;
+    for (int k = 1; k < argc; ++k) {
+        if (!expandResponseFile(argv[k], args)) {
+            return -1;
+        }
+    }
+
+    std::vector<char *> expandedArgv;
+    expandedArgv.push_back(argv[0]);
+    for (auto & arg: args) {
+        expandedArgv.push_back(arg.data());
+    }
+    expandedArgv.push_back(nullptr);
+
     // 参数解析
-    result = ArgsAnalysis(argc, argv);
+    result = ArgsAnalysis((int) expandedArgv.size() - 1, expandedArgv.data());
     if (result < 0) {
 
         // 在终端显示程序帮助信息
@@ -421,8 +448,79 @@ int main(int argc, char * argv[])
         return 0;
     }
 
-    // 参数解析正确，进行编译处理，目前只支持一个文件的编译。
-    result = compile(gInputFile, gOutputFile);
+    if (!gServeSocket.empty()) {
+        // 作为编译服务运行，-j指定同时处理的请求数
+        return serveCompile(gServeSocket, gThreadCount);
+    }
+
+    // 参数解析正确，按命令行的选项设置编译选项
+    CompileOptions options;
+    options.showAST = gShowAST;
+    options.showLineIR = gShowLineIR;
+    options.showASM = gShowASM;
+    options.asmAlsoShowIR = gAsmAlsoShowIR;
+    options.streamCompile = gStreamCompile;
+    options.showParseStats = gShowParseStats;
+    options.threadCount = gThreadCountSet ? gThreadCount : 1;
+    options.optLevel = gOptLevel;
+    options.timePasses = gTimePasses;
+    options.cpuTarget = gCPUTarget;
+    options.fastExit = gFastExit && !gBatchMode;
+
+    if (gFrontEndAntlr4) {
+        options.frontEnd = FrontEndKind::Antlr4;
+    } else if (gFrontEndRecursiveDescentParsing) {
+        options.frontEnd = FrontEndKind::RecursiveDescent;
+    } else {
+        options.frontEnd = FrontEndKind::FlexBison;
+    }
+
+    // 各源文件及其输出文件
+    std::vector<CompileJob> jobs(gInputFiles.size());
+
+    if (gBatchMode) {
+        // 批量编译，各源文件的输出文件不能相同
+        std::set<std::string> outputFiles;
+
+        for (size_t k = 0; k < gInputFiles.size(); ++k) {
+            jobs[k].inputFile = gInputFiles[k];
+            jobs[k].outputFile = batchOutputFile(gInputFiles[k]);
+
+            if (!outputFiles.insert(jobs[k].outputFile).second) {
+                std::cerr << "output file " << jobs[k].outputFile << " of " << gInputFiles[k] << " is duplicated\n";
+                return -1;
+            }
+        }
+
+        if (!gOutputFile.empty()) {
+            std::error_code ec;
+            std::filesystem::create_directories(gOutputFile, ec);
+        }
+    } else {
+        jobs[0].inputFile = gInputFiles[0];
+        jobs[0].outputFile = gOutputFile;
+    }
+
+    if (!gConnectSocket.empty()) {
+        // 客户端模式，交给编译服务编译
+        return compileRemote(gConnectSocket, options, gCacheDir, jobs, gBatchMode, gThreadCount);
+    }
+
+    // 指定了缓存目录时使用编译缓存
+    CompileCache * cache = nullptr;
+    if (!gCacheDir.empty()) {
+        cache = new CompileCache(gCacheDir);
+        options.cache = cache;
+    }
+
+    if (gBatchMode) {
+        result = compileBatch(options, jobs, gThreadCount);
+    } else {
+        // 进行单个文件的编译处理
+        result = compile(options, jobs[0].inputFile, jobs[0].outputFile);
+    }
+
+    delete cache;
 
     return result;
 }
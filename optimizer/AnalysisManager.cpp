@@ -0,0 +1,145 @@
+///
+/// @file AnalysisManager.cpp
+/// @brief 分析管理器，按函数缓存控制流图、支配信息与活跃变量等分析结果，IR修改后使其失效
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <chrono>
+
+#include "AnalysisManager.h"
+#include "Function.h"
+
+/// @brief 获取函数的控制流图，失效时重新划分基本块
+/// @param func 函数
+/// @return ControlFlowGraph& 控制流图
+ControlFlowGraph & AnalysisManager::getCFG(Function * func)
+{
+    FunctionAnalyses & state = analyses[func];
+
+    if (!state.cfgValid) {
+        auto start = std::chrono::steady_clock::now();
+
+        func->getCFG().build(func);
+        state.cfgValid = true;
+        state.domValid = false;
+
+        if (timePasses) {
+            timings[ANALYSIS_CFG].seconds +=
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            timings[ANALYSIS_CFG].runs++;
+        }
+    }
+
+    return func->getCFG();
+}
+
+/// @brief 获取含有支配信息的控制流图，支配信息失效时重新计算
+/// @param func 函数
+/// @return ControlFlowGraph& 控制流图
+ControlFlowGraph & AnalysisManager::getDominators(Function * func)
+{
+    ControlFlowGraph & cfg = getCFG(func);
+    FunctionAnalyses & state = analyses[func];
+
+    if (!state.domValid) {
+        auto start = std::chrono::steady_clock::now();
+
+        cfg.computeDominators();
+        state.domValid = true;
+
+        if (timePasses) {
+            timings[ANALYSIS_DOMINATORS].seconds +=
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            timings[ANALYSIS_DOMINATORS].runs++;
+        }
+    }
+
+    return cfg;
+}
+
+/// @brief 获取函数的活跃变量分析结果，失效时重新计算
+/// @param func 函数
+/// @return const Liveness& 活跃变量分析结果
+const Liveness & AnalysisManager::getLiveness(Function * func)
+{
+    getCFG(func);
+    FunctionAnalyses & state = analyses[func];
+
+    if (!state.livenessValid) {
+        auto start = std::chrono::steady_clock::now();
+
+        state.liveness.compute(func);
+        state.livenessValid = true;
+
+        if (timePasses) {
+            timings[ANALYSIS_LIVENESS].seconds +=
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            timings[ANALYSIS_LIVENESS].runs++;
+        }
+    }
+
+    return state.liveness;
+}
+
+/// @brief 函数的IR修改后使其分析结果失效
+/// @param func 函数
+/// @param keepCFG 控制流图与支配信息是否仍然有效
+void AnalysisManager::invalidate(Function * func, bool keepCFG)
+{
+    auto iter = analyses.find(func);
+    if (iter == analyses.end()) {
+        return;
+    }
+
+    FunctionAnalyses & state = iter->second;
+    if (!keepCFG) {
+        state.cfgValid = false;
+        state.domValid = false;
+    }
+    state.livenessValid = false;
+}
+
+/// @brief 各分析的累计耗时之和
+/// @return double 秒数
+double AnalysisManager::getTotalSeconds() const
+{
+    double total = 0;
+    for (const auto & timing: timings) {
+        total += timing.seconds;
+    }
+
+    return total;
+}
+
+/// @brief 输出各分析的耗时
+/// @param fp 输出文件
+/// @param total 遍与分析的总耗时，用于计算百分比
+void AnalysisManager::printTimings(FILE * fp, double total) const
+{
+    static const char * names[ANALYSIS_MAX] = {"cfg", "dominators", "liveness"};
+
+    for (int k = 0; k < ANALYSIS_MAX; ++k) {
+        const AnalysisTiming & timing = timings[k];
+        if (timing.runs == 0) {
+            continue;
+        }
+
+        double percent = (total > 0) ? timing.seconds * 100 / total : 0;
+        fprintf(fp,
+                "  %10.6f (%5.1f%%)  %8d  %8s  %s (analysis)\n",
+                timing.seconds,
+                percent,
+                timing.runs,
+                "-",
+                names[k]);
+    }
+}
@@ -0,0 +1,162 @@
+///
+/// @file AnalysisManager.h
+/// @brief 分析管理器，按函数缓存控制流图、支配信息与活跃变量等分析结果，IR修改后使其失效
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <cstdio>
+#include <unordered_map>
+
+#include "Liveness.h"
+
+class ControlFlowGraph;
+class Function;
+class Module;
+
+///
+/// @brief 分析管理器。分析结果在第一次获取时计算，之后直接使用缓存，
+/// 遍修改了IR后由遍管理器调用invalidate使失效，下次获取时重新计算
+///
+class AnalysisManager {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 模块，遍可通过它创建常量等
+    ///
+    explicit AnalysisManager(Module * _module) : module(_module)
+    {}
+
+    ///
+    /// @brief 获取模块
+    /// @return Module* 模块
+    ///
+    [[nodiscard]] Module * getModule() const
+    {
+        return module;
+    }
+
+    ///
+    /// @brief 获取函数的控制流图，失效时重新划分基本块
+    /// @param func 函数
+    /// @return ControlFlowGraph& 控制流图
+    ///
+    ControlFlowGraph & getCFG(Function * func);
+
+    ///
+    /// @brief 获取含有支配信息的控制流图，支配信息失效时重新计算
+    /// @param func 函数
+    /// @return ControlFlowGraph& 控制流图
+    ///
+    ControlFlowGraph & getDominators(Function * func);
+
+    ///
+    /// @brief 获取函数的活跃变量分析结果，失效时重新计算
+    /// @param func 函数
+    /// @return const Liveness& 活跃变量分析结果
+    ///
+    const Liveness & getLiveness(Function * func);
+
+    ///
+    /// @brief 函数的IR修改后使其分析结果失效
+    /// @param func 函数
+    /// @param keepCFG 控制流图与支配信息是否仍然有效
+    ///
+    void invalidate(Function * func, bool keepCFG = false);
+
+    ///
+    /// @brief 函数的IR释放后删除其分析结果，用于流式编译
+    /// @param func 函数
+    ///
+    void erase(Function * func)
+    {
+        analyses.erase(func);
+    }
+
+    ///
+    /// @brief 统计分析的耗时，用于--time-passes
+    /// @param enable 是否统计
+    ///
+    void setTimePasses(bool enable)
+    {
+        timePasses = enable;
+    }
+
+    ///
+    /// @brief 输出各分析的耗时
+    /// @param fp 输出文件
+    /// @param total 遍与分析的总耗时，用于计算百分比
+    ///
+    void printTimings(FILE * fp, double total) const;
+
+    ///
+    /// @brief 各分析的累计耗时之和
+    /// @return double 秒数
+    ///
+    [[nodiscard]] double getTotalSeconds() const;
+
+private:
+    ///
+    /// @brief 一个函数的分析结果的状态
+    ///
+    struct FunctionAnalyses {
+        /// @brief 控制流图是否有效
+        bool cfgValid = false;
+
+        /// @brief 支配信息是否有效
+        bool domValid = false;
+
+        /// @brief 活跃变量分析结果是否有效
+        bool livenessValid = false;
+
+        /// @brief 活跃变量分析结果
+        Liveness liveness;
+    };
+
+    ///
+    /// @brief 分析的种类，用于耗时统计
+    ///
+    enum AnalysisKind { ANALYSIS_CFG, ANALYSIS_DOMINATORS, ANALYSIS_LIVENESS, ANALYSIS_MAX };
+
+    ///
+    /// @brief 一种分析的耗时统计
+    ///
+    struct AnalysisTiming {
+        /// @brief 累计耗时，秒
+        double seconds = 0;
+
+        /// @brief 计算的次数
+        int runs = 0;
+    };
+
+    ///
+    /// @brief 模块
+    ///
+    Module * module;
+
+    ///
+    /// @brief 各函数的分析结果
+    ///
+    std::unordered_map<Function *, FunctionAnalyses> analyses;
+
+    ///
+    /// @brief 是否统计耗时
+    ///
+    bool timePasses = false;
+
+    ///
+    /// @brief 各种分析的耗时统计
+    ///
+    AnalysisTiming timings[ANALYSIS_MAX];
+};
@@ -0,0 +1,157 @@
+///
+/// @file DeadCodeElimination.cpp
+/// @brief 死代码删除，标记有副作用的指令及其依赖的指令，删除其余的指令
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <algorithm>
+
+#include "DeadCodeElimination.h"
+#include "Casting.h"
+#include "Function.h"
+#include "MoveInstruction.h"
+
+/// @brief 构造函数
+/// @param _func 要处理的函数
+DeadCodeElimination::DeadCodeElimination(Function * _func) : func(_func)
+{}
+
+/// @brief 执行死代码删除
+/// @return int32_t 删除的不可达块、指令与局部变量的个数
+int32_t DeadCodeElimination::run()
+{
+    ControlFlowGraph & cfg = func->getCFG();
+    if (cfg.empty()) {
+        return 0;
+    }
+
+    // goto与return之后的指令不可达，整块删除
+    int32_t count = cfg.removeUnreachableBlocks();
+
+    // 标记：先都置为Dead，再从根指令出发标记活跃的指令
+    for (Instruction * inst: func->getInterCode()) {
+        inst->setDead(true);
+
+        if (auto * move = dyn_cast<MoveInstruction>(inst)) {
+            if (auto * var = dyn_cast<LocalVariable>(move->getOperand(0))) {
+                varDefs[var].push_back(move);
+            }
+        }
+    }
+
+    for (Instruction * inst: func->getInterCode()) {
+        if (isRoot(inst)) {
+            markLive(inst);
+        }
+    }
+
+    while (!worklist.empty()) {
+        Instruction * inst = worklist.back();
+        worklist.pop_back();
+
+        // 赋值指令的第一个操作数是被赋值的变量，不是读
+        int32_t operandsNum = inst->getOperandsNum();
+        for (int32_t k = isa<MoveInstruction>(inst) ? 1 : 0; k < operandsNum; ++k) {
+            markOperand(inst->getOperand(k));
+        }
+    }
+
+    // 清除：死指令之间可能相互使用，先都去掉操作数再删除
+    std::vector<Instruction *> deadInsts;
+    for (BasicBlock * bb: cfg.getBlocks()) {
+        for (Instruction * inst: *bb) {
+            if (inst->isDead()) {
+                deadInsts.push_back(inst);
+            }
+        }
+    }
+
+    for (Instruction * inst: deadInsts) {
+        inst->clearOperands();
+    }
+
+    for (Instruction * inst: deadInsts) {
+        inst->getBasicBlock()->erase(inst);
+    }
+
+    count += (int32_t) deadInsts.size();
+
+    // 不再被读写的局部变量从函数中删除，后端不再为其分配栈空间
+    auto & varValues = func->getVarValues();
+    auto unused = std::stable_partition(varValues.begin(), varValues.end(), [](LocalVariable * var) {
+        return var->hasUses();
+    });
+
+    for (auto iter = unused; iter != varValues.end(); ++iter) {
+        if (*iter == func->getReturnValue()) {
+            func->setReturnValue(nullptr);
+        }
+        delete *iter;
+        count++;
+    }
+    varValues.erase(unused, varValues.end());
+
+    return count;
+}
+
+/// @brief 是否是根指令
+/// @param inst 指令
+/// @return true 是 false 不是
+bool DeadCodeElimination::isRoot(Instruction * inst)
+{
+    switch (inst->getOp()) {
+        case IRInstOperator::IRINST_OP_ENTRY:
+        case IRInstOperator::IRINST_OP_EXIT:
+        case IRInstOperator::IRINST_OP_LABEL:
+        case IRInstOperator::IRINST_OP_GOTO:
+        case IRInstOperator::IRINST_OP_FUNC_CALL:
+        case IRInstOperator::IRINST_OP_ARG:
+            return true;
+        case IRInstOperator::IRINST_OP_ASSIGN:
+            // 对全局变量与形参等的赋值在函数外可见
+            return !isa<LocalVariable>(inst->getOperand(0));
+        default:
+            // 二元运算与phi指令只在其值被使用时才活跃
+            return false;
+    }
+}
+
+/// @brief 标记指令活跃，加入工作表
+/// @param inst 指令
+void DeadCodeElimination::markLive(Instruction * inst)
+{
+    if (inst->isDead()) {
+        inst->setDead(false);
+        worklist.push_back(inst);
+    }
+}
+
+/// @brief 标记活跃指令读取的值
+/// @param val 被读取的值
+void DeadCodeElimination::markOperand(Value * val)
+{
+    if (auto * inst = dyn_cast<Instruction>(val)) {
+        markLive(inst);
+        return;
+    }
+
+    // 读局部变量时，对它的所有赋值都可能到达，只标记一次
+    if (auto * var = dyn_cast<LocalVariable>(val)) {
+        auto iter = varDefs.find(var);
+        if (iter != varDefs.end()) {
+            for (Instruction * def: iter->second) {
+                markLive(def);
+            }
+            varDefs.erase(iter);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+///
+/// @file DeadCodeElimination.h
+/// @brief 死代码删除，标记有副作用的指令及其依赖的指令，删除其余的指令
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class Function;
+class Instruction;
+class LocalVariable;
+class Value;
+
+///
+/// @brief 标记-清除的死代码删除。先删除从入口不可达的块（如return之后的语句），
+/// 再把所有指令置为Dead，从根指令出发沿操作数标记活跃的指令，最后删除仍为Dead的指令。
+/// 根指令为入口、出口、标签与跳转指令，函数调用（用户函数与putint/getint等内置函数都可能有副作用），
+/// 以及对全局变量的赋值。对局部变量的赋值只有在该变量被活跃的指令读取时才活跃。
+/// 删除指令后不再被使用的局部变量从函数中删除，后端不再为其分配栈空间
+///
+class DeadCodeElimination {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _func 要处理的函数，要求其控制流图已经建立
+    ///
+    explicit DeadCodeElimination(Function * _func);
+
+    ///
+    /// @brief 执行死代码删除
+    /// @return int32_t 删除的不可达块、指令与局部变量的个数，为0时没有修改
+    ///
+    int32_t run();
+
+private:
+    ///
+    /// @brief 是否是根指令，即有副作用或者影响控制流的指令
+    /// @param inst 指令
+    /// @return true 是 false 不是
+    ///
+    static bool isRoot(Instruction * inst);
+
+    ///
+    /// @brief 标记指令活跃，加入工作表
+    /// @param inst 指令
+    ///
+    void markLive(Instruction * inst);
+
+    ///
+    /// @brief 标记活跃指令读取的值：指令直接标记，局部变量则标记对其的所有赋值
+    /// @param val 被读取的值
+    ///
+    void markOperand(Value * val);
+
+    ///
+    /// @brief 要处理的函数
+    ///
+    Function * func;
+
+    ///
+    /// @brief 局部变量到对其赋值的指令的映射
+    ///
+    std::unordered_map<LocalVariable *, std::vector<Instruction *>> varDefs;
+
+    ///
+    /// @brief 活跃而操作数还未标记的指令
+    ///
+    std::vector<Instruction *> worklist;
+};
@@ -0,0 +1,157 @@
+///
+/// @file Liveness.cpp
+/// @brief 活跃变量分析，求出每个基本块入口与出口处活跃的局部变量与临时变量
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include "Liveness.h"
+#include "Casting.h"
+#include "Function.h"
+#include "MoveInstruction.h"
+#include "PhiInstruction.h"
+
+/// @brief 对函数进行活跃变量分析，逆向迭代直到不动点
+/// @param func 函数
+void Liveness::compute(Function * func)
+{
+    indexMap.clear();
+    values.clear();
+
+    const auto & blocks = func->getCFG().getBlocks();
+
+    // 分析对象编号：局部变量在前，有值的指令在后
+    for (LocalVariable * var: func->getVarValues()) {
+        indexMap.emplace(var, (int32_t) values.size());
+        values.push_back(var);
+    }
+    for (BasicBlock * bb: blocks) {
+        for (Instruction * inst: *bb) {
+            if (inst->hasResultValue()) {
+                indexMap.emplace(inst, (int32_t) values.size());
+                values.push_back(inst);
+            }
+        }
+    }
+
+    size_t words = (values.size() + 63) / 64;
+    std::vector<BitVector> uses(blocks.size(), BitVector(words, 0));
+    std::vector<BitVector> defs(blocks.size(), BitVector(words, 0));
+    liveIn.assign(blocks.size(), BitVector(words, 0));
+    liveOut.assign(blocks.size(), BitVector(words, 0));
+
+    // 块内正向扫描求出先使用后定值的集合与定值集合，phi的操作数计入来源块的出口
+    for (BasicBlock * bb: blocks) {
+        BitVector & use = uses[bb->getIndex()];
+        BitVector & def = defs[bb->getIndex()];
+
+        for (Instruction * inst: *bb) {
+            if (auto * phi = dyn_cast<PhiInstruction>(inst)) {
+                for (int32_t k = 0; k < phi->getIncomingNum(); ++k) {
+                    int32_t index = valueIndex(phi->getIncomingValue(k));
+                    BasicBlock * pred = phi->getIncomingBlock(k);
+                    if ((index >= 0) && pred) {
+                        set(liveOut[pred->getIndex()], index);
+                    }
+                }
+            } else {
+                // 赋值指令的第一个操作数是被赋值的变量
+                int32_t operandsNum = inst->getOperandsNum();
+                for (int32_t k = isa<MoveInstruction>(inst) ? 1 : 0; k < operandsNum; ++k) {
+                    int32_t index = valueIndex(inst->getOperand(k));
+                    if ((index >= 0) && !test(def, index)) {
+                        set(use, index);
+                    }
+                }
+            }
+
+            int32_t index = isa<MoveInstruction>(inst) ? valueIndex(inst->getOperand(0)) : valueIndex(inst);
+            if (index >= 0) {
+                set(def, index);
+            }
+        }
+    }
+
+    // 出口集合为后继入口集合之并，入口集合为使用集合并上出口集合减去定值集合，逆序迭代收敛较快
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        for (auto iter = blocks.rbegin(); iter != blocks.rend(); ++iter) {
+            BasicBlock * bb = *iter;
+            BitVector & out = liveOut[bb->getIndex()];
+            BitVector & in = liveIn[bb->getIndex()];
+            const BitVector & use = uses[bb->getIndex()];
+            const BitVector & def = defs[bb->getIndex()];
+
+            for (BasicBlock * succ: bb->getSuccessors()) {
+                const BitVector & succIn = liveIn[succ->getIndex()];
+                for (size_t w = 0; w < words; ++w) {
+                    out[w] |= succIn[w];
+                }
+            }
+
+            for (size_t w = 0; w < words; ++w) {
+                uint64_t newIn = use[w] | (out[w] & ~def[w]);
+                if (newIn != in[w]) {
+                    in[w] = newIn;
+                    changed = true;
+                }
+            }
+        }
+    }
+}
+
+/// @brief 值在基本块入口处是否活跃
+/// @param bb 基本块
+/// @param val 局部变量或有值的指令
+/// @return true 活跃 false 不活跃
+bool Liveness::isLiveIn(const BasicBlock * bb, Value * val) const
+{
+    int32_t index = valueIndex(val);
+    return (index >= 0) && test(liveIn[bb->getIndex()], index);
+}
+
+/// @brief 值在基本块出口处是否活跃
+/// @param bb 基本块
+/// @param val 局部变量或有值的指令
+/// @return true 活跃 false 不活跃
+bool Liveness::isLiveOut(const BasicBlock * bb, Value * val) const
+{
+    int32_t index = valueIndex(val);
+    return (index >= 0) && test(liveOut[bb->getIndex()], index);
+}
+
+/// @brief 获取基本块出口处活跃的值
+/// @param bb 基本块
+/// @return std::vector<Value *> 活跃的值
+std::vector<Value *> Liveness::getLiveOut(const BasicBlock * bb) const
+{
+    std::vector<Value *> result;
+
+    const BitVector & out = liveOut[bb->getIndex()];
+    for (int32_t index = 0; index < (int32_t) values.size(); ++index) {
+        if (test(out, index)) {
+            result.push_back(values[index]);
+        }
+    }
+
+    return result;
+}
+
+/// @brief 获取值的编号
+/// @param val 值
+/// @return int32_t 编号，不是分析对象时为-1
+int32_t Liveness::valueIndex(Value * val) const
+{
+    auto iter = indexMap.find(val);
+    return (iter == indexMap.end()) ? -1 : iter->second;
+}
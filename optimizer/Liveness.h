@@ -0,0 +1,113 @@
+///
+/// @file Liveness.h
+/// @brief 活跃变量分析，求出每个基本块入口与出口处活跃的局部变量与临时变量
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class BasicBlock;
+class Function;
+class Value;
+
+///
+/// @brief 活跃变量分析。分析的对象是局部变量与有值的指令，集合用位向量表示，按基本块编号存放。
+/// phi指令的操作数看作在对应前驱块的出口处被使用。要求函数的控制流图已经建立
+///
+class Liveness {
+
+public:
+    ///
+    /// @brief 对函数进行活跃变量分析，逆向迭代直到不动点
+    /// @param func 函数
+    ///
+    void compute(Function * func);
+
+    ///
+    /// @brief 值在基本块入口处是否活跃
+    /// @param bb 基本块
+    /// @param val 局部变量或有值的指令
+    /// @return true 活跃 false 不活跃
+    ///
+    [[nodiscard]] bool isLiveIn(const BasicBlock * bb, Value * val) const;
+
+    ///
+    /// @brief 值在基本块出口处是否活跃
+    /// @param bb 基本块
+    /// @param val 局部变量或有值的指令
+    /// @return true 活跃 false 不活跃
+    ///
+    [[nodiscard]] bool isLiveOut(const BasicBlock * bb, Value * val) const;
+
+    ///
+    /// @brief 获取基本块出口处活跃的值
+    /// @param bb 基本块
+    /// @return std::vector<Value *> 活跃的值
+    ///
+    [[nodiscard]] std::vector<Value *> getLiveOut(const BasicBlock * bb) const;
+
+private:
+    /// @brief 位向量
+    using BitVector = std::vector<uint64_t>;
+
+    ///
+    /// @brief 获取值的编号
+    /// @param val 值
+    /// @return int32_t 编号，不是分析对象时为-1
+    ///
+    int32_t valueIndex(Value * val) const;
+
+    ///
+    /// @brief 位向量中的某一位是否置位
+    /// @param bits 位向量
+    /// @param index 位的编号
+    /// @return true 置位 false 没有置位
+    ///
+    static bool test(const BitVector & bits, int32_t index)
+    {
+        return (bits[index / 64] >> (index % 64)) & 1;
+    }
+
+    ///
+    /// @brief 置位位向量中的某一位
+    /// @param bits 位向量
+    /// @param index 位的编号
+    ///
+    static void set(BitVector & bits, int32_t index)
+    {
+        bits[index / 64] |= (uint64_t) 1 << (index % 64);
+    }
+
+    ///
+    /// @brief 分析对象到其编号的映射
+    ///
+    std::unordered_map<Value *, int32_t> indexMap;
+
+    ///
+    /// @brief 按编号排列的分析对象
+    ///
+    std::vector<Value *> values;
+
+    ///
+    /// @brief 各基本块入口处的活跃集合
+    ///
+    std::vector<BitVector> liveIn;
+
+    ///
+    /// @brief 各基本块出口处的活跃集合
+    ///
+    std::vector<BitVector> liveOut;
+};
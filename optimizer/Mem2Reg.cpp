@@ -0,0 +1,295 @@
+///
+/// @file Mem2Reg.cpp
+/// @brief 把函数内的标量局部变量提升为SSA值，构造SSA形式
+/// @author zenglj (zenglj@live.com)
+/// @version 1.2
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>从全局变量等拷贝时保存到新的临时变量中，不直接转发可能改变的值
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>按活跃变量分析剪枝，变量在支配边界入口处不活跃时不插入phi
+/// </table>
+///
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#include "Mem2Reg.h"
+#include "Casting.h"
+#include "ConstInt.h"
+#include "Function.h"
+#include "Liveness.h"
+#include "Module.h"
+#include "MoveInstruction.h"
+#include "PhiInstruction.h"
+
+/// @brief 构造函数
+/// @param _module 符号表
+/// @param _func 要处理的函数
+/// @param _liveness 函数的活跃变量分析结果
+Mem2Reg::Mem2Reg(Module * _module, Function * _func, const Liveness & _liveness)
+    : module(_module), func(_func), liveness(_liveness)
+{}
+
+/// @brief 执行变量提升
+/// @return int32_t 提升的变量个数
+int32_t Mem2Reg::run()
+{
+    if (func->getCFG().empty()) {
+        return 0;
+    }
+
+    // MiniC的变量都是标量，没有取地址运算，整型的局部变量都可以提升
+    for (LocalVariable * var: func->getVarValues()) {
+        if (var->getType()->isIntegerType()) {
+            varIndexMap.emplace(var, (int32_t) vars.size());
+            vars.push_back(var);
+        }
+    }
+
+    if (vars.empty()) {
+        return 0;
+    }
+
+    valueStacks.resize(vars.size());
+
+    insertPhis();
+
+    rename();
+
+    removeDeadPhis();
+
+    // 变量的读写都已经替换掉，从函数中删除变量，后端不再为其分配栈空间
+    auto & varValues = func->getVarValues();
+    varValues.erase(std::remove_if(varValues.begin(),
+                                   varValues.end(),
+                                   [this](LocalVariable * var) { return varIndex(var) >= 0; }),
+                    varValues.end());
+
+    for (LocalVariable * var: vars) {
+        assert(!var->hasUses() && "promoted variable is still used");
+        if (var == func->getReturnValue()) {
+            func->setReturnValue(nullptr);
+        }
+        delete var;
+    }
+
+    return (int32_t) vars.size();
+}
+
+/// @brief 对每个变量，在其定值块的迭代支配边界上插入phi指令
+void Mem2Reg::insertPhis()
+{
+    ControlFlowGraph & cfg = func->getCFG();
+
+    // 各变量的定值块，即含有对变量赋值的块
+    std::vector<std::vector<BasicBlock *>> defBlocks(vars.size());
+    for (BasicBlock * bb: cfg.getReversePostOrder()) {
+        for (Instruction * inst: *bb) {
+            if (auto * move = dyn_cast<MoveInstruction>(inst)) {
+                int32_t index = varIndex(move->getOperand(0));
+                if ((index >= 0) && (defBlocks[index].empty() || (defBlocks[index].back() != bb))) {
+                    defBlocks[index].push_back(bb);
+                }
+            }
+        }
+    }
+
+    // 按块编号记录已插入phi的变量与已加入工作表的变量，避免每个变量都要清零
+    size_t blockNum = cfg.getBlocks().size();
+    std::vector<int32_t> phiPlaced(blockNum, -1);
+    std::vector<int32_t> enqueued(blockNum, -1);
+
+    for (int32_t index = 0; index < (int32_t) vars.size(); ++index) {
+
+        std::vector<BasicBlock *> worklist = defBlocks[index];
+        for (BasicBlock * bb: worklist) {
+            enqueued[bb->getIndex()] = index;
+        }
+
+        while (!worklist.empty()) {
+            BasicBlock * bb = worklist.back();
+            worklist.pop_back();
+
+            for (BasicBlock * frontier: bb->getDomFrontier()) {
+                if (phiPlaced[frontier->getIndex()] == index) {
+                    continue;
+                }
+                phiPlaced[frontier->getIndex()] = index;
+
+                // 变量在入口处不活跃时，汇合的值不会被读取，不插入phi，也不是新的定值
+                if (!liveness.isLiveIn(frontier, vars[index])) {
+                    continue;
+                }
+
+                // 支配边界是汇合点，必以Label指令开头，phi放在Label指令之后
+                auto * phi = new (func->getArena()) PhiInstruction(func, vars[index]->getType());
+                frontier->insertAfter(frontier->getFirstInst(), phi);
+                phiVarMap.emplace(phi, index);
+                phis.push_back(phi);
+
+                // phi也是变量的定值
+                if (enqueued[frontier->getIndex()] != index) {
+                    enqueued[frontier->getIndex()] = index;
+                    worklist.push_back(frontier);
+                }
+            }
+        }
+    }
+}
+
+/// @brief 沿支配树先序遍历，用各变量当前的值替换读变量处，删除赋值指令并填写phi的来源
+void Mem2Reg::rename()
+{
+    ControlFlowGraph & cfg = func->getCFG();
+
+    // 处理一个块，返回时pushed中为块内压入值栈的变量编号，离开块时弹出
+    auto renameBlock = [this](BasicBlock * bb, std::vector<int32_t> & pushed) {
+        Instruction * end = bb->getLastInst()->getNextInst();
+
+        for (Instruction * inst = bb->getFirstInst(); inst != end;) {
+
+            if (auto * phi = dyn_cast<PhiInstruction>(inst)) {
+                auto iter = phiVarMap.find(phi);
+                if (iter != phiVarMap.end()) {
+                    valueStacks[iter->second].push_back(phi);
+                    pushed.push_back(iter->second);
+                }
+                inst = inst->getNextInst();
+                continue;
+            }
+
+            // 赋值指令的第一个操作数是被赋值的变量，不是读
+            auto * move = dyn_cast<MoveInstruction>(inst);
+            int32_t operandsNum = inst->getOperandsNum();
+            for (int32_t k = move ? 1 : 0; k < operandsNum; ++k) {
+                int32_t index = varIndex(inst->getOperand(k));
+                if (index >= 0) {
+                    inst->setOperand(k, currentValue(index));
+                }
+            }
+
+            int32_t index = move ? varIndex(move->getOperand(0)) : -1;
+            if (index < 0) {
+                inst = inst->getNextInst();
+                continue;
+            }
+
+            Value * src = move->getOperand(1);
+            if (isa<Instruction>(src) || isa<ConstInt>(src) || copyVars.count(src)) {
+                // 源操作数的值不会再改变，变量的值变为源操作数，赋值指令删除
+                valueStacks[index].push_back(src);
+                inst = bb->erase(inst);
+            } else {
+                // 全局变量等在函数调用或赋值后值会改变，赋值时的值保存到只赋值一次的新变量中
+                LocalVariable * copy = func->newLocalVarValue(src->getType());
+                move->setOperand(0, copy);
+                copyVars.insert(copy);
+                valueStacks[index].push_back(copy);
+                inst = inst->getNextInst();
+            }
+            pushed.push_back(index);
+        }
+
+        // 填写后继块中phi从本块来的值
+        for (BasicBlock * succ: bb->getSuccessors()) {
+            for (Instruction * inst = succ->getFirstInst()->getNextInst(); inst && isa<PhiInstruction>(inst);
+                 inst = inst->getNextInst()) {
+                auto * phi = cast<PhiInstruction>(inst);
+                auto iter = phiVarMap.find(phi);
+                if (iter != phiVarMap.end()) {
+                    phi->addIncoming(currentValue(iter->second), bb);
+                }
+            }
+        }
+    };
+
+    auto popValues = [this](const std::vector<int32_t> & pushed) {
+        for (int32_t index: pushed) {
+            valueStacks[index].pop_back();
+        }
+    };
+
+    // 显式栈遍历支配树，栈元素为块与下一个要访问的孩子的下标
+    std::vector<std::pair<BasicBlock *, size_t>> stack;
+    std::vector<std::vector<int32_t>> pushedStack;
+
+    BasicBlock * entry = cfg.getEntry();
+    pushedStack.emplace_back();
+    renameBlock(entry, pushedStack.back());
+    stack.emplace_back(entry, 0);
+
+    while (!stack.empty()) {
+        auto & [bb, next] = stack.back();
+        const auto & children = bb->getDomChildren();
+
+        if (next < children.size()) {
+            BasicBlock * child = children[next++];
+            pushedStack.emplace_back();
+            renameBlock(child, pushedStack.back());
+            stack.emplace_back(child, 0);
+        } else {
+            popValues(pushedStack.back());
+            pushedStack.pop_back();
+            stack.pop_back();
+        }
+    }
+
+    // 不可达而保留的出口块，没有到达的定值，变量按未赋值处理
+    for (BasicBlock * bb: cfg.getBlocks()) {
+        if (bb->getRPOIndex() < 0) {
+            std::vector<int32_t> pushed;
+            renameBlock(bb, pushed);
+            popValues(pushed);
+        }
+    }
+}
+
+/// @brief 删除没有使用者的phi指令，删除后可能使别的phi也没有使用者
+void Mem2Reg::removeDeadPhis()
+{
+    std::vector<PhiInstruction *> worklist = phis;
+
+    while (!worklist.empty()) {
+        PhiInstruction * phi = worklist.back();
+        worklist.pop_back();
+
+        // 已删除的phi不在映射表中
+        if ((phiVarMap.find(phi) == phiVarMap.end()) || phi->hasUses()) {
+            continue;
+        }
+
+        for (int32_t k = 0; k < phi->getIncomingNum(); ++k) {
+            if (auto * operand = dyn_cast<PhiInstruction>(phi->getIncomingValue(k))) {
+                worklist.push_back(operand);
+            }
+        }
+
+        phiVarMap.erase(phi);
+        phi->clearOperands();
+        phi->getBasicBlock()->erase(phi);
+    }
+}
+
+/// @brief 获取变量的编号
+/// @param val 值
+/// @return int32_t 是要提升的变量时为其编号，否则为-1
+int32_t Mem2Reg::varIndex(Value * val) const
+{
+    auto iter = varIndexMap.find(val);
+    return (iter == varIndexMap.end()) ? -1 : iter->second;
+}
+
+/// @brief 获取变量当前的值，没有赋值时为常量0
+/// @param index 变量编号
+/// @return Value* 当前的值
+Value * Mem2Reg::currentValue(int32_t index)
+{
+    auto & values = valueStacks[index];
+    return values.empty() ? module->newConstInt(0) : values.back();
+}
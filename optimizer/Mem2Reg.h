@@ -0,0 +1,133 @@
+///
+/// @file Mem2Reg.h
+/// @brief 把函数内的标量局部变量提升为SSA值，构造SSA形式
+/// @author zenglj (zenglj@live.com)
+/// @version 1.2
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>从全局变量等拷贝时保存到新的临时变量中，不直接转发可能改变的值
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>按活跃变量分析剪枝，变量在支配边界入口处不活跃时不插入phi
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class BasicBlock;
+class Function;
+class Instruction;
+class LocalVariable;
+class Liveness;
+class Module;
+class PhiInstruction;
+class Value;
+
+///
+/// @brief 局部变量提升。局部变量（含形参拷贝到的局部变量与函数返回值变量）在后端都分配栈空间，
+/// 每次读写都要访存。提升后对变量的赋值指令被删除，读变量处直接使用最近一次赋的值，
+/// 在多个定值汇合的支配边界处插入phi指令，变量本身从函数中删除，不再分配栈空间。
+/// 赋值的源操作数是全局变量等可能被函数调用或赋值改变的值时，保留赋值，改为赋值给只赋值一次的新变量。
+/// phi只插入在变量活跃的支配边界上（剪枝的SSA），不活跃处的phi不会被使用。
+/// 要求函数的控制流图、支配信息与活跃变量分析结果已经建立
+///
+class Mem2Reg {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表，未赋值就读的变量用常量0代替
+    /// @param _func 要处理的函数
+    /// @param _liveness 函数的活跃变量分析结果，用于剪枝phi
+    ///
+    Mem2Reg(Module * _module, Function * _func, const Liveness & _liveness);
+
+    ///
+    /// @brief 执行变量提升
+    /// @return int32_t 提升的变量个数
+    ///
+    int32_t run();
+
+private:
+    ///
+    /// @brief 对每个变量，在其定值块的迭代支配边界上插入phi指令
+    ///
+    void insertPhis();
+
+    ///
+    /// @brief 沿支配树先序遍历，用各变量当前的值替换读变量处，删除赋值指令并填写phi的来源
+    ///
+    void rename();
+
+    ///
+    /// @brief 删除没有使用者的phi指令，删除后可能使别的phi也没有使用者
+    ///
+    void removeDeadPhis();
+
+    ///
+    /// @brief 获取变量的编号
+    /// @param val 值
+    /// @return int32_t 是要提升的变量时为其编号，否则为-1
+    ///
+    int32_t varIndex(Value * val) const;
+
+    ///
+    /// @brief 获取变量当前的值，没有赋值时为常量0
+    /// @param index 变量编号
+    /// @return Value* 当前的值
+    ///
+    Value * currentValue(int32_t index);
+
+    ///
+    /// @brief 符号表
+    ///
+    Module * module;
+
+    ///
+    /// @brief 要处理的函数
+    ///
+    Function * func;
+
+    ///
+    /// @brief 函数的活跃变量分析结果
+    ///
+    const Liveness & liveness;
+
+    ///
+    /// @brief 要提升的变量
+    ///
+    std::vector<LocalVariable *> vars;
+
+    ///
+    /// @brief 变量到其编号的映射
+    ///
+    std::unordered_map<Value *, int32_t> varIndexMap;
+
+    ///
+    /// @brief 插入的phi指令到其变量编号的映射
+    ///
+    std::unordered_map<PhiInstruction *, int32_t> phiVarMap;
+
+    ///
+    /// @brief 遍历支配树时每个变量的值栈，栈顶为当前的值
+    ///
+    std::vector<std::vector<Value *>> valueStacks;
+
+    ///
+    /// @brief 插入的phi指令
+    ///
+    std::vector<PhiInstruction *> phis;
+
+    ///
+    /// @brief 保存全局变量等的值的新变量，只赋值一次，可以直接代替被提升的变量
+    ///
+    std::unordered_set<Value *> copyVars;
+};
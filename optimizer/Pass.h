@@ -0,0 +1,75 @@
+///
+/// @file Pass.h
+/// @brief 优化遍的基类，分为以函数为单位的遍与以整个模块为单位的遍
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+class AnalysisManager;
+class Function;
+class Module;
+
+///
+/// @brief 函数级的遍，逐个对函数执行，流式编译时也可执行
+///
+class FunctionPass {
+
+public:
+    virtual ~FunctionPass() = default;
+
+    ///
+    /// @brief 遍的名字，用于--time-passes的统计输出
+    /// @return const char* 名字
+    ///
+    [[nodiscard]] virtual const char * getName() const = 0;
+
+    ///
+    /// @brief 对函数执行本遍，需要的分析结果从分析管理器中获取
+    /// @param func 函数
+    /// @param am 分析管理器
+    /// @return true 修改了IR false 没有修改
+    ///
+    virtual bool run(Function * func, AnalysisManager & am) = 0;
+
+    ///
+    /// @brief 修改IR时是否保持控制流图（含支配信息）不变，保持时修改后不必重建
+    /// @return true 保持 false 不保持
+    ///
+    [[nodiscard]] virtual bool preservesCFG() const
+    {
+        return false;
+    }
+};
+
+///
+/// @brief 模块级的遍，需要看到所有函数，流式编译时不执行
+///
+class ModulePass {
+
+public:
+    virtual ~ModulePass() = default;
+
+    ///
+    /// @brief 遍的名字，用于--time-passes的统计输出
+    /// @return const char* 名字
+    ///
+    [[nodiscard]] virtual const char * getName() const = 0;
+
+    ///
+    /// @brief 对整个模块执行本遍，修改了哪个函数需通过分析管理器使该函数的分析结果失效
+    /// @param module 模块
+    /// @param am 分析管理器
+    /// @return true 修改了IR false 没有修改
+    ///
+    virtual bool run(Module * module, AnalysisManager & am) = 0;
+};
@@ -0,0 +1,213 @@
+///
+/// @file PassManager.cpp
+/// @brief 遍管理器，按优化级别组织遍的执行次序，管理分析结果的失效，统计各遍的耗时
+/// @author zenglj (zenglj@live.com)
+/// @version 1.4
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>-O2增加稀疏条件常量传播
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>增加死代码删除
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>增加局部与全局值编号
+/// <tr><td>2026-10-15 <td>1.4     <td>zenglj  <td>增加删除不可达函数的模块级遍
+/// </table>
+///
+#include <chrono>
+
+#include "PassManager.h"
+#include "Module.h"
+#include "Passes.h"
+
+/// @brief 构造函数
+/// @param module 模块
+/// @param _timePasses 是否统计各遍的耗时
+PassManager::PassManager(Module * module, bool _timePasses) : am(module), timePasses(_timePasses)
+{
+    am.setTimePasses(timePasses);
+}
+
+/// @brief 析构函数，释放所有的遍
+PassManager::~PassManager()
+{
+    for (auto * entries: {&passes, &loweringPasses}) {
+        for (PassEntry & entry: *entries) {
+            delete entry.functionPass;
+            delete entry.modulePass;
+        }
+    }
+}
+
+/// @brief 按优化级别加入遍
+/// @param optLevel 优化级别
+void PassManager::buildPipeline(int optLevel)
+{
+    if (optLevel <= 0) {
+        return;
+    }
+
+    // -O1：先删除main不调用的函数，后续的遍不必处理它们
+    addModulePass(new GlobalDCEPass());
+
+    // -O1：删除不可达的基本块后再构造SSA，不可达的块中的赋值不会产生多余的phi
+    addFunctionPass(new SimplifyCFGPass());
+    addFunctionPass(new Mem2RegPass());
+
+    if (optLevel >= 2) {
+        // -O2：在SSA形式上折叠常量，常量折叠后相同的表达式更多，再沿支配树删除公共子表达式
+        addFunctionPass(new SCCPPass());
+        addFunctionPass(new GVNPass());
+    } else {
+        // -O1：只删除块内的公共子表达式
+        addFunctionPass(new LVNPass());
+    }
+
+    // 删除变量提升后没有使用的临时值与常量折叠后留下的指令
+    addFunctionPass(new DCEPass());
+
+    // 后端不能处理phi指令，进入后端前消除
+    addLoweringPass(new PhiEliminationPass());
+}
+
+/// @brief 在优化阶段的末尾加入函数级的遍
+/// @param pass 遍
+void PassManager::addFunctionPass(FunctionPass * pass)
+{
+    passes.emplace_back();
+    passes.back().functionPass = pass;
+}
+
+/// @brief 在优化阶段的末尾加入模块级的遍
+/// @param pass 遍
+void PassManager::addModulePass(ModulePass * pass)
+{
+    passes.emplace_back();
+    passes.back().modulePass = pass;
+}
+
+/// @brief 在降级阶段的末尾加入函数级的遍
+/// @param pass 遍
+void PassManager::addLoweringPass(FunctionPass * pass)
+{
+    loweringPasses.emplace_back();
+    loweringPasses.back().functionPass = pass;
+}
+
+/// @brief 对模块中所有的函数执行优化阶段的遍
+/// @param module 模块
+void PassManager::optimize(Module * module)
+{
+    runPasses(passes, module);
+}
+
+/// @brief 对一个函数执行优化阶段中函数级的遍
+/// @param func 函数
+void PassManager::optimize(Function * func)
+{
+    for (PassEntry & entry: passes) {
+        if (entry.functionPass) {
+            runPass(entry, func);
+        }
+    }
+}
+
+/// @brief 对模块中所有的函数执行降级阶段的遍
+/// @param module 模块
+void PassManager::lower(Module * module)
+{
+    runPasses(loweringPasses, module);
+}
+
+/// @brief 对一个函数执行降级阶段的遍
+/// @param func 函数
+void PassManager::lower(Function * func)
+{
+    for (PassEntry & entry: loweringPasses) {
+        runPass(entry, func);
+    }
+}
+
+/// @brief 对模块中的所有函数执行一组遍，一个函数级的遍对所有函数执行后再执行下一个遍
+/// @param entries 遍
+/// @param module 模块
+void PassManager::runPasses(std::vector<PassEntry> & entries, Module * module)
+{
+    for (PassEntry & entry: entries) {
+
+        if (entry.functionPass) {
+            for (Function * func: module->getFunctionList()) {
+                if (!func->isBuiltin()) {
+                    runPass(entry, func);
+                }
+            }
+            continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        double analysisStart = am.getTotalSeconds();
+
+        if (entry.modulePass->run(module, am)) {
+            entry.changes++;
+        }
+
+        entry.runs++;
+        if (timePasses) {
+            // 遍内按需计算的分析单独统计，不计入遍的耗时
+            entry.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() -
+                             (am.getTotalSeconds() - analysisStart);
+        }
+    }
+}
+
+/// @brief 对一个函数执行一个函数级的遍，修改了IR时使分析结果失效
+/// @param entry 遍
+/// @param func 函数
+void PassManager::runPass(PassEntry & entry, Function * func)
+{
+    auto start = std::chrono::steady_clock::now();
+    double analysisStart = am.getTotalSeconds();
+
+    if (entry.functionPass->run(func, am)) {
+        entry.changes++;
+        am.invalidate(func, entry.functionPass->preservesCFG());
+    }
+
+    entry.runs++;
+    if (timePasses) {
+        // 遍内按需计算的分析单独统计，不计入遍的耗时
+        entry.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() -
+                         (am.getTotalSeconds() - analysisStart);
+    }
+}
+
+/// @brief 输出各遍与各分析的耗时统计
+/// @param fp 输出文件
+void PassManager::printTimings(FILE * fp) const
+{
+    double total = am.getTotalSeconds();
+    for (auto * entries: {&passes, &loweringPasses}) {
+        for (const PassEntry & entry: *entries) {
+            total += entry.seconds;
+        }
+    }
+
+    fprintf(fp, "===-------------------------------------------------------------------------===\n");
+    fprintf(fp, "                      ... Pass execution timing report ...\n");
+    fprintf(fp, "===-------------------------------------------------------------------------===\n");
+    fprintf(fp, "  Total Execution Time: %.6f seconds\n\n", total);
+    fprintf(fp, "  %10s (%5s%%)  %8s  %8s  %s\n", "Time", "", "Runs", "Changed", "Name");
+
+    for (auto * entries: {&passes, &loweringPasses}) {
+        for (const PassEntry & entry: *entries) {
+            const char * name = entry.functionPass ? entry.functionPass->getName() : entry.modulePass->getName();
+            double percent = (total > 0) ? entry.seconds * 100 / total : 0;
+            fprintf(fp, "  %10.6f (%5.1f%%)  %8d  %8d  %s\n", entry.seconds, percent, entry.runs, entry.changes, name);
+        }
+    }
+
+    am.printTimings(fp, total);
+}
@@ -0,0 +1,170 @@
+///
+/// @file PassManager.h
+/// @brief 遍管理器，按优化级别组织遍的执行次序，管理分析结果的失效，统计各遍的耗时
+/// @author zenglj (zenglj@live.com)
+/// @version 1.4
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>-O2增加稀疏条件常量传播
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>增加死代码删除
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>增加局部与全局值编号
+/// <tr><td>2026-10-15 <td>1.4     <td>zenglj  <td>增加删除不可达函数的模块级遍
+/// </table>
+///
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+#include "AnalysisManager.h"
+#include "Pass.h"
+
+///
+/// @brief 遍管理器。遍分为两个阶段：优化阶段在线性IR产生后执行，其结果可用-I输出；
+/// 降级阶段在进入后端前执行，把后端不能处理的形式（如phi指令）转换掉。
+/// 每个遍执行后若修改了IR，则使相应函数的分析结果失效
+///
+class PassManager {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param module 模块
+    /// @param _timePasses 是否统计各遍的耗时
+    ///
+    PassManager(Module * module, bool _timePasses = false);
+
+    ///
+    /// @brief 析构函数，释放所有的遍
+    ///
+    ~PassManager();
+
+    PassManager(const PassManager &) = delete;
+    PassManager & operator=(const PassManager &) = delete;
+
+    ///
+    /// @brief 按优化级别加入遍。
+    /// -O0不做任何优化；-O1删除main不调用的函数与不可达的基本块，提升局部变量为SSA值，局部值编号，删除死代码；
+    /// -O2在此基础上做稀疏条件常量传播，并以全局值编号代替局部值编号
+    /// @param optLevel 优化级别
+    ///
+    void buildPipeline(int optLevel);
+
+    ///
+    /// @brief 在优化阶段的末尾加入函数级的遍
+    /// @param pass 遍，由遍管理器释放
+    ///
+    void addFunctionPass(FunctionPass * pass);
+
+    ///
+    /// @brief 在优化阶段的末尾加入模块级的遍
+    /// @param pass 遍，由遍管理器释放
+    ///
+    void addModulePass(ModulePass * pass);
+
+    ///
+    /// @brief 在降级阶段的末尾加入函数级的遍
+    /// @param pass 遍，由遍管理器释放
+    ///
+    void addLoweringPass(FunctionPass * pass);
+
+    ///
+    /// @brief 对模块中所有的函数执行优化阶段的遍，函数级的遍逐个函数执行
+    /// @param module 模块
+    ///
+    void optimize(Module * module);
+
+    ///
+    /// @brief 对一个函数执行优化阶段中函数级的遍，用于流式编译，模块级的遍不执行
+    /// @param func 函数
+    ///
+    void optimize(Function * func);
+
+    ///
+    /// @brief 对模块中所有的函数执行降级阶段的遍
+    /// @param module 模块
+    ///
+    void lower(Module * module);
+
+    ///
+    /// @brief 对一个函数执行降级阶段的遍，用于流式编译
+    /// @param func 函数
+    ///
+    void lower(Function * func);
+
+    ///
+    /// @brief 函数的IR释放后删除其分析结果，用于流式编译
+    /// @param func 函数
+    ///
+    void releaseFunction(Function * func)
+    {
+        am.erase(func);
+    }
+
+    ///
+    /// @brief 输出各遍与各分析的耗时统计
+    /// @param fp 输出文件
+    ///
+    void printTimings(FILE * fp) const;
+
+private:
+    ///
+    /// @brief 一个遍及其耗时统计，函数级与模块级的遍只有一个非空
+    ///
+    struct PassEntry {
+        /// @brief 函数级的遍
+        FunctionPass * functionPass = nullptr;
+
+        /// @brief 模块级的遍
+        ModulePass * modulePass = nullptr;
+
+        /// @brief 累计耗时，秒
+        double seconds = 0;
+
+        /// @brief 执行的次数
+        int runs = 0;
+
+        /// @brief 修改了IR的次数
+        int changes = 0;
+    };
+
+    ///
+    /// @brief 对一个函数执行一个函数级的遍，修改了IR时使分析结果失效
+    /// @param entry 遍
+    /// @param func 函数
+    ///
+    void runPass(PassEntry & entry, Function * func);
+
+    ///
+    /// @brief 对模块中的所有函数执行一组遍
+    /// @param entries 遍
+    /// @param module 模块
+    ///
+    void runPasses(std::vector<PassEntry> & entries, Module * module);
+
+    ///
+    /// @brief 分析管理器
+    ///
+    AnalysisManager am;
+
+    ///
+    /// @brief 是否统计耗时
+    ///
+    bool timePasses;
+
+    ///
+    /// @brief 优化阶段的遍
+    ///
+    std::vector<PassEntry> passes;
+
+    ///
+    /// @brief 降级阶段的遍
+    ///
+    std::vector<PassEntry> loweringPasses;
+};
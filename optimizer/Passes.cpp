@@ -0,0 +1,159 @@
+///
+/// @file Passes.cpp
+/// @brief 遍管理器中可用的各个遍，把各优化的实现包装成遍
+/// @author zenglj (zenglj@live.com)
+/// @version 1.7
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>增加稀疏条件常量传播遍
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>增加死代码删除遍
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>增加局部与全局值编号遍
+/// <tr><td>2026-10-15 <td>1.4     <td>zenglj  <td>变量提升使用活跃变量分析结果剪枝phi
+/// <tr><td>2026-10-15 <td>1.5     <td>zenglj  <td>增加删除不可达函数的模块级遍
+/// <tr><td>2026-10-15 <td>1.6     <td>zenglj  <td>稀疏条件常量传播使用活跃变量分析结果
+/// <tr><td>2026-10-15 <td>1.7     <td>zenglj  <td>删除不可达函数前先释放其函数体
+/// </table>
+///
+#include <unordered_set>
+#include <vector>
+
+#include "Passes.h"
+#include "AnalysisManager.h"
+#include "Casting.h"
+#include "DeadCodeElimination.h"
+#include "FuncCallInstruction.h"
+#include "Function.h"
+#include "Mem2Reg.h"
+#include "Module.h"
+#include "PhiElimination.h"
+#include "SCCP.h"
+#include "ValueNumbering.h"
+
+/// @brief 删除从main函数出发经函数调用不可达的函数
+/// @param module 模块
+/// @param am 分析管理器
+/// @return true 删除了函数 false 没有
+bool GlobalDCEPass::run(Module * module, AnalysisManager & am)
+{
+    Function * mainFunc = module->findFunction("main");
+    if (!mainFunc) {
+        return false;
+    }
+
+    // 从main出发沿函数调用标记可达的函数
+    std::unordered_set<Function *> reached{mainFunc};
+    std::vector<Function *> worklist{mainFunc};
+    while (!worklist.empty()) {
+        Function * func = worklist.back();
+        worklist.pop_back();
+
+        for (Instruction * inst: func->getInterCode()) {
+            if (auto * call = dyn_cast<FuncCallInstruction>(inst)) {
+                if (reached.insert(call->getCalledFunction()).second) {
+                    worklist.push_back(call->getCalledFunction());
+                }
+            }
+        }
+    }
+
+    // 不可达的函数只可能被不可达的函数调用，一起删除。内置函数不产生代码，保留
+    std::vector<Function *> deadFuncs;
+    for (Function * func: module->getFunctionList()) {
+        if (!func->isBuiltin() && !reached.count(func)) {
+            deadFuncs.push_back(func);
+        }
+    }
+
+    // 不可达的函数之间可以互相调用，先全部释放函数体解除调用，再删除函数
+    for (Function * func: deadFuncs) {
+        am.erase(func);
+        func->Delete();
+    }
+
+    for (Function * func: deadFuncs) {
+        module->removeFunction(func);
+    }
+
+    return !deadFuncs.empty();
+}
+
+/// @brief 删除从入口不可达的基本块
+/// @param func 函数
+/// @param am 分析管理器
+/// @return true 删除了基本块 false 没有
+bool SimplifyCFGPass::run(Function * func, AnalysisManager & am)
+{
+    return am.getCFG(func).removeUnreachableBlocks() > 0;
+}
+
+/// @brief 把标量局部变量提升为SSA值，需要支配边界与活跃变量分析结果
+/// @param func 函数
+/// @param am 分析管理器
+/// @return true 提升了变量 false 没有
+bool Mem2RegPass::run(Function * func, AnalysisManager & am)
+{
+    am.getDominators(func);
+
+    return Mem2Reg(am.getModule(), func, am.getLiveness(func)).run() > 0;
+}
+
+/// @brief 稀疏条件常量传播，要求已经是SSA形式
+/// @param func 函数
+/// @param am 分析管理器
+/// @return true 折叠了指令 false 没有
+bool SCCPPass::run(Function * func, AnalysisManager & am)
+{
+    am.getCFG(func);
+
+    return SCCP(am.getModule(), func, am.getLiveness(func)).run() > 0;
+}
+
+/// @brief 局部值编号
+/// @param func 函数
+/// @param am 分析管理器
+/// @return true 删除了冗余的指令 false 没有
+bool LVNPass::run(Function * func, AnalysisManager & am)
+{
+    am.getCFG(func);
+
+    return ValueNumbering(func, false).run() > 0;
+}
+
+/// @brief 全局值编号，需要支配树
+/// @param func 函数
+/// @param am 分析管理器
+/// @return true 删除了冗余的指令 false 没有
+bool GVNPass::run(Function * func, AnalysisManager & am)
+{
+    am.getDominators(func);
+
+    return ValueNumbering(func, true).run() > 0;
+}
+
+/// @brief 死代码删除，会删除不可达的基本块
+/// @param func 函数
+/// @param am 分析管理器
+/// @return true 删除了块、指令或变量 false 没有
+bool DCEPass::run(Function * func, AnalysisManager & am)
+{
+    am.getCFG(func);
+
+    return DeadCodeElimination(func).run() > 0;
+}
+
+/// @brief 消除phi指令
+/// @param func 函数
+/// @param am 分析管理器
+/// @return true 消除了phi指令 false 没有
+bool PhiEliminationPass::run(Function * func, AnalysisManager & am)
+{
+    am.getCFG(func);
+
+    return PhiElimination(func).run() > 0;
+}
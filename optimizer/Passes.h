@@ -0,0 +1,165 @@
+///
+/// @file Passes.h
+/// @brief 遍管理器中可用的各个遍，把各优化的实现包装成遍
+/// @author zenglj (zenglj@live.com)
+/// @version 1.4
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>增加稀疏条件常量传播遍
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>增加死代码删除遍
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>增加局部与全局值编号遍
+/// <tr><td>2026-10-15 <td>1.4     <td>zenglj  <td>增加删除不可达函数的模块级遍
+/// </table>
+///
+#pragma once
+
+#include "Pass.h"
+
+///
+/// @brief 删除从main函数出发经函数调用不可达的函数。MiniC没有函数声明，一个源文件就是整个程序，
+/// 其中的函数不会被其它文件调用。没有main函数时不做处理。模块级的遍，流式编译时不执行
+///
+class GlobalDCEPass final : public ModulePass {
+
+public:
+    [[nodiscard]] const char * getName() const override
+    {
+        return "globaldce";
+    }
+
+    bool run(Module * module, AnalysisManager & am) override;
+};
+
+///
+/// @brief 删除从入口不可达的基本块，如return之后的语句
+///
+class SimplifyCFGPass final : public FunctionPass {
+
+public:
+    [[nodiscard]] const char * getName() const override
+    {
+        return "simplifycfg";
+    }
+
+    bool run(Function * func, AnalysisManager & am) override;
+};
+
+///
+/// @brief 把标量局部变量提升为SSA值，见Mem2Reg
+///
+class Mem2RegPass final : public FunctionPass {
+
+public:
+    [[nodiscard]] const char * getName() const override
+    {
+        return "mem2reg";
+    }
+
+    bool run(Function * func, AnalysisManager & am) override;
+
+    /// @brief 只插入phi、删除赋值指令，不改变控制流
+    [[nodiscard]] bool preservesCFG() const override
+    {
+        return true;
+    }
+};
+
+///
+/// @brief 稀疏条件常量传播，值为常量的指令的使用者改为使用常量，见SCCP
+///
+class SCCPPass final : public FunctionPass {
+
+public:
+    [[nodiscard]] const char * getName() const override
+    {
+        return "sccp";
+    }
+
+    bool run(Function * func, AnalysisManager & am) override;
+
+    /// @brief 只替换指令的操作数，不改变控制流
+    [[nodiscard]] bool preservesCFG() const override
+    {
+        return true;
+    }
+};
+
+///
+/// @brief 局部值编号，删除块内重复的计算，见ValueNumbering
+///
+class LVNPass final : public FunctionPass {
+
+public:
+    [[nodiscard]] const char * getName() const override
+    {
+        return "lvn";
+    }
+
+    bool run(Function * func, AnalysisManager & am) override;
+
+    /// @brief 只删除块内非首条的指令，不改变控制流
+    [[nodiscard]] bool preservesCFG() const override
+    {
+        return true;
+    }
+};
+
+///
+/// @brief 沿支配树的全局值编号，删除被支配块中重复的计算，见ValueNumbering
+///
+class GVNPass final : public FunctionPass {
+
+public:
+    [[nodiscard]] const char * getName() const override
+    {
+        return "gvn";
+    }
+
+    bool run(Function * func, AnalysisManager & am) override;
+
+    /// @brief 只删除块内非首条的指令，不改变控制流
+    [[nodiscard]] bool preservesCFG() const override
+    {
+        return true;
+    }
+};
+
+///
+/// @brief 标记-清除的死代码删除，见DeadCodeElimination
+///
+class DCEPass final : public FunctionPass {
+
+public:
+    [[nodiscard]] const char * getName() const override
+    {
+        return "dce";
+    }
+
+    bool run(Function * func, AnalysisManager & am) override;
+};
+
+///
+/// @brief 进入后端前消除phi指令，见PhiElimination
+///
+class PhiEliminationPass final : public FunctionPass {
+
+public:
+    [[nodiscard]] const char * getName() const override
+    {
+        return "phi-elim";
+    }
+
+    bool run(Function * func, AnalysisManager & am) override;
+
+    /// @brief 只在前驱块的跳转前插入赋值指令，不改变控制流
+    [[nodiscard]] bool preservesCFG() const override
+    {
+        return true;
+    }
+};
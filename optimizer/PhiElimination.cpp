@@ -0,0 +1,133 @@
+///
+/// @file PhiElimination.cpp
+/// @brief 消除phi指令，把SSA形式转回后端能够处理的线性IR
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>同一块的phi按并行拷贝排序消除，断言没有关键边
+/// </table>
+///
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "PhiElimination.h"
+#include "Casting.h"
+#include "Function.h"
+#include "MoveInstruction.h"
+#include "PhiInstruction.h"
+
+/// @brief 构造函数
+/// @param _func 要处理的函数
+PhiElimination::PhiElimination(Function * _func) : func(_func)
+{}
+
+/// @brief 执行phi消除
+/// @return int32_t 消除的phi指令个数
+int32_t PhiElimination::run()
+{
+    int32_t count = 0;
+
+    for (BasicBlock * bb: func->getCFG().getBlocks()) {
+
+        // phi指令都在块开头的Label指令之后
+        std::vector<PhiInstruction *> phis;
+        for (Instruction * inst = bb->getFirstInst()->getNextInst(); inst && isa<PhiInstruction>(inst);
+             inst = inst->getNextInst()) {
+            phis.push_back(cast<PhiInstruction>(inst));
+        }
+
+        if (phis.empty()) {
+            continue;
+        }
+
+        // 先全部换成变量，互为来源的phi的入值随之变成对方的变量
+        std::vector<LocalVariable *> vars;
+        for (PhiInstruction * phi: phis) {
+            LocalVariable * var = func->newLocalVarValue(phi->getType());
+            phi->replaceAllUsesWith(var);
+            vars.push_back(var);
+        }
+
+        for (BasicBlock * pred: bb->getPredecessors()) {
+
+            // 赋值插在来源块的末尾，来源块有其它后继时在那些边上也会执行
+            assert((pred->getSuccessors().size() == 1) && "phi elimination requires no critical edges");
+
+            std::vector<std::pair<Value *, Value *>> copies;
+            for (size_t k = 0; k < phis.size(); ++k) {
+                for (int32_t n = 0; n < phis[k]->getIncomingNum(); ++n) {
+                    Value * src = phis[k]->getIncomingValue(n);
+                    if ((phis[k]->getIncomingBlock(n) == pred) && (src != vars[k])) {
+                        copies.emplace_back(vars[k], src);
+                    }
+                }
+            }
+
+            sequentialize(pred, copies);
+        }
+
+        for (PhiInstruction * phi: phis) {
+            phi->clearOperands();
+            bb->erase(phi);
+
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/// @brief 把一组并行拷贝排成顺序的赋值，插在块的跳转指令之前。
+/// 目的变量不再被其余拷贝读取时即可赋值；剩下的都在环上，先把一个目的变量的旧值存到临时变量，
+/// 读它的拷贝改为读临时变量，环就断开了
+/// @param bb 插入赋值的块
+/// @param copies 并行拷贝，每项为目的变量与来源，目的变量互不相同，处理后清空
+void PhiElimination::sequentialize(BasicBlock * bb, std::vector<std::pair<Value *, Value *>> & copies)
+{
+    auto isRead = [&copies](Value * dst) {
+        for (auto & copy: copies) {
+            if (copy.second == dst) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto emit = [this, bb](Value * dst, Value * src) {
+        bb->insertBeforeTerminator(new (func->getArena()) MoveInstruction(func, dst, src));
+    };
+
+    while (!copies.empty()) {
+
+        bool emitted = false;
+        for (size_t k = 0; k < copies.size(); ++k) {
+            if (!isRead(copies[k].first)) {
+                emit(copies[k].first, copies[k].second);
+                copies.erase(copies.begin() + (std::ptrdiff_t) k);
+                emitted = true;
+                break;
+            }
+        }
+
+        if (!emitted) {
+            // 全部在环上，保存第一个目的变量的旧值
+            Value * dst = copies.front().first;
+            LocalVariable * tmp = func->newLocalVarValue(dst->getType());
+            emit(tmp, dst);
+
+            for (auto & copy: copies) {
+                if (copy.second == dst) {
+                    copy.second = tmp;
+                }
+            }
+        }
+    }
+}
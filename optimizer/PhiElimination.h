@@ -0,0 +1,61 @@
+///
+/// @file PhiElimination.h
+/// @brief 消除phi指令，把SSA形式转回后端能够处理的线性IR
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>同一块的phi按并行拷贝排序消除，断言没有关键边
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class BasicBlock;
+class Function;
+class Value;
+
+///
+/// @brief phi消除。每个phi指令换成一个新的局部变量，phi的使用者改为使用该变量。
+/// 一个块的全部phi在同一条入边上是同时取值的，即一组并行拷贝。同一块的phi可以互为来源（交换问题），
+/// 因此在各来源块的末尾（跳转指令之前）把这组并行拷贝排成顺序的赋值，有环时借助临时变量打破。
+/// 前提是来源块只有这一个后继，即没有关键边，否则插入的赋值在其它出边上也会执行（丢失拷贝问题）。
+/// MiniC只有无条件跳转，这一前提总是成立，这里只做断言，不拆分关键边
+///
+class PhiElimination {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _func 要处理的函数，要求其控制流图已经建立
+    ///
+    explicit PhiElimination(Function * _func);
+
+    ///
+    /// @brief 执行phi消除
+    /// @return int32_t 消除的phi指令个数
+    ///
+    int32_t run();
+
+private:
+    ///
+    /// @brief 把一组并行拷贝排成顺序的赋值，插在块的跳转指令之前
+    /// @param bb 插入赋值的块
+    /// @param copies 并行拷贝，每项为目的变量与来源，处理后清空
+    ///
+    void sequentialize(BasicBlock * bb, std::vector<std::pair<Value *, Value *>> & copies);
+
+    ///
+    /// @brief 要处理的函数
+    ///
+    Function * func;
+};
@@ -0,0 +1,321 @@
+///
+/// @file SCCP.cpp
+/// @brief 稀疏条件常量传播，计算出值为常量的指令并用常量替换其使用
+/// @author zenglj (zenglj@live.com)
+/// @version 1.2
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>已经不确定的指令的格不再回退为常量
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>常量经对局部变量的赋值传播
+/// </table>
+///
+#include <climits>
+
+#include "SCCP.h"
+#include "BinaryInstruction.h"
+#include "Casting.h"
+#include "ConstInt.h"
+#include "Function.h"
+#include "Liveness.h"
+#include "Module.h"
+#include "MoveInstruction.h"
+#include "PhiInstruction.h"
+
+/// @brief 构造函数
+/// @param _module 符号表
+/// @param _func 要处理的函数
+/// @param _liveness 函数的活跃变量分析结果
+SCCP::SCCP(Module * _module, Function * _func, const Liveness & _liveness)
+    : module(_module), func(_func), liveness(_liveness)
+{}
+
+/// @brief 执行常量传播
+/// @return int32_t 折叠为常量的指令个数
+int32_t SCCP::run()
+{
+    ControlFlowGraph & cfg = func->getCFG();
+    if (cfg.empty()) {
+        return 0;
+    }
+
+    executableBlocks.assign(cfg.getBlocks().size(), false);
+
+    BasicBlock * entry = cfg.getEntry();
+    executableBlocks[entry->getIndex()] = true;
+    blockWorklist.push_back(entry);
+
+    // 入口处活跃的局部变量在某条路径上先读后赋值，读到的值不确定
+    for (LocalVariable * var: func->getVarValues()) {
+        if (liveness.isLiveIn(entry, var)) {
+            lattice[var].state = LatticeValue::OVERDEFINED;
+        }
+    }
+
+    while (!blockWorklist.empty() || !valueWorklist.empty()) {
+
+        // 格升高的指令与局部变量，重新计算可执行块中的使用者
+        while (!valueWorklist.empty()) {
+            Value * val = valueWorklist.back();
+            valueWorklist.pop_back();
+
+            for (Use * use = val->getUseList(); use; use = use->getNext()) {
+                auto * user = dyn_cast<Instruction>(use->getUser());
+                if (user && user->getBasicBlock() && executableBlocks[user->getBasicBlock()->getIndex()]) {
+                    visitInst(user);
+                }
+            }
+        }
+
+        while (!blockWorklist.empty()) {
+            BasicBlock * bb = blockWorklist.back();
+            blockWorklist.pop_back();
+
+            visitBlock(bb);
+        }
+    }
+
+    // 值为常量的指令，其使用者改为使用常量，指令本身没有了使用者，留给死代码删除
+    int32_t count = 0;
+    for (BasicBlock * bb: cfg.getBlocks()) {
+        for (Instruction * inst: *bb) {
+            auto iter = lattice.find(inst);
+            if ((iter != lattice.end()) && (iter->second.state == LatticeValue::CONSTANT) && inst->hasUses()) {
+                inst->replaceAllUsesWith(module->newConstInt(iter->second.value));
+                count++;
+            }
+        }
+    }
+
+    // 值为常量的局部变量，读变量处改为使用常量，对变量的赋值留给死代码删除。赋值指令的第一个操作数不是读
+    for (BasicBlock * bb: cfg.getBlocks()) {
+        for (Instruction * inst: *bb) {
+            int32_t operandsNum = inst->getOperandsNum();
+            for (int32_t k = isa<MoveInstruction>(inst) ? 1 : 0; k < operandsNum; ++k) {
+                auto * var = dyn_cast<LocalVariable>(inst->getOperand(k));
+                if (!var) {
+                    continue;
+                }
+
+                auto iter = lattice.find(var);
+                if ((iter != lattice.end()) && (iter->second.state == LatticeValue::CONSTANT)) {
+                    inst->setOperand(k, module->newConstInt(iter->second.value));
+                    count++;
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+/// @brief 按目标机器的语义计算二元运算
+/// @param op 运算符
+/// @param lhs 左操作数
+/// @param rhs 右操作数
+/// @param result 运算结果
+/// @return true 可折叠 false 不可在编译时求值
+bool SCCP::foldBinary(IRInstOperator op, int32_t lhs, int32_t rhs, int32_t & result)
+{
+    // 加减乘在无符号数上计算，溢出时按32位补码回绕，与ARM32的add/sub/mul一致
+    auto a = (uint32_t) lhs;
+    auto b = (uint32_t) rhs;
+
+    switch (op) {
+        case IRInstOperator::IRINST_OP_ADD_I:
+            result = (int32_t) (a + b);
+            return true;
+        case IRInstOperator::IRINST_OP_SUB_I:
+            result = (int32_t) (a - b);
+            return true;
+        case IRInstOperator::IRINST_OP_MUL_I:
+            result = (int32_t) (a * b);
+            return true;
+        case IRInstOperator::IRINST_OP_DIV_I:
+            // 除数为0时保留运行时的行为；INT_MIN/-1溢出，sdiv的结果为INT_MIN
+            if (rhs == 0) {
+                return false;
+            }
+            result = ((lhs == INT32_MIN) && (rhs == -1)) ? INT32_MIN : lhs / rhs;
+            return true;
+        case IRInstOperator::IRINST_OP_MOD_I:
+            // 后端用被除数减去商与除数之积求余，余数与被除数同号，INT_MIN%-1为0
+            if (rhs == 0) {
+                return false;
+            }
+            result = (rhs == -1) ? 0 : lhs % rhs;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/// @brief 处理一个新成为可执行的块中的所有指令，并使其出边可执行
+/// @param bb 基本块
+void SCCP::visitBlock(BasicBlock * bb)
+{
+    for (Instruction * inst: *bb) {
+        visitInst(inst);
+    }
+
+    // MiniC只有无条件跳转，可执行块的出边都可执行。有条件跳转时应按条件的格只使可能走的边可执行
+    for (BasicBlock * succ: bb->getSuccessors()) {
+        markEdgeExecutable(bb, succ);
+    }
+}
+
+/// @brief 重新计算一条指令的格，升高时其使用者加入工作表
+/// @param inst 指令
+void SCCP::visitInst(Instruction * inst)
+{
+    LatticeValue result;
+
+    // 格被更新的值，对局部变量赋值时是变量
+    Value * target = inst;
+
+    // 两个格的汇合
+    auto meet = [](LatticeValue & to, const LatticeValue & from) {
+        if ((from.state == LatticeValue::UNDEFINED) || (to.state == LatticeValue::OVERDEFINED)) {
+            return;
+        }
+        if ((to.state == LatticeValue::UNDEFINED) || (from.state == LatticeValue::OVERDEFINED)) {
+            to = from;
+        } else if (to.value != from.value) {
+            to.state = LatticeValue::OVERDEFINED;
+        }
+    };
+
+    if (auto * phi = dyn_cast<PhiInstruction>(inst)) {
+
+        // 只汇合从可执行边来的值
+        uint64_t to = phi->getBasicBlock()->getIndex();
+        for (int32_t k = 0; k < phi->getIncomingNum(); ++k) {
+            uint64_t from = phi->getIncomingBlock(k)->getIndex();
+            if (executableEdges.count((from << 32) | to)) {
+                meet(result, getLattice(phi->getIncomingValue(k)));
+                if (result.state == LatticeValue::OVERDEFINED) {
+                    break;
+                }
+            }
+        }
+    } else if (isa<BinaryInstruction>(inst)) {
+
+        LatticeValue lhs = getLattice(inst->getOperand(0));
+        LatticeValue rhs = getLattice(inst->getOperand(1));
+
+        if ((lhs.state == LatticeValue::CONSTANT) && (rhs.state == LatticeValue::CONSTANT)) {
+            if (foldBinary(inst->getOp(), lhs.value, rhs.value, result.value)) {
+                result.state = LatticeValue::CONSTANT;
+            } else {
+                result.state = LatticeValue::OVERDEFINED;
+            }
+        } else if ((inst->getOp() == IRInstOperator::IRINST_OP_MUL_I) &&
+                   (((lhs.state == LatticeValue::CONSTANT) && (lhs.value == 0)) ||
+                    ((rhs.state == LatticeValue::CONSTANT) && (rhs.value == 0)))) {
+            // 乘以0的结果与另一个操作数无关
+            result.state = LatticeValue::CONSTANT;
+            result.value = 0;
+        } else if ((lhs.state == LatticeValue::OVERDEFINED) || (rhs.state == LatticeValue::OVERDEFINED)) {
+            result.state = LatticeValue::OVERDEFINED;
+        }
+    } else if (auto * move = dyn_cast<MoveInstruction>(inst)) {
+
+        // 对全局变量的赋值不跟踪，全局变量可能被函数调用修改
+        auto * var = dyn_cast<LocalVariable>(move->getOperand(0));
+        if (!var) {
+            return;
+        }
+
+        // 变量的格汇合本次赋值的值。入口处不活跃的变量在每条路径上都先赋值后读取，与赋值的次序无关
+        target = var;
+        result = lattice[var];
+        meet(result, getLattice(move->getOperand(1)));
+    } else {
+        // 其它指令的值（如函数调用的返回值）总是不确定的，不必记录
+        return;
+    }
+
+    LatticeValue & old = lattice[target];
+    if ((old.state == result.state) && (old.value == result.value)) {
+        return;
+    }
+
+    // 格只能升高：已经不确定的值不再变化，也不会回到未定义。乘以0的捷径在一个操作数先成为不确定、
+    // 另一个操作数后成为常量0时会算出常量0，这里不能让格下降，否则工作表算法不保证终止与正确
+    if ((old.state == LatticeValue::OVERDEFINED) || (result.state == LatticeValue::UNDEFINED)) {
+        return;
+    }
+
+    // 格只能升高，常量值变化说明不是常量
+    if ((old.state == LatticeValue::CONSTANT) && (result.state == LatticeValue::CONSTANT)) {
+        result.state = LatticeValue::OVERDEFINED;
+    }
+
+    old = result;
+    valueWorklist.push_back(target);
+}
+
+/// @brief 使一条控制流边可执行，目标块的phi要重新汇合
+/// @param from 源块
+/// @param to 目标块
+void SCCP::markEdgeExecutable(BasicBlock * from, BasicBlock * to)
+{
+    uint64_t key = ((uint64_t) from->getIndex() << 32) | (uint64_t) to->getIndex();
+    if (!executableEdges.insert(key).second) {
+        return;
+    }
+
+    if (!executableBlocks[to->getIndex()]) {
+        // 第一次可执行，整块在出工作表时处理
+        executableBlocks[to->getIndex()] = true;
+        blockWorklist.push_back(to);
+        return;
+    }
+
+    // phi指令都在块开头的Label指令之后
+    for (Instruction * inst = to->getFirstInst()->getNextInst(); inst && isa<PhiInstruction>(inst);
+         inst = inst->getNextInst()) {
+        visitInst(inst);
+    }
+}
+
+/// @brief 获取值的格
+/// @param val 值
+/// @return LatticeValue 格
+SCCP::LatticeValue SCCP::getLattice(Value * val)
+{
+    LatticeValue result;
+
+    if (auto * constInt = dyn_cast<ConstInt>(val)) {
+        result.state = LatticeValue::CONSTANT;
+        result.value = constInt->getVal();
+        return result;
+    }
+
+    if (auto * var = dyn_cast<LocalVariable>(val)) {
+        // 还没有可执行的赋值的变量为未定义，入口处活跃的变量已置为不确定
+        auto iter = lattice.find(var);
+        return (iter != lattice.end()) ? iter->second : result;
+    }
+
+    if (auto * inst = dyn_cast<Instruction>(val)) {
+        auto iter = lattice.find(inst);
+        if (iter != lattice.end()) {
+            return iter->second;
+        }
+
+        // 还没有计算过的二元运算与phi指令先视为未定义
+        if (isa<BinaryInstruction>(inst) || isa<PhiInstruction>(inst)) {
+            return result;
+        }
+    }
+
+    // 全局变量、形参与函数调用的返回值等在编译时不确定
+    result.state = LatticeValue::OVERDEFINED;
+    return result;
+}
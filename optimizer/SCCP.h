@@ -0,0 +1,145 @@
+///
+/// @file SCCP.h
+/// @brief 稀疏条件常量传播，计算出值为常量的指令并用常量替换其使用
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>常量经对局部变量的赋值传播
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Instruction.h"
+
+class BasicBlock;
+class Liveness;
+class LocalVariable;
+class Module;
+
+///
+/// @brief 稀疏条件常量传播（Wegman-Zadeck）。在SSA形式上同时推导值的格与控制流边的可执行性：
+/// phi只汇合从可执行边来的值，二元运算指令的操作数都是常量时按32位补码回绕与向零截断的除法求值。
+/// 值为常量的指令，其使用者改为使用常量，指令本身保留，由后续的死代码删除遍删除。
+/// 常量沿SSA的定值-使用边传播，也经过变量提升后留下的局部变量（如只赋值一次的拷贝变量）：
+/// 局部变量的格是所有可执行的赋值的源操作数的格的汇合，为常量时读变量处改为使用常量。
+/// 在入口处活跃的局部变量可能先读后赋值，读到的值不确定，不参与传播
+///
+class SCCP {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表，折叠的结果通过它创建常量
+    /// @param _func 要处理的函数，要求其控制流图已经建立
+    /// @param _liveness 函数的活跃变量分析结果，用于找出可能先读后赋值的局部变量
+    ///
+    SCCP(Module * _module, Function * _func, const Liveness & _liveness);
+
+    ///
+    /// @brief 执行常量传播
+    /// @return int32_t 折叠为常量的指令个数
+    ///
+    int32_t run();
+
+    ///
+    /// @brief 按目标机器的语义计算二元运算，加减乘按32位补码回绕，除法向零截断
+    /// @param op 运算符
+    /// @param lhs 左操作数
+    /// @param rhs 右操作数
+    /// @param result 运算结果
+    /// @return true 可折叠 false 除数为0等不可在编译时求值
+    ///
+    static bool foldBinary(IRInstOperator op, int32_t lhs, int32_t rhs, int32_t & result);
+
+private:
+    ///
+    /// @brief 值的格，未定义 < 常量 < 不确定
+    ///
+    struct LatticeValue {
+        enum State { UNDEFINED, CONSTANT, OVERDEFINED };
+
+        /// @brief 状态
+        State state = UNDEFINED;
+
+        /// @brief 常量的值，状态为CONSTANT时有效
+        int32_t value = 0;
+    };
+
+    ///
+    /// @brief 处理一个新成为可执行的块中的所有指令，并使其出边可执行
+    /// @param bb 基本块
+    ///
+    void visitBlock(BasicBlock * bb);
+
+    ///
+    /// @brief 重新计算一条指令的格，升高时其使用者加入工作表
+    /// @param inst 指令
+    ///
+    void visitInst(Instruction * inst);
+
+    ///
+    /// @brief 使一条控制流边可执行，目标块的phi要重新汇合
+    /// @param from 源块
+    /// @param to 目标块
+    ///
+    void markEdgeExecutable(BasicBlock * from, BasicBlock * to);
+
+    ///
+    /// @brief 获取值的格，常量为CONSTANT，局部变量为其所有赋值的汇合，全局变量、形参与函数调用等为OVERDEFINED
+    /// @param val 值
+    /// @return LatticeValue 格
+    ///
+    LatticeValue getLattice(Value * val);
+
+    ///
+    /// @brief 符号表
+    ///
+    Module * module;
+
+    ///
+    /// @brief 要处理的函数
+    ///
+    Function * func;
+
+    ///
+    /// @brief 函数的活跃变量分析结果
+    ///
+    const Liveness & liveness;
+
+    ///
+    /// @brief 各值的格，只记录二元运算、phi指令与被赋值的局部变量
+    ///
+    std::unordered_map<Value *, LatticeValue> lattice;
+
+    ///
+    /// @brief 按块编号记录块是否可执行
+    ///
+    std::vector<bool> executableBlocks;
+
+    ///
+    /// @brief 可执行的边，以源块与目标块的编号组成键
+    ///
+    std::unordered_set<uint64_t> executableEdges;
+
+    ///
+    /// @brief 新成为可执行的块
+    ///
+    std::vector<BasicBlock *> blockWorklist;
+
+    ///
+    /// @brief 格升高了的指令与局部变量，其使用者要重新计算
+    ///
+    std::vector<Value *> valueWorklist;
+};
@@ -0,0 +1,145 @@
+///
+/// @file ValueNumbering.cpp
+/// @brief 值编号，删除重复计算的公共子表达式
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <utility>
+
+#include "ValueNumbering.h"
+#include "BinaryInstruction.h"
+#include "Casting.h"
+#include "ConstInt.h"
+#include "Function.h"
+
+/// @brief 构造函数
+/// @param _func 要处理的函数
+/// @param _global true 全局值编号 false 局部值编号
+ValueNumbering::ValueNumbering(Function * _func, bool _global) : func(_func), global(_global)
+{}
+
+/// @brief 执行值编号
+/// @return int32_t 删除的冗余指令个数
+int32_t ValueNumbering::run()
+{
+    ControlFlowGraph & cfg = func->getCFG();
+    if (cfg.empty()) {
+        return 0;
+    }
+
+    if (!global) {
+        // 局部值编号，块之间互不可见
+        for (BasicBlock * bb: cfg.getBlocks()) {
+            std::vector<ExprKey> scope;
+            visitBlock(bb, scope);
+            leaveBlock(scope);
+        }
+        return removed;
+    }
+
+    // 显式栈先序遍历支配树，栈元素为块与下一个要访问的孩子的下标
+    std::vector<std::pair<BasicBlock *, size_t>> stack;
+    std::vector<std::vector<ExprKey>> scopeStack;
+
+    BasicBlock * entry = cfg.getEntry();
+    scopeStack.emplace_back();
+    visitBlock(entry, scopeStack.back());
+    stack.emplace_back(entry, 0);
+
+    while (!stack.empty()) {
+        auto & [bb, next] = stack.back();
+        const auto & children = bb->getDomChildren();
+
+        if (next < children.size()) {
+            BasicBlock * child = children[next++];
+            scopeStack.emplace_back();
+            visitBlock(child, scopeStack.back());
+            stack.emplace_back(child, 0);
+        } else {
+            leaveBlock(scopeStack.back());
+            scopeStack.pop_back();
+            stack.pop_back();
+        }
+    }
+
+    // 不可达而保留的出口块不在支配树中，单独处理
+    for (BasicBlock * bb: cfg.getBlocks()) {
+        if (bb->getRPOIndex() < 0) {
+            std::vector<ExprKey> scope;
+            visitBlock(bb, scope);
+            leaveBlock(scope);
+        }
+    }
+
+    return removed;
+}
+
+/// @brief 处理一个块
+/// @param bb 基本块
+/// @param scope 本块加入的表达式
+void ValueNumbering::visitBlock(BasicBlock * bb, std::vector<ExprKey> & scope)
+{
+    // 进入块时内存版本递增，读内存的表达式不会与别的块中的匹配
+    ++memoryVersion;
+
+    Instruction * end = bb->getLastInst()->getNextInst();
+
+    for (Instruction * inst = bb->getFirstInst(); inst != end;) {
+
+        if (!isa<BinaryInstruction>(inst)) {
+            // 函数调用可能修改全局变量，赋值修改被赋值的变量，之后读内存的表达式要重新计算
+            IRInstOperator op = inst->getOp();
+            if ((op == IRInstOperator::IRINST_OP_FUNC_CALL) || (op == IRInstOperator::IRINST_OP_ASSIGN)) {
+                ++memoryVersion;
+            }
+            inst = inst->getNextInst();
+            continue;
+        }
+
+        ExprKey key{inst->getOp(), inst->getOperand(0), inst->getOperand(1), 0};
+
+        // 可交换的运算，操作数按地址排序，a*b与b*a的键相同
+        if (((key.op == IRInstOperator::IRINST_OP_ADD_I) || (key.op == IRInstOperator::IRINST_OP_MUL_I)) &&
+            (std::less<Value *>()(key.rhs, key.lhs))) {
+            std::swap(key.lhs, key.rhs);
+        }
+
+        // 指令的值与常量不会改变，变量、形参等要按内存版本区分
+        auto isImmutable = [](Value * val) { return isa<Instruction>(val) || isa<ConstInt>(val); };
+        if (!isImmutable(key.lhs) || !isImmutable(key.rhs)) {
+            key.memoryVersion = memoryVersion;
+        }
+
+        auto iter = table.find(key);
+        if (iter == table.end()) {
+            table.emplace(key, inst);
+            scope.push_back(key);
+            inst = inst->getNextInst();
+            continue;
+        }
+
+        // 冗余的计算，使用者改为使用先前的结果
+        inst->replaceAllUsesWith(iter->second);
+        inst->clearOperands();
+        inst = bb->erase(inst);
+        removed++;
+    }
+}
+
+/// @brief 离开块时删除块内加入的表达式
+/// @param scope 本块加入的表达式
+void ValueNumbering::leaveBlock(const std::vector<ExprKey> & scope)
+{
+    for (const ExprKey & key: scope) {
+        table.erase(key);
+    }
+}
@@ -0,0 +1,125 @@
+///
+/// @file ValueNumbering.h
+/// @brief 值编号，删除重复计算的公共子表达式
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "Instruction.h"
+
+class BasicBlock;
+
+///
+/// @brief 值编号。以（运算符，左操作数的值编号，右操作数的值编号）为键查找已计算过的表达式，
+/// 找到时后面的指令的使用者改为使用前面的指令，并删除后面的指令。
+/// 冗余的指令被替换后，其使用者的操作数就是前面的指令，因此指令本身即为其值编号，常量在符号表中唯一，也是其值编号。
+/// 加法与乘法可交换，操作数按地址排序后作为键。
+/// 局部值编号只在块内查找；全局值编号沿支配树先序遍历，支配块中的表达式在被支配块中可见。
+/// 读全局变量等内存的表达式，在函数调用或对变量赋值后值可能改变，只在块内两次修改之间查找
+///
+class ValueNumbering {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _func 要处理的函数，全局值编号时要求已经计算了支配信息
+    /// @param _global true 全局值编号 false 局部值编号
+    ///
+    ValueNumbering(Function * _func, bool _global);
+
+    ///
+    /// @brief 执行值编号
+    /// @return int32_t 删除的冗余指令个数
+    ///
+    int32_t run();
+
+private:
+    ///
+    /// @brief 表达式的键
+    ///
+    struct ExprKey {
+        /// @brief 运算符
+        IRInstOperator op;
+
+        /// @brief 左操作数
+        Value * lhs;
+
+        /// @brief 右操作数
+        Value * rhs;
+
+        /// @brief 读内存的表达式所在的内存版本，只读SSA值与常量的表达式为0
+        uint32_t memoryVersion;
+
+        bool operator==(const ExprKey & other) const
+        {
+            return (op == other.op) && (lhs == other.lhs) && (rhs == other.rhs) &&
+                   (memoryVersion == other.memoryVersion);
+        }
+    };
+
+    ///
+    /// @brief 表达式的键的散列函数
+    ///
+    struct ExprKeyHash {
+        size_t operator()(const ExprKey & key) const
+        {
+            size_t h = std::hash<Value *>()(key.lhs);
+            h = h * 31 + std::hash<Value *>()(key.rhs);
+            h = h * 31 + (size_t) key.op;
+            return h * 31 + key.memoryVersion;
+        }
+    };
+
+    ///
+    /// @brief 处理一个块，块内新加入表格的表达式记录在scope中，离开块时删除
+    /// @param bb 基本块
+    /// @param scope 本块加入的表达式
+    ///
+    void visitBlock(BasicBlock * bb, std::vector<ExprKey> & scope);
+
+    ///
+    /// @brief 离开块时删除块内加入的表达式
+    /// @param scope 本块加入的表达式
+    ///
+    void leaveBlock(const std::vector<ExprKey> & scope);
+
+    ///
+    /// @brief 要处理的函数
+    ///
+    Function * func;
+
+    ///
+    /// @brief 是否全局值编号
+    ///
+    bool global;
+
+    ///
+    /// @brief 当前可见的表达式到计算它的指令的映射
+    ///
+    std::unordered_map<ExprKey, Instruction *, ExprKeyHash> table;
+
+    ///
+    /// @brief 内存版本，进入块、函数调用与对变量赋值时递增，从1开始
+    ///
+    uint32_t memoryVersion = 0;
+
+    ///
+    /// @brief 删除的冗余指令个数
+    ///
+    int32_t removed = 0;
+};
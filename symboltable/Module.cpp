@@ -2,7 +2,7 @@
 /// @file Module.cpp
 /// @brief  符号表-模块类
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.3
 /// @date 2024-09-29
 ///
 /// @copyright Copyright (c) 2024
@@ -11,8 +11,13 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>函数、全局变量与常量在模块的内存池中创建，Delete时整体释放
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>增加删除函数的接口
+/// <tr><td>2026-10-15 <td>1.3     <td>zenglj  <td>先释放全部函数体再释放各Value，不依赖释放次序
 /// </table>
 ///
+#include <algorithm>
+
 #include "Module.h"
 
 #include "ScopeStack.h"
@@ -28,7 +33,7 @@ Module::Module(std::string _name) : name(_name)
     scopeStack->enterScope();
 
     // 加入内置函数putint
-    (void) newFunction("putint", VoidType::getType(), {new FormalParam{IntegerType::getTypeInt(), ""}}, true);
+    (void) newFunction("putint", VoidType::getType(), {new (arena) FormalParam(IntegerType::getTypeInt(), "")}, true);
     (void) newFunction("getint", IntegerType::getTypeInt(), {}, true);
 }
 
@@ -84,11 +89,12 @@ Function * Module::newFunction(std::string name, Type * returnType, std::vector<
         paramsType.push_back(param->getType());
     }
 
-    /// 函数类型参数
+    /// 函数类型参数，由模块负责释放
     FunctionType * type = new FunctionType(returnType, paramsType);
+    types.push_back(type);
 
     // 新建函数对象
-    tempFunc = new Function(name, type, builtin);
+    tempFunc = new (arena) Function(name, type, builtin);
 
     // 设置参数
     tempFunc->getParams().assign(params.begin(), params.end());
@@ -101,7 +107,32 @@ Function * Module::newFunction(std::string name, Type * returnType, std::vector<
 /// @brief 根据函数名查找函数信息
 /// @param name 函数名
 /// @return 函数信息
-Function * Module::findFunction(std::string name)
+Function * Module::findFunction(const std::string & name)
+{
+    // 没有驻留过的名字肯定不是函数名
+    SymbolId id;
+    if (!StringInterner::instance().find(name, id)) {
+        return nullptr;
+    }
+
+    return findFunction(id);
+}
+
+/// @brief 从符号表中删除函数并释放
+/// @param func 函数
+void Module::removeFunction(Function * func)
+{
+    funcMap.erase(func->getNameId());
+    funcVector.erase(std::find(funcVector.begin(), funcVector.end(), func));
+
+    // 函数的内存随模块的内存池整体释放，这里只释放函数体
+    delete func;
+}
+
+/// @brief 根据函数名查找函数信息
+/// @param name 函数名的符号编号
+/// @return 函数信息
+Function * Module::findFunction(SymbolId name)
 {
     // 根据名字查找
     auto pIter = funcMap.find(name);
@@ -119,7 +150,10 @@ Function * Module::findFunction(std::string name)
 ///
 void Module::insertFunctionDirectly(Function * func)
 {
-    funcMap.insert({func->getName(), func});
+    // 声明次序用于函数体并行翻译时检查先定义后使用
+    func->setDeclareOrder((uint32_t) funcVector.size());
+
+    funcMap.insert({func->getNameId(), func});
     funcVector.emplace_back(func);
 }
 
@@ -128,7 +162,10 @@ void Module::insertFunctionDirectly(Function * func)
 /// @param val Value信息
 void Module::insertGlobalValueDirectly(GlobalVariable * val)
 {
-    globalVariableMap.emplace(val->getName(), val);
+    // 声明次序用于函数体并行翻译时检查先声明后使用
+    val->setDeclareOrder((uint32_t) globalVariableVector.size());
+
+    globalVariableMap.emplace(val->getNameId(), val);
     globalVariableVector.push_back(val);
 }
 
@@ -145,12 +182,14 @@ void Module::insertConstIntDirectly(ConstInt * val)
 /// @return 常量Value
 ConstInt * Module::newConstInt(int32_t intVal)
 {
+    std::lock_guard<std::mutex> lock(constIntMutex);
+
     // 查找整数字符串
     ConstInt * val = findConstInt(intVal);
     if (!val) {
 
         // 不存在，则创建整数常量Value
-        val = new ConstInt(intVal);
+        val = new (arena) ConstInt(intVal);
 
         insertConstIntDirectly(val);
     }
@@ -177,20 +216,19 @@ ConstInt * Module::findConstInt(int32_t val)
 /// @brief 在当前的作用域中查找，若没有查找到则创建局部变量或者全局变量。请注意不能创建临时变量
 /// ! 该函数只有在AST遍历生成线性IR中使用，其它地方不能使用
 /// @param type 变量类型
-/// @param name 变量ID 局部变量时可以为空，目的为了SSA时创建临时的局部变量，
+/// @param name 变量ID的符号编号 局部变量时可以为空，目的为了SSA时创建临时的局部变量，
 /// @return nullptr则说明变量已存在，否则为新建的变量
-Value * Module::newVarValue(Type * type, std::string name)
+Value * Module::newVarValue(Type * type, SymbolId name)
 {
     Value * retVal;
-    std::string varName;
 
     // 若变量名有效，检查当前作用域中是否存在变量，如存在则语义错误
     // 反之，因无效需创建新的变量名，肯定不现在的不同，不需要查找
-    if (!name.empty()) {
+    if (name != EmptySymbol) {
         Value * tempValue = scopeStack->findCurrentScope(name);
         if (tempValue) {
             // 变量存在，语义错误
-            minic_log(LOG_ERROR, "变量(%s)已经存在", name.c_str());
+            minic_log(LOG_ERROR, "变量(%s)已经存在", symbolName(name).c_str());
             return nullptr;
         }
     } else if (!currentFunc) {
@@ -203,7 +241,7 @@ Value * Module::newVarValue(Type * type, std::string name)
 
         // 获取变量作用域的层级
         int32_t scope_level;
-        if (name.empty()) {
+        if (name == EmptySymbol) {
             scope_level = 1;
         } else {
             scope_level = scopeStack->getCurrentScopeLevel();
@@ -224,9 +262,9 @@ Value * Module::newVarValue(Type * type, std::string name)
 /// @brief 查找变量，会根据作用域栈进行逐级查找。
 /// ! 该函数只有在AST遍历生成线性IR中使用，其它地方不能使用
 ///
-/// @param name 变量ID
+/// @param name 变量ID的符号编号
 /// @return 指针有效则找到，空指针未找到
-Value * Module::findVarValue(std::string name)
+Value * Module::findVarValue(SymbolId name)
 {
     // 逐层级作用域查找
     Value * tempValue = scopeStack->findAllScope(name);
@@ -237,12 +275,12 @@ Value * Module::findVarValue(std::string name)
 ///
 /// @brief 新建全局变量，要求name必须有效，并且加入到全局符号表中。不检查是否现有的符号表中是否存在。
 /// @param type 类型
-/// @param name 名字
+/// @param name 名字的符号编号
 /// @return Value* 全局变量
 ///
-GlobalVariable * Module::newGlobalVariable(Type * type, std::string name)
+GlobalVariable * Module::newGlobalVariable(Type * type, SymbolId name)
 {
-    GlobalVariable * val = new GlobalVariable(type, name);
+    GlobalVariable * val = new (arena) GlobalVariable(type, symbolName(name));
 
     insertGlobalValueDirectly(val);
 
@@ -253,7 +291,7 @@ GlobalVariable * Module::newGlobalVariable(Type * type, std::string name)
 /// @param name 变量名或者常量名
 /// @param create 变量查找不到时若为true则自动创建变量型Value，否则不创建
 /// @return 变量对应的值
-GlobalVariable * Module::findGlobalVariable(std::string name)
+GlobalVariable * Module::findGlobalVariable(SymbolId name)
 {
     GlobalVariable * temp = nullptr;
 
@@ -269,6 +307,11 @@ GlobalVariable * Module::findGlobalVariable(std::string name)
 /// @brief 清理注册的所有Value资源
 void Module::Delete()
 {
+    // 先释放全部函数体，函数、全局变量与常量就不再有使用者，之后的释放与次序无关
+    for (auto func: funcVector) {
+        func->Delete();
+    }
+
     // 清除所有的函数
     for (auto func: funcVector) {
         delete func;
@@ -279,12 +322,31 @@ void Module::Delete()
         delete var;
     }
 
+    // 清理整数常量
+    for (auto & pair: constIntMap) {
+        delete pair.second;
+    }
+
+    // 清理函数类型等
+    for (auto type: types) {
+        delete type;
+    }
+
+    delete scopeStack;
+    scopeStack = nullptr;
+
     // 相关列表清空
     globalVariableMap.clear();
     globalVariableVector.clear();
 
     funcMap.clear();
     funcVector.clear();
+
+    constIntMap.clear();
+    types.clear();
+
+    // 模块内的对象都已析构，内存整体归还，不再逐个释放
+    arena.release();
 }
 
 ///
@@ -309,7 +371,7 @@ void Module::outputIR(const std::string & filePath)
 
     FILE * fp = fopen(filePath.c_str(), "w");
     if (nullptr == fp) {
-        printf("fopen() failed\n");
+        minic_diag("fopen() failed\n");
         return;
     }
 
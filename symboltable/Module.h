@@ -2,7 +2,7 @@
 /// @file Module.h
 /// @brief 符号表-模块类
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.2
 /// @date 2024-09-29
 ///
 /// @copyright Copyright (c) 2024
@@ -11,14 +11,18 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>函数、全局变量与常量在模块的内存池中创建
+/// <tr><td>2026-10-15 <td>1.2     <td>zenglj  <td>增加删除函数的接口
 /// </table>
 ///
 #pragma once
 
+#include <mutex>
 #include <string>
 #include <vector>
 #include <unordered_map>
 
+#include "Arena.h"
 #include "ConstInt.h"
 #include "Type.h"
 #include "GlobalVariable.h"
@@ -88,7 +92,16 @@ public:
     /// @brief 根据函数名查找函数信息
     /// @param name 函数名
     /// @return 函数信息
-    Function * findFunction(std::string name);
+    Function * findFunction(const std::string & name);
+
+    /// @brief 根据函数名查找函数信息
+    /// @param name 函数名的符号编号
+    /// @return 函数信息
+    Function * findFunction(SymbolId name);
+
+    /// @brief 从符号表中删除函数并释放，要求没有其它函数调用它
+    /// @param func 函数
+    void removeFunction(Function * func);
 
     ///
     /// @brief 获取全局变量列表，用于外部遍历全局变量
@@ -105,22 +118,22 @@ public:
         return funcVector;
     }
 
-    /// @brief 新建一个整型数值的Value，并加入到符号表，用于后续释放空间
+    /// @brief 新建一个整型数值的Value，并加入到符号表，用于后续释放空间。可被并行翻译的多个函数同时调用
     /// \param intVal 整数值
     /// \return 临时Value
     ConstInt * newConstInt(int32_t intVal);
 
     /// @brief 新建变量型Value，会根据currentFunc的值进行判断创建全局或者局部变量
     /// ! 该函数只有在AST遍历生成线性IR中使用，其它地方不能使用
-    /// @param name 变量ID
+    /// @param name 变量ID的符号编号
     /// @param type 变量类型
-    Value * newVarValue(Type * type, std::string name = "");
+    Value * newVarValue(Type * type, SymbolId name = EmptySymbol);
 
     /// @brief 查找变量（全局变量或局部变量），会根据作用域栈进行逐级查找。
     /// ! 该函数只有在AST遍历生成线性IR中使用，其它地方不能使用
-    /// @param name 变量ID
+    /// @param name 变量ID的符号编号
     /// @return 指针有效则找到，空指针未找到
-    Value * findVarValue(std::string name);
+    Value * findVarValue(SymbolId name);
 
     /// @brief 清理Module中管理的所有信息资源
     void Delete();
@@ -143,15 +156,15 @@ protected:
     ///
     /// @brief 新建全局变量，要求name必须有效，并且加入到全局符号表中。
     /// @param type 类型
-    /// @param name 名字
+    /// @param name 名字的符号编号
     /// @return Value* 全局变量
     ///
-    GlobalVariable * newGlobalVariable(Type * type, std::string name);
+    GlobalVariable * newGlobalVariable(Type * type, SymbolId name);
 
     /// @brief 根据变量名获取当前符号（只管理全局变量）
-    /// \param name 变量名
+    /// \param name 变量名的符号编号
     /// \return 变量对应的值
-    GlobalVariable * findGlobalVariable(std::string name);
+    GlobalVariable * findGlobalVariable(SymbolId name);
 
     /// @brief 直接插入函数到符号表中，不考虑现有的表中是否存在
     /// @param func 函数对象
@@ -166,6 +179,11 @@ protected:
     void insertConstIntDirectly(ConstInt * val);
 
 private:
+    ///
+    /// @brief 模块的内存池，函数、全局变量、常量与形参在其中创建，Delete时整体释放
+    ///
+    Arena arena;
+
     ///
     /// @brief 模块名，也就是要编译的文件名
     ///
@@ -182,18 +200,21 @@ private:
     /// @brief 遍历抽象树过程中的当前处理函数
     Function * currentFunc = nullptr;
 
-    /// @brief 函数映射表，函数名-函数，便于检索
-    std::unordered_map<std::string, Function *> funcMap;
+    /// @brief 函数映射表，函数名的符号编号-函数，便于检索
+    std::unordered_map<SymbolId, Function *> funcMap;
 
     /// @brief  函数列表
     std::vector<Function *> funcVector;
 
-    /// @brief 变量名映射表，变量名-变量，只保存全局变量
-    std::unordered_map<std::string, GlobalVariable *> globalVariableMap;
+    /// @brief 变量名映射表，变量名的符号编号-变量，只保存全局变量
+    std::unordered_map<SymbolId, GlobalVariable *> globalVariableMap;
 
     /// @brief 只保存全局变量
     std::vector<GlobalVariable *> globalVariableVector;
 
     /// @brief 常量表
     std::unordered_map<int32_t, ConstInt *> constIntMap;
+
+    /// @brief 保护常量表与常量的创建，函数体并行翻译时会同时创建常量
+    std::mutex constIntMutex;
 };
\ No newline at end of file
@@ -21,7 +21,7 @@
 void ScopeStack::enterScope()
 {
     // 在栈顶新加入一层，没有变量
-    std::unordered_map<std::string, Value *> valueMap;
+    std::unordered_map<SymbolId, Value *> valueMap;
     valueStack.emplace_back(valueMap);
 }
 
@@ -39,15 +39,15 @@ void ScopeStack::leaveScope()
 ///
 void ScopeStack::insertValue(Value * value)
 {
-    valueStack.back().insert(make_pair(value->getName(), value));
+    valueStack.back().insert(std::make_pair(value->getNameId(), value));
 }
 
 ///
 /// @brief 从当前的作用域中查找指定的变量名
-/// @param  name 变量名
+/// @param  name 变量名的符号编号
 /// @return Value* 变量对象，若没有，则返回空指针
 ///
-Value * ScopeStack::findCurrentScope(std::string name)
+Value * ScopeStack::findCurrentScope(SymbolId name)
 {
     // 在栈顶的作用域中查找，即当前作用域
     auto it = valueStack.back().find(name);
@@ -59,10 +59,10 @@ Value * ScopeStack::findCurrentScope(std::string name)
 
 ///
 /// @brief 逐层级遍历作用域检查变量是否存在
-/// @param  name 变量名
+/// @param  name 变量名的符号编号
 /// @return Value* 变量对象。若没有，则返回空指针
 ///
-Value * ScopeStack::findAllScope(std::string name)
+Value * ScopeStack::findAllScope(SymbolId name)
 {
     // 模拟栈操作，从栈顶开始查找
     for (auto it = valueStack.rbegin(); it != valueStack.rend(); ++it) {
@@ -0,0 +1,29 @@
+int g;
+
+int f()
+{
+    g = g + 1;
+    return g;
+}
+
+int main()
+{
+    int a, b, c, d;
+    a = getint();
+    b = getint();
+    c = a * b + b * a;
+    d = (a - b) * (a - b);
+    putint(c + d);
+    g = a;
+    c = g * 2 + g * 2;
+    d = f();
+    c = c + g * 2;
+    g = 5;
+    c = c + g * 2;
+    {
+        int e;
+        e = a * b;
+        putint(e + c);
+    }
+    return c;
+}
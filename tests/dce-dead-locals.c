@@ -0,0 +1,21 @@
+int g;
+
+int unused()
+{
+    int a, b, c;
+    a = 1;
+    b = a * 5;
+    c = b + g;
+    c = c - b;
+    return 2;
+}
+
+int main()
+{
+    int x, y;
+    x = unused();
+    y = x * 100;
+    g = x + 1;
+    putint(g);
+    return unused() + g;
+}
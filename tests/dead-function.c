@@ -0,0 +1,37 @@
+int g;
+
+int unusedLeaf()
+{
+    g = g + 100;
+    return 7;
+}
+
+int unusedCaller()
+{
+    int x;
+    x = unusedLeaf() + 1;
+    putint(x);
+    return x;
+}
+
+int leaf()
+{
+    g = g + 1;
+    return g * 10;
+}
+
+int caller()
+{
+    int y;
+    y = leaf() + leaf();
+    return y;
+}
+
+int main()
+{
+    int r;
+    r = caller();
+    putint(r);
+    putint(g);
+    return r + g;
+}
@@ -0,0 +1,12 @@
+int seven()
+{
+    return 7;
+}
+
+int main()
+{
+    int a;
+    a = seven();
+    putint(a);
+    return a - 4;
+}
@@ -0,0 +1,18 @@
+int g;
+
+int f()
+{
+    g = g + 1;
+    return g;
+}
+
+int main()
+{
+    int a;
+    g = 10;
+    a = g;
+    f();
+    putint(a);
+    g = 20;
+    return a;
+}
@@ -0,0 +1,18 @@
+int g;
+
+int main()
+{
+    int a, b, c, d;
+    a = 6 * 7;
+    b = a;
+    g = b;
+    c = g;
+    d = c + b * 2;
+    g = d - 100;
+    b = a + 0;
+    putint(b);
+    putint(c);
+    putint(d);
+    putint(g);
+    return d * 0 + b - c + 5;
+}
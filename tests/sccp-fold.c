@@ -0,0 +1,17 @@
+int g;
+
+int main()
+{
+    int a, b, c, d, e;
+    a = 2 * 3 + 4;
+    b = a * a - 7;
+    c = -b / 4;
+    d = -b % 4;
+    e = 65536 * 65536 + 46341 * 46341;
+    g = a + b + c + d;
+    putint(g);
+    putint(e);
+    putint(c * d);
+    putint(g * 0);
+    return a * b / c % 7 + 50;
+}
@@ -0,0 +1,23 @@
+int g;
+
+int f()
+{
+    int a;
+    a = 3;
+    return a * 2;
+    a = a + 1;
+    g = a;
+    putint(a);
+    return a;
+}
+
+int main()
+{
+    int b;
+    b = f();
+    putint(b);
+    putint(g);
+    return b;
+    b = 5;
+    putint(b);
+}
@@ -0,0 +1,77 @@
+///
+/// @file Arena.cpp
+/// @brief 按块分配的内存池的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>支持回退到指定的分配位置
+/// </table>
+///
+#include "Arena.h"
+
+///
+/// @brief 释放全部内存块，之前分配的内存全部失效
+///
+void Arena::release()
+{
+    for (auto block: blocks) {
+        delete[] block;
+    }
+
+    blocks.clear();
+
+    cur = end = 0;
+    reservedBytes = 0;
+}
+
+///
+/// @brief 回退到之前获取的分配位置，其后分配的内存全部失效，其后申请的内存块归还系统
+/// @param m 分配位置
+///
+void Arena::rewind(const Mark & m)
+{
+    // 之后申请的块都在blocks的尾部，当时的当前块仍保留
+    for (size_t k = m.blockCount; k < blocks.size(); ++k) {
+        delete[] blocks[k];
+    }
+
+    blocks.resize(m.blockCount);
+
+    cur = m.cur;
+    end = m.end;
+    reservedBytes = m.reservedBytes;
+}
+
+///
+/// @brief 当前块剩余空间不足时申请新块再分配
+/// @param size 字节数
+/// @param align 对齐字节数
+/// @return void* 内存地址
+///
+void * Arena::allocateSlow(size_t size, size_t align)
+{
+    // 超大的请求单独申请一块，避免浪费当前块的剩余空间
+    size_t need = size + align;
+    size_t newSize = need > blockSize / 4 ? need : blockSize;
+
+    char * block = new char[newSize];
+    blocks.push_back(block);
+    reservedBytes += newSize;
+
+    uintptr_t p = ((uintptr_t) block + (align - 1)) & ~(uintptr_t) (align - 1);
+
+    if (newSize == blockSize) {
+        // 新的缺省块成为当前块
+        cur = p + size;
+        end = (uintptr_t) block + newSize;
+    }
+
+    return (void *) p;
+}
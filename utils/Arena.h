@@ -0,0 +1,202 @@
+///
+/// @file Arena.h
+/// @brief 按块分配的内存池（bump allocator），对象逐个分配、整体一次释放
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>支持回退到指定的分配位置
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+///
+/// @brief 内存池。从大块内存中顺序切分出小块，不支持单个对象的释放，release时整体释放。
+/// 内存池不调用对象的析构函数，放入其中的对象不能持有需要析构释放的资源（堆内存可改用ArenaAllocator）。
+///
+class Arena {
+
+public:
+    /// @brief 构造函数
+    /// @param _blockSize 每次向系统申请的内存块的缺省大小
+    explicit Arena(size_t _blockSize = 64 * 1024) : blockSize(_blockSize)
+    {}
+
+    /// @brief 析构函数，释放全部内存块
+    ~Arena()
+    {
+        release();
+    }
+
+    Arena(const Arena &) = delete;
+    Arena & operator=(const Arena &) = delete;
+
+    ///
+    /// @brief 分配指定大小与对齐的内存
+    /// @param size 字节数
+    /// @param align 对齐字节数，必须是2的幂
+    /// @return void* 内存地址
+    ///
+    void * allocate(size_t size, size_t align = alignof(std::max_align_t))
+    {
+        uintptr_t p = (cur + (align - 1)) & ~(uintptr_t) (align - 1);
+        if (p + size > end) {
+            return allocateSlow(size, align);
+        }
+
+        cur = p + size;
+
+        return (void *) p;
+    }
+
+    ///
+    /// @brief 在内存池中构造对象，对象的析构函数不会被调用
+    /// @tparam T 对象类型
+    /// @param args 构造函数的参数
+    /// @return T* 对象
+    ///
+    template <typename T, typename... Args>
+    T * create(Args &&... args)
+    {
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    ///
+    /// @brief 内存池的分配位置，用于回退
+    ///
+    struct Mark {
+        /// @brief 内存块的个数
+        size_t blockCount = 0;
+
+        /// @brief 当前块中下一个可分配的位置
+        uintptr_t cur = 0;
+
+        /// @brief 当前块的结束位置
+        uintptr_t end = 0;
+
+        /// @brief 已向系统申请的内存字节数
+        size_t reservedBytes = 0;
+    };
+
+    ///
+    /// @brief 获取当前的分配位置
+    /// @return Mark 分配位置
+    ///
+    Mark mark() const
+    {
+        return Mark{blocks.size(), cur, end, reservedBytes};
+    }
+
+    ///
+    /// @brief 回退到之前获取的分配位置，其后分配的内存全部失效，其后申请的内存块归还系统
+    /// @param m 分配位置
+    ///
+    void rewind(const Mark & m);
+
+    ///
+    /// @brief 释放全部内存块，之前分配的内存全部失效
+    ///
+    void release();
+
+    ///
+    /// @brief 已向系统申请的内存字节数
+    /// @return size_t
+    ///
+    size_t getReservedBytes() const
+    {
+        return reservedBytes;
+    }
+
+private:
+    ///
+    /// @brief 当前块剩余空间不足时申请新块再分配
+    /// @param size 字节数
+    /// @param align 对齐字节数
+    /// @return void* 内存地址
+    ///
+    void * allocateSlow(size_t size, size_t align);
+
+    /// @brief 内存块的缺省大小
+    size_t blockSize;
+
+    /// @brief 当前块中下一个可分配的位置
+    uintptr_t cur = 0;
+
+    /// @brief 当前块的结束位置
+    uintptr_t end = 0;
+
+    /// @brief 已向系统申请的内存字节数
+    size_t reservedBytes = 0;
+
+    /// @brief 申请的所有内存块
+    std::vector<char *> blocks;
+};
+
+///
+/// @brief 从内存池中分配内存的STL分配器，deallocate不做任何事情，内存随内存池整体释放
+/// @tparam T 元素类型
+///
+template <typename T>
+class ArenaAllocator {
+
+public:
+    typedef T value_type;
+
+    /// @brief 构造函数
+    /// @param _arena 内存池
+    ArenaAllocator(Arena * _arena) noexcept : arena(_arena)
+    {}
+
+    /// @brief 不同元素类型之间的转换构造函数
+    /// @param other 其它分配器
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> & other) noexcept : arena(other.getArena())
+    {}
+
+    /// @brief 分配n个元素的空间
+    /// @param n 元素个数
+    /// @return T* 空间地址
+    T * allocate(size_t n)
+    {
+        return (T *) arena->allocate(n * sizeof(T), alignof(T));
+    }
+
+    /// @brief 释放空间，由内存池整体释放，这里不做事情
+    void deallocate(T *, size_t) noexcept
+    {}
+
+    /// @brief 获取内存池
+    /// @return Arena*
+    Arena * getArena() const noexcept
+    {
+        return arena;
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U> & other) const noexcept
+    {
+        return arena == other.getArena();
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U> & other) const noexcept
+    {
+        return arena != other.getArena();
+    }
+
+private:
+    /// @brief 内存池
+    Arena * arena;
+};
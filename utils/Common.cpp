@@ -2,7 +2,7 @@
 /// @file Common.cpp
 /// @brief 共通函数
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
+/// @version 1.1
 /// @date 2024-11-21
 ///
 /// @copyright Copyright (c) 2024
@@ -11,9 +11,12 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>诊断信息可按线程收集，批量编译时各文件的诊断信息不交错
 /// </table>
 ///
+#include <cstdarg>
 #include <cstdint>
+#include <cstdio>
 #include <string>
 #include <iostream>
 
@@ -95,11 +98,42 @@ std::string trim(const std::string & str)
     return str.substr(pos);
 }
 
+/// @brief 本线程的诊断信息缓冲区，为空时直接输出
+static thread_local std::string * diagBuffer = nullptr;
+
 void minic_log_common(int level, const char * content)
 {
-    if (level != LOG_ERROR) {
+    if (diagBuffer) {
+        diagBuffer->append(content);
+        diagBuffer->push_back('\n');
+    } else if (level != LOG_ERROR) {
         std::cerr << content << std::endl;
     } else {
         std::cout << content << std::endl;
     }
-}
\ No newline at end of file
+}
+
+/// @brief 设置本线程的诊断信息缓冲区。设置后本线程的日志与前端的错误信息追加到缓冲区，不直接输出
+/// @param buffer 缓冲区，nullptr时恢复为直接输出
+void minic_set_diag_buffer(std::string * buffer)
+{
+    diagBuffer = buffer;
+}
+
+/// @brief 输出诊断信息，本线程设置了诊断信息缓冲区时追加到缓冲区，否则输出到标准输出
+/// @param format 格式化字符串，和printf的格式化字符串一样
+void minic_diag(const char * format, ...)
+{
+    char logStr[1024];
+
+    va_list ap;
+    va_start(ap, format);
+    vsnprintf(logStr, sizeof(logStr), format, ap);
+    va_end(ap);
+
+    if (diagBuffer) {
+        diagBuffer->append(logStr);
+    } else {
+        fputs(logStr, stdout);
+    }
+}
@@ -0,0 +1,138 @@
+///
+/// @file CompileCache.cpp
+/// @brief 内容寻址的编译缓存的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>缓存的临时文件名加入进程号，多个进程共用缓存目录时不重名
+/// </table>
+///
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#include "CompileCache.h"
+
+/// @brief 构造函数
+/// @param _dir 缓存目录，不存在时在第一次写入时创建
+CompileCache::CompileCache(std::string _dir) : dir(std::move(_dir))
+{}
+
+/// @brief 键对应的缓存文件路径
+/// @param key 键
+/// @return std::string 文件路径
+std::string CompileCache::pathOf(const std::string & key) const
+{
+    // 按键的前两个字符分子目录，避免单个目录下的文件过多
+    return dir + "/" + key.substr(0, 2) + "/" + key.substr(2);
+}
+
+/// @brief 查找缓存
+/// @param key 键
+/// @param data 找到时为缓存的内容
+/// @return true: 命中 false: 未命中
+bool CompileCache::load(const std::string & key, std::string & data)
+{
+    if (readFile(pathOf(key), data)) {
+        hits++;
+        return true;
+    }
+
+    misses++;
+
+    return false;
+}
+
+/// @brief 写入缓存，失败时只是不缓存，不影响编译
+/// @param key 键
+/// @param data 内容
+/// @return true: 成功 false: 失败
+bool CompileCache::store(const std::string & key, const std::string & data)
+{
+    std::string path = pathOf(key);
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+    if (ec) {
+        return false;
+    }
+
+    // 先写入独有的临时文件，再改名为缓存文件。改名是原子的，其它进程读不到写了一半的文件。
+    // 多个进程共用缓存目录，临时文件名由进程号与进程内递增的序号组成，进程间与线程间都不会重名
+    static std::atomic<uint64_t> tempIndex{0};
+    std::string tempPath = path + ".tmp" + std::to_string(getpid()) + "." + std::to_string(tempIndex++);
+
+    if (!writeFile(tempPath, data)) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    return true;
+}
+
+/// @brief 读入整个文件
+/// @param fileName 文件名
+/// @param data 文件内容
+/// @return true: 成功 false: 失败
+bool CompileCache::readFile(const std::string & fileName, std::string & data)
+{
+    FILE * fp = fopen(fileName.c_str(), "rb");
+    if (!fp) {
+        return false;
+    }
+
+    data.clear();
+
+    char buf[16384];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+        data.append(buf, n);
+    }
+
+    bool result = !ferror(fp);
+
+    fclose(fp);
+
+    return result;
+}
+
+/// @brief 写入整个文件
+/// @param fileName 文件名
+/// @param data 文件内容
+/// @return true: 成功 false: 失败
+bool CompileCache::writeFile(const std::string & fileName, const std::string & data)
+{
+    FILE * fp = fopen(fileName.c_str(), "wb");
+    if (!fp) {
+        return false;
+    }
+
+    bool result = fwrite(data.data(), 1, data.size(), fp) == data.size();
+
+    if (fclose(fp) != 0) {
+        result = false;
+    }
+
+    return result;
+}
@@ -0,0 +1,102 @@
+///
+/// @file CompileCache.h
+/// @brief 内容寻址的编译缓存，保存在本地磁盘上
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+///
+/// @brief 编译缓存。键为内容的摘要（十六进制串），值为编译结果。
+/// 每个键一个文件，按键的前两个字符分子目录存放，写入时先写临时文件再改名，多个编译进程可同时使用同一缓存目录，
+/// 同一对象也可被多个线程同时使用。
+///
+class CompileCache {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _dir 缓存目录，不存在时在第一次写入时创建
+    ///
+    explicit CompileCache(std::string _dir);
+
+    ///
+    /// @brief 查找缓存
+    /// @param key 键
+    /// @param data 找到时为缓存的内容
+    /// @return true: 命中 false: 未命中
+    ///
+    bool load(const std::string & key, std::string & data);
+
+    ///
+    /// @brief 写入缓存，失败时只是不缓存，不影响编译
+    /// @param key 键
+    /// @param data 内容
+    /// @return true: 成功 false: 失败
+    ///
+    bool store(const std::string & key, const std::string & data);
+
+    ///
+    /// @brief 命中次数
+    /// @return uint64_t
+    ///
+    uint64_t getHits() const
+    {
+        return hits;
+    }
+
+    ///
+    /// @brief 未命中次数
+    /// @return uint64_t
+    ///
+    uint64_t getMisses() const
+    {
+        return misses;
+    }
+
+    ///
+    /// @brief 读入整个文件
+    /// @param fileName 文件名
+    /// @param data 文件内容
+    /// @return true: 成功 false: 失败
+    ///
+    static bool readFile(const std::string & fileName, std::string & data);
+
+    ///
+    /// @brief 写入整个文件
+    /// @param fileName 文件名
+    /// @param data 文件内容
+    /// @return true: 成功 false: 失败
+    ///
+    static bool writeFile(const std::string & fileName, const std::string & data);
+
+private:
+    ///
+    /// @brief 键对应的缓存文件路径
+    /// @param key 键
+    /// @return std::string 文件路径
+    ///
+    std::string pathOf(const std::string & key) const;
+
+    /// @brief 缓存目录
+    std::string dir;
+
+    /// @brief 命中次数
+    std::atomic<uint64_t> hits{0};
+
+    /// @brief 未命中次数
+    std::atomic<uint64_t> misses{0};
+};
@@ -0,0 +1,179 @@
+///
+/// @file Sha256.cpp
+/// @brief SHA-256摘要的实现，按照FIPS 180-4
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <algorithm>
+#include <cstring>
+
+#include "Sha256.h"
+
+/// @brief 轮常量
+static const uint32_t roundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+/// @brief 循环右移
+/// @param x 值
+/// @param n 位数
+/// @return uint32_t
+static inline uint32_t rotr(uint32_t x, int n)
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+/// @brief 构造函数
+Sha256::Sha256()
+{
+    static const uint32_t initState[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+    memcpy(state, initState, sizeof(state));
+}
+
+/// @brief 处理一个64字节的分组
+/// @param block 分组
+void Sha256::transform(const uint8_t * block)
+{
+    uint32_t w[64];
+
+    for (int k = 0; k < 16; ++k) {
+        w[k] = ((uint32_t) block[k * 4] << 24) | ((uint32_t) block[k * 4 + 1] << 16) |
+               ((uint32_t) block[k * 4 + 2] << 8) | (uint32_t) block[k * 4 + 3];
+    }
+
+    for (int k = 16; k < 64; ++k) {
+        uint32_t s0 = rotr(w[k - 15], 7) ^ rotr(w[k - 15], 18) ^ (w[k - 15] >> 3);
+        uint32_t s1 = rotr(w[k - 2], 17) ^ rotr(w[k - 2], 19) ^ (w[k - 2] >> 10);
+        w[k] = w[k - 16] + s0 + w[k - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (int k = 0; k < 64; ++k) {
+        uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = h + s1 + ch + roundConstants[k] + w[k];
+        uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + maj;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+/// @brief 追加数据
+/// @param data 数据首地址
+/// @param len 字节数
+/// @return Sha256& 自身，便于连续追加
+Sha256 & Sha256::update(const void * data, size_t len)
+{
+    const uint8_t * p = (const uint8_t *) data;
+
+    totalLen += len;
+
+    // 先补满缓冲区中未满的分组
+    if (bufferLen) {
+        size_t n = std::min(len, sizeof(buffer) - bufferLen);
+        memcpy(buffer + bufferLen, p, n);
+        bufferLen += n;
+        p += n;
+        len -= n;
+
+        if (bufferLen < sizeof(buffer)) {
+            return *this;
+        }
+
+        transform(buffer);
+        bufferLen = 0;
+    }
+
+    // 整块的分组直接处理，不经过缓冲区
+    while (len >= sizeof(buffer)) {
+        transform(p);
+        p += sizeof(buffer);
+        len -= sizeof(buffer);
+    }
+
+    memcpy(buffer, p, len);
+    bufferLen = len;
+
+    return *this;
+}
+
+/// @brief 追加字符串，后跟一个'\0'作为分隔，避免相邻字符串拼接后产生歧义
+/// @param str 字符串
+/// @return Sha256& 自身，便于连续追加
+Sha256 & Sha256::update(std::string_view str)
+{
+    static const char separator = '\0';
+
+    update(str.data(), str.size());
+
+    return update(&separator, 1);
+}
+
+/// @brief 结束计算，获取摘要的十六进制表示，之后不能再追加数据
+/// @return std::string 64个十六进制字符
+std::string Sha256::hexDigest()
+{
+    uint64_t bitLen = totalLen * 8;
+
+    // 填充：一个1比特，若干0比特，最后8字节为消息的比特长度
+    static const uint8_t padding[64] = {0x80};
+    size_t padLen = (bufferLen < 56) ? (56 - bufferLen) : (120 - bufferLen);
+    update(padding, padLen);
+
+    uint8_t lenBytes[8];
+    for (int k = 0; k < 8; ++k) {
+        lenBytes[k] = (uint8_t) (bitLen >> (56 - k * 8));
+    }
+    update(lenBytes, sizeof(lenBytes));
+
+    static const char hexDigits[] = "0123456789abcdef";
+
+    std::string result;
+    result.reserve(64);
+
+    for (uint32_t word: state) {
+        for (int shift = 28; shift >= 0; shift -= 4) {
+            result += hexDigits[(word >> shift) & 0xf];
+        }
+    }
+
+    return result;
+}
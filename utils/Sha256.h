@@ -0,0 +1,69 @@
+///
+/// @file Sha256.h
+/// @brief SHA-256摘要，用于内容寻址的编译缓存
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+///
+/// @brief SHA-256摘要计算，可分多次追加数据
+///
+class Sha256 {
+
+public:
+    /// @brief 构造函数
+    Sha256();
+
+    ///
+    /// @brief 追加数据
+    /// @param data 数据首地址
+    /// @param len 字节数
+    /// @return Sha256& 自身，便于连续追加
+    ///
+    Sha256 & update(const void * data, size_t len);
+
+    ///
+    /// @brief 追加字符串，后跟一个'\0'作为分隔，避免相邻字符串拼接后产生歧义
+    /// @param str 字符串
+    /// @return Sha256& 自身，便于连续追加
+    ///
+    Sha256 & update(std::string_view str);
+
+    ///
+    /// @brief 结束计算，获取摘要的十六进制表示，之后不能再追加数据
+    /// @return std::string 64个十六进制字符
+    ///
+    std::string hexDigest();
+
+private:
+    /// @brief 处理一个64字节的分组
+    /// @param block 分组
+    void transform(const uint8_t * block);
+
+    /// @brief 中间状态
+    uint32_t state[8];
+
+    /// @brief 未满一个分组的数据
+    uint8_t buffer[64];
+
+    /// @brief buffer中的字节数
+    size_t bufferLen = 0;
+
+    /// @brief 已处理的总字节数
+    uint64_t totalLen = 0;
+};
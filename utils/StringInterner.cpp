@@ -0,0 +1,117 @@
+///
+/// @file StringInterner.cpp
+/// @brief 全局字符串驻留表的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>支持多线程并发访问
+/// </table>
+///
+#include <mutex>
+
+#include "StringInterner.h"
+
+///
+/// @brief 获取全局唯一的驻留表
+/// @return StringInterner&
+///
+StringInterner & StringInterner::instance()
+{
+    static StringInterner interner;
+
+    return interner;
+}
+
+///
+/// @brief 构造函数，预先驻留空串
+///
+StringInterner::StringInterner()
+{
+    strings.emplace_back();
+    symbolMap.emplace(std::string_view(strings.back()), EmptySymbol);
+}
+
+///
+/// @brief 驻留字符串，若已存在则返回已有的编号
+/// @param str 字符串
+/// @return SymbolId 符号编号
+///
+SymbolId StringInterner::intern(std::string_view str)
+{
+    {
+        // 绝大多数情况下已经驻留，只需读锁
+        std::shared_lock<std::shared_mutex> lock(mutex);
+
+        auto pIter = symbolMap.find(str);
+        if (pIter != symbolMap.end()) {
+            return pIter->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+
+    // 释放读锁后可能已被其它线程驻留，需再查一次
+    auto pIter = symbolMap.find(str);
+    if (pIter != symbolMap.end()) {
+        return pIter->second;
+    }
+
+    SymbolId id = (SymbolId) strings.size();
+
+    // 映射表的键指向deque中保存的字符串，不另外拷贝
+    strings.emplace_back(str);
+    symbolMap.emplace(std::string_view(strings.back()), id);
+
+    return id;
+}
+
+///
+/// @brief 查找字符串的编号，不存在时不驻留
+/// @param str 字符串
+/// @param id 找到时返回的符号编号
+/// @return true：找到 false：未找到
+///
+bool StringInterner::find(std::string_view str, SymbolId & id) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    auto pIter = symbolMap.find(str);
+    if (pIter == symbolMap.end()) {
+        return false;
+    }
+
+    id = pIter->second;
+
+    return true;
+}
+
+///
+/// @brief 根据符号编号获取字符串
+/// @param id 符号编号
+/// @return const std::string& 字符串，在程序运行期间一直有效
+///
+const std::string & StringInterner::str(SymbolId id) const
+{
+    // deque追加时已有元素不移动，返回的引用在锁外仍然有效
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    return strings[id];
+}
+
+///
+/// @brief 已驻留的字符串个数，含空串
+/// @return size_t
+///
+size_t StringInterner::size() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    return strings.size();
+}
@@ -0,0 +1,118 @@
+///
+/// @file StringInterner.h
+/// @brief 全局字符串驻留表，标识符只保存一份，以紧凑的符号编号表示
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-15 <td>1.1     <td>zenglj  <td>支持多线程并发访问
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+///
+/// @brief 符号编号，同一个字符串总是得到同一个编号。0固定表示空串
+///
+typedef uint32_t SymbolId;
+
+///
+/// @brief 空串的符号编号
+///
+constexpr SymbolId EmptySymbol = 0;
+
+///
+/// @brief 字符串驻留表。词法分析识别的标识符驻留后以SymbolId在AST、作用域栈与Module间传递，
+/// 名字的查找只需对整数做哈希，每个不同的标识符只保存一份。
+/// 驻留表可被多个线程同时访问，查询时加读锁，新增字符串时加写锁。
+///
+class StringInterner {
+
+public:
+    ///
+    /// @brief 获取全局唯一的驻留表
+    /// @return StringInterner&
+    ///
+    static StringInterner & instance();
+
+    ///
+    /// @brief 驻留字符串，若已存在则返回已有的编号
+    /// @param str 字符串
+    /// @return SymbolId 符号编号
+    ///
+    SymbolId intern(std::string_view str);
+
+    ///
+    /// @brief 查找字符串的编号，不存在时不驻留
+    /// @param str 字符串
+    /// @param id 找到时返回的符号编号
+    /// @return true：找到 false：未找到
+    ///
+    bool find(std::string_view str, SymbolId & id) const;
+
+    ///
+    /// @brief 根据符号编号获取字符串
+    /// @param id 符号编号
+    /// @return const std::string& 字符串，在程序运行期间一直有效
+    ///
+    const std::string & str(SymbolId id) const;
+
+    ///
+    /// @brief 已驻留的字符串个数，含空串
+    /// @return size_t
+    ///
+    size_t size() const;
+
+private:
+    ///
+    /// @brief 构造函数，预先驻留空串
+    ///
+    StringInterner();
+
+    ///
+    /// @brief 按编号保存的字符串，deque追加时不移动已有元素，下面映射表中的string_view始终有效
+    ///
+    std::deque<std::string> strings;
+
+    ///
+    /// @brief 字符串到编号的映射表
+    ///
+    std::unordered_map<std::string_view, SymbolId> symbolMap;
+
+    ///
+    /// @brief 读写锁，保护上面的两个表
+    ///
+    mutable std::shared_mutex mutex;
+};
+
+///
+/// @brief 在全局驻留表中驻留字符串
+/// @param str 字符串
+/// @return SymbolId 符号编号
+///
+inline SymbolId internSymbol(std::string_view str)
+{
+    return StringInterner::instance().intern(str);
+}
+
+///
+/// @brief 根据符号编号获取全局驻留表中的字符串
+/// @param id 符号编号
+/// @return const std::string& 字符串
+///
+inline const std::string & symbolName(SymbolId id)
+{
+    return StringInterner::instance().str(id);
+}
@@ -0,0 +1,122 @@
+///
+/// @file ThreadPool.cpp
+/// @brief 固定线程数的线程池的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include "ThreadPool.h"
+
+///
+/// @brief 构造函数，创建工作线程
+/// @param threadCount 线程个数，为0时取硬件支持的并发线程数
+///
+ThreadPool::ThreadPool(unsigned threadCount)
+{
+    if (threadCount == 0) {
+        threadCount = hardwareThreads();
+    }
+
+    workers.reserve(threadCount);
+
+    for (unsigned k = 0; k < threadCount; ++k) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+///
+/// @brief 析构函数，等待已提交的任务完成后结束工作线程
+///
+ThreadPool::~ThreadPool()
+{
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+
+    taskReady.notify_all();
+
+    for (auto & worker: workers) {
+        worker.join();
+    }
+}
+
+///
+/// @brief 提交任务
+/// @param task 任务
+///
+void ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+        pending++;
+    }
+
+    taskReady.notify_one();
+}
+
+///
+/// @brief 等待已提交的任务全部完成
+///
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    allDone.wait(lock, [this] { return pending == 0; });
+}
+
+///
+/// @brief 硬件支持的并发线程数，获取不到时为1
+/// @return unsigned
+///
+unsigned ThreadPool::hardwareThreads()
+{
+    unsigned count = std::thread::hardware_concurrency();
+
+    return count ? count : 1;
+}
+
+///
+/// @brief 工作线程的执行函数，循环取任务执行
+///
+void ThreadPool::workerLoop()
+{
+    for (;;) {
+
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            taskReady.wait(lock, [this] { return stopping || !tasks.empty(); });
+
+            if (tasks.empty()) {
+                // 要结束并且没有任务了
+                return;
+            }
+
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) {
+                allDone.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,98 @@
+///
+/// @file ThreadPool.h
+/// @brief 固定线程数的线程池
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+///
+/// @brief 线程池。构造时创建固定个数的工作线程，任务按提交次序执行，wait等待全部任务完成。
+///
+class ThreadPool {
+
+public:
+    ///
+    /// @brief 构造函数，创建工作线程
+    /// @param threadCount 线程个数，为0时取硬件支持的并发线程数
+    ///
+    explicit ThreadPool(unsigned threadCount = 0);
+
+    ///
+    /// @brief 析构函数，等待已提交的任务完成后结束工作线程
+    ///
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool & operator=(const ThreadPool &) = delete;
+
+    ///
+    /// @brief 提交任务
+    /// @param task 任务
+    ///
+    void submit(std::function<void()> task);
+
+    ///
+    /// @brief 等待已提交的任务全部完成
+    ///
+    void wait();
+
+    ///
+    /// @brief 工作线程的个数
+    /// @return unsigned
+    ///
+    unsigned size() const
+    {
+        return (unsigned) workers.size();
+    }
+
+    ///
+    /// @brief 硬件支持的并发线程数，获取不到时为1
+    /// @return unsigned
+    ///
+    static unsigned hardwareThreads();
+
+private:
+    ///
+    /// @brief 工作线程的执行函数，循环取任务执行
+    ///
+    void workerLoop();
+
+    /// @brief 工作线程
+    std::vector<std::thread> workers;
+
+    /// @brief 待执行的任务
+    std::deque<std::function<void()>> tasks;
+
+    /// @brief 保护任务队列与计数
+    std::mutex mutex;
+
+    /// @brief 有新任务或要结束时通知工作线程
+    std::condition_variable taskReady;
+
+    /// @brief 任务全部完成时通知等待者
+    std::condition_variable allDone;
+
+    /// @brief 已提交但未完成的任务数
+    size_t pending = 0;
+
+    /// @brief 是否结束工作线程
+    bool stopping = false;
+};
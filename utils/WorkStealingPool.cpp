@@ -0,0 +1,206 @@
+///
+/// @file WorkStealingPool.cpp
+/// @brief 工作窃取的线程池的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include "ThreadPool.h"
+#include "WorkStealingPool.h"
+
+/// @brief 当前线程所属的线程池，不是工作线程时为空
+static thread_local WorkStealingPool * currentPool = nullptr;
+
+/// @brief 当前线程在所属线程池中的编号
+static thread_local unsigned currentIndex = 0;
+
+///
+/// @brief 构造函数，创建工作线程
+/// @param threadCount 线程个数，为0时取硬件支持的并发线程数
+///
+WorkStealingPool::WorkStealingPool(unsigned threadCount)
+{
+    if (threadCount == 0) {
+        threadCount = ThreadPool::hardwareThreads();
+    }
+
+    // 队列要在工作线程启动前全部创建好，工作线程会访问其它线程的队列
+    queues.reserve(threadCount);
+    for (unsigned k = 0; k < threadCount; ++k) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    workers.reserve(threadCount);
+    for (unsigned k = 0; k < threadCount; ++k) {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, k);
+    }
+}
+
+///
+/// @brief 析构函数，等待已提交的任务完成后结束工作线程
+///
+WorkStealingPool::~WorkStealingPool()
+{
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+
+    taskReady.notify_all();
+
+    for (auto & worker: workers) {
+        worker.join();
+    }
+}
+
+///
+/// @brief 提交任务。在工作线程中提交时放入本线程的队列，否则轮流放入各线程的队列
+/// @param task 任务
+///
+void WorkStealingPool::submit(std::function<void()> task)
+{
+    unsigned index;
+
+    // 先计入未完成的任务数，任务放入队列后可能马上被执行完
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending++;
+
+        if (currentPool == this) {
+            index = currentIndex;
+        } else {
+            index = nextQueue;
+            nextQueue = (nextQueue + 1) % (unsigned) queues.size();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued++;
+    }
+
+    taskReady.notify_one();
+}
+
+///
+/// @brief 等待已提交的任务全部完成，不能在任务中调用
+///
+void WorkStealingPool::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    allDone.wait(lock, [this] { return pending == 0; });
+}
+
+///
+/// @brief 从自己的队尾取任务
+/// @param index 工作线程的编号
+/// @param task 取到的任务
+/// @return true: 取到 false: 队列为空
+///
+bool WorkStealingPool::popLocal(unsigned index, std::function<void()> & task)
+{
+    WorkQueue & queue = *queues[index];
+
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.tasks.empty()) {
+        return false;
+    }
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    queued--;
+
+    return true;
+}
+
+///
+/// @brief 从其它线程的队头窃取任务
+/// @param index 工作线程的编号
+/// @param task 窃取到的任务
+/// @return true: 窃取到 false: 所有队列都为空
+///
+bool WorkStealingPool::steal(unsigned index, std::function<void()> & task)
+{
+    unsigned count = (unsigned) queues.size();
+
+    // 从下一个线程开始依次查看，避免所有空闲线程都去窃取同一个队列
+    for (unsigned k = 1; k < count; ++k) {
+
+        WorkQueue & victim = *queues[(index + k) % count];
+
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (victim.tasks.empty()) {
+            continue;
+        }
+
+        // 从队头窃取，与队列的主人从队尾取任务互不干扰
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        queued--;
+        steals++;
+
+        return true;
+    }
+
+    return false;
+}
+
+///
+/// @brief 一个任务执行完成，全部完成时通知等待者
+///
+void WorkStealingPool::finishTask()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (--pending == 0) {
+        allDone.notify_all();
+    }
+}
+
+///
+/// @brief 工作线程的执行函数，循环取任务执行
+/// @param index 工作线程的编号
+///
+void WorkStealingPool::workerLoop(unsigned index)
+{
+    currentPool = this;
+    currentIndex = index;
+
+    for (;;) {
+
+        std::function<void()> task;
+
+        if (popLocal(index, task) || steal(index, task)) {
+            task();
+            finishTask();
+            continue;
+        }
+
+        // 所有队列都空了，休眠直到有新任务或者要结束
+        std::unique_lock<std::mutex> lock(mutex);
+
+        taskReady.wait(lock, [this] { return stopping || queued > 0; });
+
+        if (stopping && queued == 0) {
+            return;
+        }
+    }
+}
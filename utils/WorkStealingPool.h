@@ -0,0 +1,147 @@
+///
+/// @file WorkStealingPool.h
+/// @brief 工作窃取的线程池
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-15
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-15 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+///
+/// @brief 工作窃取的线程池。每个工作线程有自己的任务队列，从队尾取自己的任务，
+/// 自己的队列空了就从其它线程的队头窃取任务。各任务耗时相差很大时（如源文件大小不一），
+/// 先做完的线程会接着做别人的任务，不会因为任务分配不均而空等。
+///
+class WorkStealingPool {
+
+public:
+    ///
+    /// @brief 构造函数，创建工作线程
+    /// @param threadCount 线程个数，为0时取硬件支持的并发线程数
+    ///
+    explicit WorkStealingPool(unsigned threadCount = 0);
+
+    ///
+    /// @brief 析构函数，等待已提交的任务完成后结束工作线程
+    ///
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool & operator=(const WorkStealingPool &) = delete;
+
+    ///
+    /// @brief 提交任务。在工作线程中提交时放入本线程的队列，否则轮流放入各线程的队列
+    /// @param task 任务
+    ///
+    void submit(std::function<void()> task);
+
+    ///
+    /// @brief 等待已提交的任务全部完成，不能在任务中调用
+    ///
+    void wait();
+
+    ///
+    /// @brief 工作线程的个数
+    /// @return unsigned
+    ///
+    unsigned size() const
+    {
+        return (unsigned) workers.size();
+    }
+
+    ///
+    /// @brief 被窃取执行的任务数，用于观察负载均衡的情况
+    /// @return size_t
+    ///
+    size_t getSteals() const
+    {
+        return steals;
+    }
+
+private:
+    ///
+    /// @brief 一个工作线程的任务队列
+    ///
+    struct WorkQueue {
+        /// @brief 保护队列
+        std::mutex mutex;
+
+        /// @brief 任务
+        std::deque<std::function<void()>> tasks;
+    };
+
+    ///
+    /// @brief 工作线程的执行函数，循环取任务执行
+    /// @param index 工作线程的编号
+    ///
+    void workerLoop(unsigned index);
+
+    ///
+    /// @brief 从自己的队尾取任务
+    /// @param index 工作线程的编号
+    /// @param task 取到的任务
+    /// @return true: 取到 false: 队列为空
+    ///
+    bool popLocal(unsigned index, std::function<void()> & task);
+
+    ///
+    /// @brief 从其它线程的队头窃取任务
+    /// @param index 工作线程的编号
+    /// @param task 窃取到的任务
+    /// @return true: 窃取到 false: 所有队列都为空
+    ///
+    bool steal(unsigned index, std::function<void()> & task);
+
+    ///
+    /// @brief 一个任务执行完成，全部完成时通知等待者
+    ///
+    void finishTask();
+
+    /// @brief 工作线程
+    std::vector<std::thread> workers;
+
+    /// @brief 各工作线程的任务队列，与workers一一对应
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+
+    /// @brief 保护空闲线程的休眠与唤醒，以及已提交未完成的任务数
+    std::mutex mutex;
+
+    /// @brief 有新任务或要结束时通知空闲的工作线程
+    std::condition_variable taskReady;
+
+    /// @brief 任务全部完成时通知等待者
+    std::condition_variable allDone;
+
+    /// @brief 队列中还未被取走的任务数，增加时持有mutex，避免空闲线程漏掉唤醒
+    std::atomic<size_t> queued{0};
+
+    /// @brief 已提交但未完成的任务数
+    size_t pending = 0;
+
+    /// @brief 从工作线程以外提交任务时下一个放入的队列
+    unsigned nextQueue = 0;
+
+    /// @brief 被窃取执行的任务数
+    std::atomic<size_t> steals{0};
+
+    /// @brief 是否结束工作线程
+    bool stopping = false;
+};